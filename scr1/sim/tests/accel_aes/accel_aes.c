@@ -0,0 +1,183 @@
+/// @file       <accel_aes.c>
+/// @brief      Memory-mapped AES accelerator test: key expansion, ECB encryption and decryption
+///             with AES-128/256 (FIPS-197 appendix C) and CTR mode with the counter increment
+///             and DATA_IN written ahead of GO (NIST SP 800-38A F.5.1), and a GO written while
+///             busy, which is dropped with CTRL.err set
+///
+
+#include "sc_print.h"
+
+#define AES_BASE            0xF0050000
+#define AES_REG(off)        (*(volatile unsigned int *)(AES_BASE + (off)))
+#define AES_CTRL            0x00
+#define AES_COUNTER         0x04
+#define AES_KEYLEN          0x08
+#define AES_CTR(i)          (0x10 + 4 * (i))
+#define AES_KEY(i)          (0x20 + 4 * (i))
+#define AES_DATA_IN(i)      (0x40 + 4 * (i))
+#define AES_DATA_OUT(i)     (0x50 + 4 * (i))
+
+#define AES_CTRL_GO         (1u << 0)
+#define AES_CTRL_KEY        (1u << 1)
+#define AES_CTRL_DEC        (1u << 2)
+#define AES_CTRL_CTR        (1u << 3)
+#define AES_CTRL_ERR        (1u << 30)
+#define AES_CTRL_DONE       (1u << 31)
+
+// Blocks and keys as the registers hold them: bytes in memory order, byte 0 in bits [7:0]
+static const unsigned int ecb_pt[4] = {
+    0x33221100, 0x77665544, 0xbbaa9988, 0xffeeddcc
+};
+
+static const unsigned int ecb_key[8] = {
+    0x03020100, 0x07060504, 0x0b0a0908, 0x0f0e0d0c, 0x13121110, 0x17161514, 0x1b1a1918, 0x1f1e1d1c
+};
+
+static const unsigned int ecb_ct128[4] = {
+    0xd8e0c469, 0x30047b6a, 0x80b7cdd8, 0x5ac5b470
+};
+
+static const unsigned int ecb_ct256[4] = {
+    0xcab7a28e, 0xbf456751, 0x9049fcea, 0x8960494b
+};
+
+static const unsigned int ctr_key[4] = {
+    0x16157e2b, 0xa6d2ae28, 0x8815f7ab, 0x3c4fcf09
+};
+
+static const unsigned int ctr_iv[4] = {
+    0xf3f2f1f0, 0xf7f6f5f4, 0xfbfaf9f8, 0xfffefdfc
+};
+
+// The counter after four blocks: the increment carries from byte 15 into byte 14
+static const unsigned int ctr_next[4] = {
+    0xf3f2f1f0, 0xf7f6f5f4, 0xfbfaf9f8, 0x03fffdfc
+};
+
+static const unsigned int ctr_pt[16] = {
+    0xe2bec16b, 0x969f402e, 0x117e3de9, 0x2a179373, 0x578a2dae, 0x9cac031e, 0xac6fb79e, 0x518eaf45,
+    0x461cc830, 0x11e45ca3, 0x19c1fbe5, 0xef520a1a, 0x45249ff6, 0x179b4fdf, 0x7b412bad, 0x10376ce6
+};
+
+static const unsigned int ctr_ct[16] = {
+    0x91614d87, 0x26e320b6, 0x6468ef1b, 0xceb60d99, 0x6bf60698, 0xfffd7079, 0x7b181786, 0xfffdffb9,
+    0x3edfe45a, 0x5ed3d5db, 0x02094f5b, 0xab3eb00d, 0xda1d031e, 0xd103be2f, 0xa0702179, 0xee9c00f3
+};
+
+static void aes_wait(void)
+{
+    while (!(AES_REG(AES_CTRL) & AES_CTRL_DONE))
+        ;
+}
+
+static int aes_check(const unsigned int *ref)
+{
+    int i;
+    int err = 0;
+
+    for (i = 0; i < 4; ++i)
+        err |= (AES_REG(AES_DATA_OUT(i)) != ref[i]);
+    return err;
+}
+
+// KEY|GO expands the key and encrypts in one command; the round keys are then reused
+// for the decryption, which takes one cycle per round
+static int aes_ecb(int key256, const unsigned int *ct)
+{
+    int i;
+    int err = 0;
+    int nr = key256 ? 14 : 10;
+    unsigned int cycles;
+
+    AES_REG(AES_KEYLEN) = key256;
+    for (i = 0; i < (key256 ? 8 : 4); ++i)
+        AES_REG(AES_KEY(i)) = ecb_key[i];
+    for (i = 0; i < 4; ++i)
+        AES_REG(AES_DATA_IN(i)) = ecb_pt[i];
+    AES_REG(AES_CTRL) = AES_CTRL_KEY | AES_CTRL_GO;
+    aes_wait();
+    err |= aes_check(ct);
+
+    for (i = 0; i < 4; ++i)
+        AES_REG(AES_DATA_IN(i)) = ct[i];
+    AES_REG(AES_CTRL) = AES_CTRL_DEC | AES_CTRL_GO;
+    aes_wait();
+    err |= aes_check(ecb_pt);
+    cycles = AES_REG(AES_COUNTER);
+    err |= (cycles != nr);
+    sc_printf("AES-%d ECB: %s, %d cycles/block\n", key256 ? 256 : 128, err ? "FAIL" : "PASS", cycles);
+    return err;
+}
+
+// DATA_IN is latched when a block starts, so block b + 1 is written while block b is
+// encrypted; CTR is advanced by the accelerator after each block
+static int aes_ctr(void)
+{
+    int i, b;
+    int err = 0;
+
+    AES_REG(AES_KEYLEN) = 0;
+    for (i = 0; i < 4; ++i)
+        AES_REG(AES_KEY(i)) = ctr_key[i];
+    AES_REG(AES_CTRL) = AES_CTRL_KEY;
+    aes_wait();
+
+    for (i = 0; i < 4; ++i) {
+        AES_REG(AES_CTR(i)) = ctr_iv[i];
+        AES_REG(AES_DATA_IN(i)) = ctr_pt[i];
+    }
+    AES_REG(AES_CTRL) = AES_CTRL_CTR | AES_CTRL_GO;
+    for (b = 0; b < 4; ++b) {
+        if (b < 3) {
+            for (i = 0; i < 4; ++i)
+                AES_REG(AES_DATA_IN(i)) = ctr_pt[4 * (b + 1) + i];
+        }
+        aes_wait();
+        err |= aes_check(&ctr_ct[4 * b]);
+        if (b < 3)
+            AES_REG(AES_CTRL) = AES_CTRL_CTR | AES_CTRL_GO;
+    }
+    for (i = 0; i < 4; ++i)
+        err |= (AES_REG(AES_CTR(i)) != ctr_next[i]);
+    sc_printf("AES-128 CTR: %s\n", err ? "FAIL" : "PASS");
+    return err;
+}
+
+// A GO written during KEY|GO is dropped: DATA_OUT holds the first block and CTRL.err is
+// set until the next GO is taken
+static int aes_busy(void)
+{
+    int i;
+    int err = 0;
+
+    AES_REG(AES_KEYLEN) = 0;
+    for (i = 0; i < 4; ++i) {
+        AES_REG(AES_KEY(i)) = ecb_key[i];
+        AES_REG(AES_DATA_IN(i)) = ecb_pt[i];
+    }
+    AES_REG(AES_CTRL) = AES_CTRL_KEY | AES_CTRL_GO;
+    AES_REG(AES_CTRL) = AES_CTRL_DEC | AES_CTRL_GO;
+    aes_wait();
+    err |= !(AES_REG(AES_CTRL) & AES_CTRL_ERR);
+    err |= aes_check(ecb_ct128);
+
+    for (i = 0; i < 4; ++i)
+        AES_REG(AES_DATA_IN(i)) = ecb_ct128[i];
+    AES_REG(AES_CTRL) = AES_CTRL_DEC | AES_CTRL_GO;
+    aes_wait();
+    err |= ((AES_REG(AES_CTRL) & AES_CTRL_ERR) != 0);
+    err |= aes_check(ecb_pt);
+    sc_printf("AES GO while busy: %s\n", err ? "FAIL" : "PASS");
+    return err;
+}
+
+int main()
+{
+    int err = 0;
+
+    err |= aes_ecb(0, ecb_ct128);
+    err |= aes_ecb(1, ecb_ct256);
+    err |= aes_ctr();
+    err |= aes_busy();
+    return err;
+}
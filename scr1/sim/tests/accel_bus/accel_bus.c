@@ -0,0 +1,97 @@
+/// @file       <accel_bus.c>
+/// @brief      Accelerator bus test: byte, halfword and word loads and stores and back-to-back
+///             accesses through the accelerator port of the cluster top (scr1_accel on the
+///             dmem router, or scr1_accel_ahb behind an AHB bridge with SCR1_ACCEL_EXT_BUS;
+///             scr1_accel_axi behind the AXI bridge)
+///
+
+#include "sc_print.h"
+
+#define ACCEL_BASE          0xF0030000
+#define ACCEL_REG(off)      (*(volatile unsigned int *)(ACCEL_BASE + (off)))
+#define ACCEL_HREG(off)     (*(volatile unsigned short *)(ACCEL_BASE + (off)))
+#define ACCEL_BREG(off)     (*(volatile unsigned char *)(ACCEL_BASE + (off)))
+#define ACCEL_CTRL          0x00
+#define ACCEL_MODE          0x14
+#define ACCEL_DATALEN       0x34
+#define ACCEL_STATE(i)      (0x40 + 4 * (i))
+#define ACCEL_MSG(i)        (0x80 + 4 * (i))
+
+#define ACCEL_CTRL_GO       (1u << 0)
+#define ACCEL_CTRL_INIT     (1u << 1)
+#define ACCEL_CTRL_FINAL    (1u << 3)
+#define ACCEL_CTRL_DONE     (1u << 31)
+#define ACCEL_MODE_SHA256   1
+
+static const unsigned int digest_abc[8] = {
+    0xba7816bf, 0x8f01cfea, 0x414140de, 0x5dae2223, 0xb00361a3, 0x96177a9c, 0xb410ff61, 0xf20015ad
+};
+
+// Loads of every width return the addressed bytes; byte and halfword stores are replicated
+// over the register word, as the accelerator takes them from the dmem router
+static int bus_widths(void)
+{
+    int i;
+    int err = 0;
+
+    ACCEL_REG(ACCEL_MSG(0)) = 0x44332211;
+    for (i = 0; i < 4; ++i)
+        err |= (ACCEL_BREG(ACCEL_MSG(0) + i) != 0x11 * (i + 1));
+    err |= (ACCEL_HREG(ACCEL_MSG(0)) != 0x2211);
+    err |= (ACCEL_HREG(ACCEL_MSG(0) + 2) != 0x4433);
+
+    ACCEL_BREG(ACCEL_MSG(1) + 3) = 0x5a;
+    err |= (ACCEL_REG(ACCEL_MSG(1)) != 0x5a5a5a5a);
+    ACCEL_HREG(ACCEL_MSG(2) + 2) = 0x1234;
+    err |= (ACCEL_REG(ACCEL_MSG(2)) != 0x12341234);
+    ACCEL_BREG(ACCEL_MSG(3)) = 0xa5;
+    err |= (ACCEL_HREG(ACCEL_MSG(3) + 2) != 0xa5a5);
+
+    sc_printf("Byte/halfword access: %s\n", err ? "FAIL" : "PASS");
+    return err;
+}
+
+// Stores issued back to back, then a store and a load to different registers in every pair
+// of instructions, so that a read follows a write on the bus each time
+static int bus_back_to_back(void)
+{
+    int i;
+    int err = 0;
+    unsigned int w;
+
+    for (i = 0; i < 16; i += 4) {
+        ACCEL_REG(ACCEL_MSG(i + 0)) = 0x01010101 * (i + 0);
+        ACCEL_REG(ACCEL_MSG(i + 1)) = 0x01010101 * (i + 1);
+        ACCEL_REG(ACCEL_MSG(i + 2)) = 0x01010101 * (i + 2);
+        ACCEL_REG(ACCEL_MSG(i + 3)) = 0x01010101 * (i + 3);
+    }
+    for (i = 0; i < 16; ++i) {
+        ACCEL_REG(ACCEL_MSG(i)) = ~(0x01010101 * i);
+        w = ACCEL_REG(ACCEL_MSG(i ^ 1));
+        err |= (w != ((i & 1) ? ~(0x01010101 * (i ^ 1)) : 0x01010101 * (i ^ 1)));
+    }
+
+    // "abc" hashed from a message written at one store per instruction
+    ACCEL_REG(ACCEL_MODE) = ACCEL_MODE_SHA256;
+    ACCEL_REG(ACCEL_MSG(0)) = 0x61626300;
+    for (i = 1; i < 16; ++i)
+        ACCEL_REG(ACCEL_MSG(i)) = 0;
+    ACCEL_REG(ACCEL_DATALEN) = 3;
+    ACCEL_REG(ACCEL_CTRL) = ACCEL_CTRL_INIT | ACCEL_CTRL_FINAL | ACCEL_CTRL_GO;
+    while (!(ACCEL_REG(ACCEL_CTRL) & ACCEL_CTRL_DONE))
+        ;
+    for (i = 0; i < 8; ++i)
+        err |= (ACCEL_REG(ACCEL_STATE(i)) != digest_abc[i]);
+
+    sc_printf("Back-to-back access: %s\n", err ? "FAIL" : "PASS");
+    return err;
+}
+
+int main()
+{
+    int err = 0;
+
+    err |= bus_widths();
+    err |= bus_back_to_back();
+    return err;
+}
@@ -0,0 +1,146 @@
+/// @file       <accel_irq.c>
+/// @brief      Memory-mapped accelerator completion interrupt: the digest of the previous
+///             message is printed while the next one is compressed, and the accelerator
+///             is serviced from the external interrupt handler instead of being polled
+///
+
+#include "sc_print.h"
+#include "sc_test.h"
+#include "csr.h"
+#include "riscv_csr_encoding.h"
+
+#define ACCEL_BASE          0xF0030000
+#define ACCEL_REG(off)      (*(volatile unsigned int *)(ACCEL_BASE + (off)))
+#define ACCEL_CTRL          0x00
+#define ACCEL_MODE          0x14
+#define ACCEL_IRQ_EN        0x28
+#define ACCEL_DATALEN       0x34
+#define ACCEL_STATE(i)      (0x40 + 4 * (i))
+#define ACCEL_MSG(i)        (0x80 + 4 * (i))
+
+#define ACCEL_CTRL_GO       (1u << 0)
+#define ACCEL_CTRL_INIT     (1u << 1)
+#define ACCEL_CTRL_FINAL    (1u << 3)
+#define ACCEL_CTRL_ACK      (1u << 31)
+#define ACCEL_CTRL_DONE     (1u << 31)
+#define ACCEL_MODE_SHA256   1
+
+// IPIC line of the accelerator (SCR1_ACCEL_IRQ_LINE in scr1_arch_description.svh)
+#ifndef ACCEL_IRQ_LINE
+#define ACCEL_IRQ_LINE      15
+#endif
+
+#define IPIC_EOI            0xBF4           // end of interrupt
+#define IPIC_SOI            0xBF5           // start of interrupt
+#define IPIC_IDX            0xBF6           // index register
+#define IPIC_ICSR           0xBF7           // interrupt control status register
+#define IPIC_ICSR_IE        (1 << 1)        // interrupt enable (level mode)
+
+#define MCAUSE_EXT_IRQ      (1u << 31 | IRQ_M_EXT)
+
+#define NMSG                3
+
+static const char str_abc[] = "abc";
+static const char str_two[] = "abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq";
+static const char str_empty[] = "";
+
+static const char *const msg_str[NMSG] = {str_abc, str_two, str_empty};
+static const unsigned int msg_len[NMSG] = {3, 56, 0};
+
+static const unsigned int msg_digest[NMSG][8] = {
+    {0xba7816bf, 0x8f01cfea, 0x414140de, 0x5dae2223, 0xb00361a3, 0x96177a9c, 0xb410ff61, 0xf20015ad},
+    {0x248d6a61, 0xd20638b8, 0xe5c02693, 0x0c3e6039, 0xa33ce459, 0x64ff2167, 0xf6ecedd4, 0x19db06c1},
+    {0xe3b0c442, 0x98fc1c14, 0x9afbf4c8, 0x996fb924, 0x27ae41e4, 0x649b934c, 0xa495991b, 0x7852b855}
+};
+
+// Filled in by the interrupt handler
+static volatile unsigned int irq_count;
+static unsigned int digest[NMSG][8];
+
+// The accelerator keeps its line asserted until CTRL.ACK, so the handler copies the
+// digest and acknowledges before the end of interrupt; a re-entry caused by the
+// IPIC synchronizer latency finds CTRL.done clear and only returns
+uintptr_t handle_trap(uintptr_t cause, uintptr_t epc, uintptr_t regs[32])
+{
+    int i;
+
+    if (cause != MCAUSE_EXT_IRQ)
+        report_results(1, cause, epc, 0, 0);
+#ifdef IPIC_ENABLED
+    write_csr(IPIC_SOI, 0);
+#endif
+    if (ACCEL_REG(ACCEL_CTRL) & ACCEL_CTRL_DONE) {
+        for (i = 0; i < 8; ++i)
+            digest[irq_count][i] = ACCEL_REG(ACCEL_STATE(i));
+        ACCEL_REG(ACCEL_CTRL) = ACCEL_CTRL_ACK;
+        irq_count = irq_count + 1;
+    }
+#ifdef IPIC_ENABLED
+    write_csr(IPIC_EOI, 0);
+#endif
+    return epc;
+}
+
+static void accel_submit(const char *str, unsigned int len)
+{
+    unsigned int i, j, w;
+
+    ACCEL_REG(ACCEL_DATALEN) = len;
+    for (i = 0; 4 * i < len; ++i) {
+        for (j = 0, w = 0; j < 4; ++j)
+            w = (w << 8) | ((4 * i + j < len) ? (unsigned char)str[4 * i + j] : 0);
+        ACCEL_REG(ACCEL_MSG(i)) = w;
+    }
+    ACCEL_REG(ACCEL_CTRL) = ACCEL_CTRL_INIT | ACCEL_CTRL_FINAL | ACCEL_CTRL_GO;
+}
+
+static int check_digest(unsigned int n)
+{
+    int i;
+    int err = 0;
+
+    sc_printf("SHA-256 message %d: ", n);
+    for (i = 0; i < 8; ++i) {
+        sc_printf("%08x", digest[n][i]);
+        err |= (digest[n][i] != msg_digest[n][i]);
+    }
+    sc_printf(" %s\n", err ? "FAIL" : "PASS");
+    return err;
+}
+
+int main()
+{
+    unsigned int n;
+    int err = 0;
+
+    ACCEL_REG(ACCEL_MODE) = ACCEL_MODE_SHA256;
+    ACCEL_REG(ACCEL_IRQ_EN) = 1;
+#ifdef IPIC_ENABLED
+    write_csr(IPIC_IDX, ACCEL_IRQ_LINE);
+    write_csr(IPIC_ICSR, IPIC_ICSR_IE);
+#endif
+    set_csr(mie, MIP_MEIP);
+    set_csr(mstatus, MSTATUS_MIE);
+
+    // The previous digest is printed while the accelerator works on the next message;
+    // only the irq_count variable in memory is watched, not the accelerator registers
+    for (n = 0; n < NMSG; ++n) {
+        accel_submit(msg_str[n], msg_len[n]);
+        if (n > 0)
+            err |= check_digest(n - 1);
+        while (irq_count == n)
+            ;
+    }
+    err |= check_digest(NMSG - 1);
+
+    // With IRQ_EN clear the completion is only visible in CTRL.done
+    ACCEL_REG(ACCEL_IRQ_EN) = 0;
+    accel_submit(msg_str[0], msg_len[0]);
+    while (!(ACCEL_REG(ACCEL_CTRL) & ACCEL_CTRL_DONE))
+        ;
+    err |= (irq_count != NMSG);
+    sc_printf("IRQ_EN clear: %s\n", (irq_count != NMSG) ? "FAIL" : "PASS");
+
+    clear_csr(mstatus, MSTATUS_MIE);
+    return err;
+}
@@ -0,0 +1,169 @@
+/// @file       <accel_mont.c>
+/// @brief      Memory-mapped Montgomery multiplier test: P-256 multiplication with the cycle
+///             count, X25519 squaring into A, and a 64-bit modular exponentiation (e = 65537)
+///             kept in the operand RAMs between commands
+///
+
+#include "sc_print.h"
+
+#define MONT_BASE           0xF0060000
+#define MONT_REG(off)       (*(volatile unsigned int *)(MONT_BASE + (off)))
+#define MONT_CTRL           0x000
+#define MONT_COUNTER        0x004
+#define MONT_NWORDS         0x008
+#define MONT_NINV           0x00C
+#define MONT_A(i)           (0x100 + 4 * (i))
+#define MONT_B(i)           (0x200 + 4 * (i))
+#define MONT_N(i)           (0x300 + 4 * (i))
+#define MONT_R(i)           (0x400 + 4 * (i))
+
+#define MONT_CTRL_GO        (1u << 0)
+#define MONT_CTRL_SQR       (1u << 1)
+#define MONT_CTRL_TO_A      (1u << 2)
+#define MONT_CTRL_DONE      (1u << 31)
+
+// Numbers are little-endian 32-bit words; the references are a * b * 2^(-32 * nwords) mod n
+static const unsigned int p256_n[8] = {
+    0xffffffff, 0xffffffff, 0xffffffff, 0x00000000, 0x00000000, 0x00000000, 0x00000001, 0xffffffff
+};
+
+static const unsigned int p256_a[8] = {
+    0x1b591d75, 0x9daa37e5, 0xb3dca50a, 0xc15521b1, 0xa6ec39c1, 0x86f0ce2e, 0xf0baef3a, 0x3f372617
+};
+
+static const unsigned int p256_b[8] = {
+    0x4567ceb1, 0xbc319994, 0x417a8105, 0x4a800646, 0xbbeb508f, 0x12979bfc, 0xa8902e32, 0x732242fd
+};
+
+static const unsigned int p256_r[8] = {
+    0x26f594b4, 0x7a3d9b25, 0xe68a68d1, 0x8cd3eed5, 0xaeb6a514, 0x30cc0647, 0x13f68f91, 0xb90da197
+};
+
+static const unsigned int x25519_n[8] = {
+    0xffffffed, 0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff, 0x7fffffff
+};
+
+static const unsigned int x25519_a[8] = {
+    0x4d909eb2, 0x77744cca, 0xaf29e6f8, 0xdf7142dc, 0x658c6762, 0x64d0b50f, 0xc70b53bf, 0x7457987b
+};
+
+static const unsigned int x25519_r[8] = {
+    0x08eb73bc, 0xc7436caa, 0x1b34924d, 0x5729cfc0, 0x3242723f, 0xefec9ea1, 0x8b5d4a70, 0x761f2500
+};
+
+// exp_rr is 2^128 mod exp_n, exp_r is exp_base^65537 mod exp_n
+static const unsigned int exp_n[2] = {
+    0x1e4f6f2b, 0xc375d034
+};
+
+static const unsigned int exp_base[2] = {
+    0xe6c648e7, 0x50cef798
+};
+
+static const unsigned int exp_rr[2] = {
+    0x46875361, 0x94cec6a4
+};
+
+static const unsigned int exp_r[2] = {
+    0xd710674b, 0x62d018ca
+};
+
+static void mont_run(unsigned int cmd)
+{
+    MONT_REG(MONT_CTRL) = cmd | MONT_CTRL_GO;
+    while (!(MONT_REG(MONT_CTRL) & MONT_CTRL_DONE))
+        ;
+}
+
+static void mont_setup(const unsigned int *n, unsigned int ninv, int nwords)
+{
+    int i;
+
+    MONT_REG(MONT_NWORDS) = nwords;
+    MONT_REG(MONT_NINV) = ninv;
+    for (i = 0; i < nwords; ++i)
+        MONT_REG(MONT_N(i)) = n[i];
+}
+
+static int mont_check(int ram, const unsigned int *ref, int nwords)
+{
+    int i;
+    int err = 0;
+
+    for (i = 0; i < nwords; ++i)
+        err |= (MONT_REG(ram + 4 * i) != ref[i]);
+    return err;
+}
+
+static int mont_p256(void)
+{
+    int i;
+    int err = 0;
+    unsigned int cycles;
+
+    mont_setup(p256_n, 0x00000001, 8);
+    for (i = 0; i < 8; ++i) {
+        MONT_REG(MONT_A(i)) = p256_a[i];
+        MONT_REG(MONT_B(i)) = p256_b[i];
+    }
+    mont_run(0);
+    err |= mont_check(MONT_R(0), p256_r, 8);
+    // (NWORDS + 1) * (NWORDS + 2), plus NWORDS + 1 without the final subtraction
+    cycles = MONT_REG(MONT_COUNTER);
+    err |= (cycles != 90) && (cycles != 99);
+    sc_printf("P-256 mul: %s, %d cycles\n", err ? "FAIL" : "PASS", cycles);
+    return err;
+}
+
+static int mont_x25519(void)
+{
+    int i;
+    int err = 0;
+
+    mont_setup(x25519_n, 0x286bca1b, 8);
+    for (i = 0; i < 8; ++i)
+        MONT_REG(MONT_A(i)) = x25519_a[i];
+    mont_run(MONT_CTRL_SQR | MONT_CTRL_TO_A);
+    err |= mont_check(MONT_R(0), x25519_r, 8);
+    err |= mont_check(MONT_A(0), x25519_r, 8);
+    sc_printf("X25519 sqr: %s\n", err ? "FAIL" : "PASS");
+    return err;
+}
+
+// The accumulator stays in A and the base in B: 16 SQR|TO_A squarings and one TO_A
+// multiplication, then a multiplication by 1 to leave the Montgomery domain
+static int mont_exp(void)
+{
+    int i;
+    int err = 0;
+
+    mont_setup(exp_n, 0xb188287d, 2);
+    for (i = 0; i < 2; ++i) {
+        MONT_REG(MONT_A(i)) = exp_base[i];
+        MONT_REG(MONT_B(i)) = exp_rr[i];
+    }
+    mont_run(0);
+    for (i = 0; i < 2; ++i) {
+        MONT_REG(MONT_A(i)) = MONT_REG(MONT_R(i));
+        MONT_REG(MONT_B(i)) = MONT_REG(MONT_R(i));
+    }
+    for (i = 0; i < 16; ++i)
+        mont_run(MONT_CTRL_SQR | MONT_CTRL_TO_A);
+    mont_run(MONT_CTRL_TO_A);
+    MONT_REG(MONT_B(0)) = 1;
+    MONT_REG(MONT_B(1)) = 0;
+    mont_run(0);
+    err |= mont_check(MONT_R(0), exp_r, 2);
+    sc_printf("64-bit modexp: %s\n", err ? "FAIL" : "PASS");
+    return err;
+}
+
+int main()
+{
+    int err = 0;
+
+    err |= mont_p256();
+    err |= mont_x25519();
+    err |= mont_exp();
+    return err;
+}
@@ -0,0 +1,694 @@
+/// @file       <accel_sha256.c>
+/// @brief      Memory-mapped accelerator test: MODE_MUL, MODE_MAC, SHA-256 compression, padding,
+///             queued GO with the double-buffered message window, context save/restore,
+///             HMAC-SHA256, nonce search, DMA, the descriptor ring and the parallel SHA-256 lanes
+///
+
+#include "sc_print.h"
+#include "csr.h"
+
+#define ACCEL_BASE          0xF0030000
+#define ACCEL_REG(off)      (*(volatile unsigned int *)(ACCEL_BASE + (off)))
+#define ACCEL_LANE(k, off)  ACCEL_REG(0x100 * (k) + (off))
+#define ACCEL_CTRL          0x00
+#define ACCEL_COUNTER       0x04
+#define ACCEL_DATA_A        0x08
+#define ACCEL_DATA_B        0x0C
+#define ACCEL_DATA_C        0x10
+#define ACCEL_MODE          0x14
+#define ACCEL_DMA_SRC       0x18
+#define ACCEL_DMA_NBLK      0x1C
+#define ACCEL_RING_HEAD     0x20
+#define ACCEL_RING_TAIL     0x24
+#define ACCEL_NONCE         0x2C
+#define ACCEL_NONCE_CNT     0x30
+#define ACCEL_DATALEN       0x34
+#define ACCEL_BITLEN0       0x38
+#define ACCEL_BITLEN1       0x3C
+#define ACCEL_STATE(i)      (0x40 + 4 * (i))
+#define ACCEL_TARGET(i)     (0x60 + 4 * (i))
+#define ACCEL_MSG(i)        (0x80 + 4 * (i))
+#define ACCEL_RING_ADDR(i)  (0xC0 + 16 * (i))
+#define ACCEL_RING_LEN(i)   (0xC4 + 16 * (i))
+#define ACCEL_RING_DST(i)   (0xC8 + 16 * (i))
+#define ACCEL_ID            0xFF00
+#define ACCEL_CAPS          0xFF04
+
+#define ACCEL_CTRL_GO       (1u << 0)
+#define ACCEL_CTRL_INIT     (1u << 1)
+#define ACCEL_CTRL_DMA      (1u << 2)
+#define ACCEL_CTRL_FINAL    (1u << 3)
+#define ACCEL_CTRL_KEY      (1u << 4)
+#define ACCEL_CTRL_HMAC     (1u << 5)
+#define ACCEL_CTRL_SEARCH   (1u << 6)
+#define ACCEL_CTRL_ACK      (1u << 31)  // write; DONE on read
+#define ACCEL_CTRL_FOUND    (1u << 3)   // read; FINAL on write
+#define ACCEL_CTRL_PEND     (1u << 2)   // read; DMA on write
+#define ACCEL_CTRL_ERR      (1u << 30)
+#define ACCEL_CTRL_DONE     (1u << 31)
+#define ACCEL_MODE_MUL      0
+#define ACCEL_MODE_SHA256   1
+#define ACCEL_MODE_MAC      2
+
+// Rounds per clock the RTL was built with (set by the root Makefile)
+#ifndef ACCEL_RPC
+#define ACCEL_RPC           1
+#endif
+#define ACCEL_SHA256_CYCLES (64 / ACCEL_RPC)
+
+// SHA-256 lanes the RTL was built with (set by the root Makefile)
+#ifndef ACCEL_LANES
+#define ACCEL_LANES         1
+#endif
+
+// "abc" and the 56-byte two-block message from FIPS 180-2, already padded
+static const unsigned int msg_abc[16] = {
+    0x61626380, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0x00000018
+};
+
+static const unsigned int msg_two[32] = {
+    0x61626364, 0x62636465, 0x63646566, 0x64656667, 0x65666768, 0x66676869, 0x6768696a, 0x68696a6b,
+    0x696a6b6c, 0x6a6b6c6d, 0x6b6c6d6e, 0x6c6d6e6f, 0x6d6e6f70, 0x6e6f7071, 0x80000000, 0x00000000,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0x000001c0
+};
+
+static const unsigned int digest_abc[8] = {
+    0xba7816bf, 0x8f01cfea, 0x414140de, 0x5dae2223, 0xb00361a3, 0x96177a9c, 0xb410ff61, 0xf20015ad
+};
+
+static const unsigned int digest_two[8] = {
+    0x248d6a61, 0xd20638b8, 0xe5c02693, 0x0c3e6039, 0xa33ce459, 0x64ff2167, 0xf6ecedd4, 0x19db06c1
+};
+
+static void accel_wait(void)
+{
+    while (!(ACCEL_REG(ACCEL_CTRL) & ACCEL_CTRL_DONE))
+        ;
+}
+
+static int sha256_blocks(const unsigned int *msg, int nblocks, const unsigned int *digest)
+{
+    int i, b;
+    int err = 0;
+    unsigned int cycles;
+
+    ACCEL_REG(ACCEL_MODE) = ACCEL_MODE_SHA256;
+    for (b = 0; b < nblocks; ++b) {
+        for (i = 0; i < 16; ++i)
+            ACCEL_REG(ACCEL_MSG(i)) = msg[16 * b + i];
+        ACCEL_REG(ACCEL_CTRL) = (b == 0) ? (ACCEL_CTRL_INIT | ACCEL_CTRL_GO) : ACCEL_CTRL_GO;
+        accel_wait();
+    }
+    for (i = 0; i < 8; ++i)
+        err |= (ACCEL_REG(ACCEL_STATE(i)) != digest[i]);
+    cycles = ACCEL_REG(ACCEL_COUNTER);
+    err |= (cycles != ACCEL_SHA256_CYCLES);
+    sc_printf("SHA-256 %d block(s), %d round(s)/clk: %s, %d cycles/block\n", nblocks, ACCEL_RPC, err ? "FAIL" : "PASS", cycles);
+    return err;
+}
+
+// The same messages unpadded, as bytes, and the 112-byte message from FIPS 180-2
+static const char str_abc[] = "abc";
+static const char str_two[] = "abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq";
+static const char str_long[] = "abcdefghbcdefghicdefghijdefghijkefghijklfghijklmghijklmnhijklmno"
+                               "ijklmnopjklmnopqklmnopqrlmnopqrsmnopqrstnopqrstu";
+
+static const unsigned int digest_long[8] = {
+    0xcf5b16a7, 0x78af8380, 0x036ce59e, 0x7b049237, 0x0b249b11, 0xe8f07a51, 0xafac4503, 0x7afee9d1
+};
+
+// The accelerator pads the message and appends its length (two blocks for 56 bytes)
+static int sha256_final(const char *str, unsigned int len, const unsigned int *digest)
+{
+    unsigned int i, j, w;
+    int err = 0;
+
+    ACCEL_REG(ACCEL_MODE) = ACCEL_MODE_SHA256;
+    ACCEL_REG(ACCEL_DATALEN) = len;
+    for (i = 0; 4 * i < len; ++i) {
+        for (j = 0, w = 0; j < 4; ++j)
+            w = (w << 8) | ((4 * i + j < len) ? (unsigned char)str[4 * i + j] : 0);
+        ACCEL_REG(ACCEL_MSG(i)) = w;
+    }
+    ACCEL_REG(ACCEL_CTRL) = ACCEL_CTRL_INIT | ACCEL_CTRL_FINAL | ACCEL_CTRL_GO;
+    accel_wait();
+    for (i = 0; i < 8; ++i)
+        err |= (ACCEL_REG(ACCEL_STATE(i)) != digest[i]);
+    sc_printf("SHA-256 FINAL %d bytes: %s, %d cycles\n", len, err ? "FAIL" : "PASS", ACCEL_REG(ACCEL_COUNTER));
+    return err;
+}
+
+// MSG is a buffer copied into the compression window at GO, so the next block is
+// written while the previous one compresses and its GO is queued behind it
+static int sha256_pipelined(const char *str, unsigned int len, const unsigned int *digest)
+{
+    unsigned int i, j, w, off, rem, ctrl, cycles;
+    int err = 0;
+
+    ACCEL_REG(ACCEL_MODE) = ACCEL_MODE_SHA256;
+    cycles = read_csr(mcycle);
+    for (off = 0, ctrl = ACCEL_CTRL_INIT; ; off += 64, ctrl = 0) {
+        rem = len - off;
+        while (ACCEL_REG(ACCEL_CTRL) & ACCEL_CTRL_PEND)
+            ;
+        for (i = 0; i < 16 && 4 * i < rem; ++i) {
+            for (j = 0, w = 0; j < 4; ++j)
+                w = (w << 8) | ((4 * i + j < rem) ? (unsigned char)str[off + 4 * i + j] : 0);
+            ACCEL_REG(ACCEL_MSG(i)) = w;
+        }
+        if (rem < 64) {
+            ACCEL_REG(ACCEL_DATALEN) = rem;
+            ACCEL_REG(ACCEL_CTRL) = ctrl | ACCEL_CTRL_FINAL | ACCEL_CTRL_GO;
+            break;
+        }
+        ACCEL_REG(ACCEL_CTRL) = ctrl | ACCEL_CTRL_GO;
+    }
+    accel_wait();
+    cycles = read_csr(mcycle) - cycles;
+    for (i = 0; i < 8; ++i)
+        err |= (ACCEL_REG(ACCEL_STATE(i)) != digest[i]);
+    sc_printf("SHA-256 pipelined %d bytes: %s, %d cycles, COUNTER %d\n", len, err ? "FAIL" : "PASS", cycles, ACCEL_REG(ACCEL_COUNTER));
+    return err;
+}
+
+static void accel_load(const char *str, unsigned int len)
+{
+    unsigned int i, j, w;
+
+    for (i = 0; i < 16 && 4 * i < len; ++i) {
+        for (j = 0, w = 0; j < 4; ++j)
+            w = (w << 8) | ((4 * i + j < len) ? (unsigned char)str[4 * i + j] : 0);
+        ACCEL_REG(ACCEL_MSG(i)) = w;
+    }
+}
+
+// On every lane, the 56-byte message finalized, then "abc" finalized from its digest (no
+// INIT): the second FINAL is queued, and its DATALEN written, while the first still has
+// its length block to compress
+static const unsigned int digest_two_abc[8] = {
+    0x81092f45, 0x454a691c, 0xab44aa9d, 0x9614bb12, 0x64edfc27, 0x075c5325, 0xfcb8b0b7, 0xad5df1c0
+};
+
+static void lane_load(unsigned int k, const char *str, unsigned int len)
+{
+    unsigned int i, j, w;
+
+    for (i = 0; i < 16 && 4 * i < len; ++i) {
+        for (j = 0, w = 0; j < 4; ++j)
+            w = (w << 8) | ((4 * i + j < len) ? (unsigned char)str[4 * i + j] : 0);
+        ACCEL_LANE(k, ACCEL_MSG(i)) = w;
+    }
+}
+
+static int sha256_final_queued(void)
+{
+    unsigned int i, k;
+    int err = 0;
+
+    ACCEL_REG(ACCEL_MODE) = ACCEL_MODE_SHA256;
+    for (k = 0; k < ACCEL_LANES; ++k) {
+        ACCEL_LANE(k, ACCEL_DATALEN) = 56;
+        lane_load(k, str_two, 56);
+        ACCEL_LANE(k, ACCEL_CTRL) = ACCEL_CTRL_INIT | ACCEL_CTRL_FINAL | ACCEL_CTRL_GO;
+        ACCEL_LANE(k, ACCEL_DATALEN) = 3;
+        lane_load(k, str_abc, 3);
+        ACCEL_LANE(k, ACCEL_CTRL) = ACCEL_CTRL_FINAL | ACCEL_CTRL_GO;
+        while (!(ACCEL_LANE(k, ACCEL_CTRL) & ACCEL_CTRL_DONE))
+            ;
+        for (i = 0; i < 8; ++i)
+            err |= (ACCEL_LANE(k, ACCEL_STATE(i)) != digest_two_abc[i]);
+    }
+    sc_printf("SHA-256 FINAL queued behind a two-block FINAL, %d lanes: %s\n", ACCEL_LANES, err ? "FAIL" : "PASS");
+    return err;
+}
+
+// The first block of the 112-byte message is compressed, its context (BITLEN, STATE) is
+// saved, another message is hashed from INIT, and the context is restored to finish
+static int sha256_context(void)
+{
+    unsigned int ctx[10];
+    unsigned int i;
+    int err = 0;
+
+    ACCEL_REG(ACCEL_MODE) = ACCEL_MODE_SHA256;
+    accel_load(str_long, 64);
+    ACCEL_REG(ACCEL_CTRL) = ACCEL_CTRL_INIT | ACCEL_CTRL_GO;
+    accel_wait();
+    ctx[0] = ACCEL_REG(ACCEL_BITLEN0);
+    ctx[1] = ACCEL_REG(ACCEL_BITLEN1);
+    for (i = 0; i < 8; ++i)
+        ctx[2 + i] = ACCEL_REG(ACCEL_STATE(i));
+    err |= (ctx[0] != 512) | (ctx[1] != 0);
+
+    err |= sha256_final(str_abc, 3, digest_abc);
+
+    ACCEL_REG(ACCEL_BITLEN0) = ctx[0];
+    ACCEL_REG(ACCEL_BITLEN1) = ctx[1];
+    for (i = 0; i < 8; ++i)
+        ACCEL_REG(ACCEL_STATE(i)) = ctx[2 + i];
+    ACCEL_REG(ACCEL_DATALEN) = 112 - 64;
+    accel_load(str_long + 64, 112 - 64);
+    ACCEL_REG(ACCEL_CTRL) = ACCEL_CTRL_FINAL | ACCEL_CTRL_GO;
+    accel_wait();
+    for (i = 0; i < 8; ++i)
+        err |= (ACCEL_REG(ACCEL_STATE(i)) != digest_long[i]);
+    sc_printf("SHA-256 context save/restore: %s\n", err ? "FAIL" : "PASS");
+    return err;
+}
+
+// RFC 4231 test cases 1, 2 and 6
+static const char hmac_key1[] = "\x0b\x0b\x0b\x0b\x0b\x0b\x0b\x0b\x0b\x0b\x0b\x0b\x0b\x0b\x0b\x0b\x0b\x0b\x0b\x0b";
+static const char hmac_key2[] = "Jefe";
+static const char hmac_msg1[] = "Hi There";
+static const char hmac_msg2[] = "what do ya want for nothing?";
+static const char hmac_msg6[] = "Test Using Larger Than Block-Size Key - Hash Key First";
+
+static const unsigned int hmac_digest1[8] = {
+    0xb0344c61, 0xd8db3853, 0x5ca8afce, 0xaf0bf12b, 0x881dc200, 0xc9833da7, 0x26e9376c, 0x2e32cff7
+};
+
+static const unsigned int hmac_digest2[8] = {
+    0x5bdcc146, 0xbf60754e, 0x6a042426, 0x089575c7, 0x5a003f08, 0x9d273983, 0x9dec58b9, 0x64ec3843
+};
+
+static const unsigned int hmac_digest6[8] = {
+    0x60e43159, 0x1ee0b67f, 0x0d8a26aa, 0xcbf5b77f, 0x8e0bc621, 0x3728c514, 0x0546040f, 0x0ee37f54
+};
+
+// KEY derives the midstates from the zero-padded key once; each HMAC message then
+// costs its own blocks plus the outer block
+static int hmac_one(const char *key, unsigned int key_len, const char *msg, unsigned int len,
+                    const unsigned int *digest, int msgs)
+{
+    unsigned int i, n;
+    int err = 0;
+
+    ACCEL_REG(ACCEL_MODE) = ACCEL_MODE_SHA256;
+    for (i = 0; i < 16; ++i)
+        ACCEL_REG(ACCEL_MSG(i)) = 0;
+    accel_load(key, key_len);
+    ACCEL_REG(ACCEL_CTRL) = ACCEL_CTRL_KEY | ACCEL_CTRL_GO;
+    accel_wait();
+    for (n = 0; n < msgs; ++n) {
+        ACCEL_REG(ACCEL_DATALEN) = len;
+        accel_load(msg, len);
+        ACCEL_REG(ACCEL_CTRL) = ACCEL_CTRL_HMAC | ACCEL_CTRL_FINAL | ACCEL_CTRL_GO;
+        accel_wait();
+        for (i = 0; i < 8; ++i)
+            err |= (ACCEL_REG(ACCEL_STATE(i)) != digest[i]);
+    }
+    sc_printf("HMAC-SHA256 %d bytes x %d: %s, %d cycles\n", len, msgs, err ? "FAIL" : "PASS", ACCEL_REG(ACCEL_COUNTER));
+    return err;
+}
+
+// KEY takes at most 64 bytes: the 131-byte key of test case 6 is hashed first (here with
+// two blocks and a FINAL from the same MSG contents) and its digest is the key
+static int hmac_long_key(void)
+{
+    char key[32];
+    unsigned int i, w;
+
+    ACCEL_REG(ACCEL_MODE) = ACCEL_MODE_SHA256;
+    for (i = 0; i < 16; ++i)
+        ACCEL_REG(ACCEL_MSG(i)) = 0xaaaaaaaa;
+    ACCEL_REG(ACCEL_CTRL) = ACCEL_CTRL_INIT | ACCEL_CTRL_GO;
+    accel_wait();
+    ACCEL_REG(ACCEL_CTRL) = ACCEL_CTRL_GO;
+    accel_wait();
+    ACCEL_REG(ACCEL_DATALEN) = 131 - 128;
+    ACCEL_REG(ACCEL_CTRL) = ACCEL_CTRL_FINAL | ACCEL_CTRL_GO;
+    accel_wait();
+    for (i = 0; i < 8; ++i) {
+        w = ACCEL_REG(ACCEL_STATE(i));
+        key[4 * i]     = (char)(w >> 24);
+        key[4 * i + 1] = (char)(w >> 16);
+        key[4 * i + 2] = (char)(w >> 8);
+        key[4 * i + 3] = (char)w;
+    }
+    return hmac_one(key, 32, hmac_msg6, 54, hmac_digest6, 1);
+}
+
+static int sha256_hmac(void)
+{
+    int err = 0;
+
+    err |= hmac_one(hmac_key1, 20, hmac_msg1, 8, hmac_digest1, 1);
+    err |= hmac_one(hmac_key2, 4, hmac_msg2, 28, hmac_digest2, 2);
+    err |= hmac_long_key();
+    return err;
+}
+
+// Bitcoin genesis block header: the first 64 bytes as message words, then the next 12
+static const unsigned int genesis_head[16] = {
+    0x01000000, 0, 0, 0, 0, 0, 0, 0, 0, 0x3ba3edfd, 0x7a7b12b2, 0x7ac72c3e, 0x67768f61, 0x7fc81bc3, 0x888a5132, 0x3a9fb8aa
+};
+static const unsigned int genesis_tail[3] = {0x4b1e5e4a, 0x29ab5f49, 0xffff001d};
+#define GENESIS_NONCE       2083236893u
+
+// Double SHA-256 of the header with the genesis nonce, as STATE words
+static const unsigned int genesis_hash[8] = {
+    0x6fe28c0a, 0xb6f1b372, 0xc1a6a246, 0xae63f74f, 0x931e8365, 0xe15a089c, 0x68d61900, 0x00000000
+};
+
+static int search_run(unsigned int nonce, unsigned int cnt)
+{
+    unsigned int i;
+
+    ACCEL_REG(ACCEL_MODE) = ACCEL_MODE_SHA256;
+    for (i = 0; i < 16; ++i)
+        ACCEL_REG(ACCEL_MSG(i)) = genesis_head[i];
+    ACCEL_REG(ACCEL_CTRL) = ACCEL_CTRL_INIT | ACCEL_CTRL_GO;
+    accel_wait();
+    for (i = 0; i < 3; ++i)
+        ACCEL_REG(ACCEL_MSG(i)) = genesis_tail[i];
+    // Target 0x00000000ffff0000...0 (bits 0x1d00ffff)
+    for (i = 0; i < 8; ++i)
+        ACCEL_REG(ACCEL_TARGET(i)) = (i == 6) ? 0xffff0000 : 0;
+    ACCEL_REG(ACCEL_NONCE) = nonce;
+    ACCEL_REG(ACCEL_NONCE_CNT) = cnt;
+    ACCEL_REG(ACCEL_CTRL) = ACCEL_CTRL_SEARCH | ACCEL_CTRL_GO;
+    accel_wait();
+    return (ACCEL_REG(ACCEL_CTRL) & ACCEL_CTRL_FOUND) != 0;
+}
+
+// One GO covers all attempts; a search past the winning nonce gives up after NONCE_CNT
+static int sha256_search(void)
+{
+    unsigned int i;
+    int err = 0;
+
+    err |= !search_run(GENESIS_NONCE - 3, 8);
+    err |= (ACCEL_REG(ACCEL_NONCE) != GENESIS_NONCE);
+    for (i = 0; i < 8; ++i)
+        err |= (ACCEL_REG(ACCEL_STATE(i)) != genesis_hash[i]);
+    sc_printf("Nonce search: %s, 4 attempts in %d cycles\n", err ? "FAIL" : "PASS", ACCEL_REG(ACCEL_COUNTER));
+
+    err |= search_run(GENESIS_NONCE + 1, 2);
+    err |= (ACCEL_REG(ACCEL_NONCE) != GENESIS_NONCE + 3);
+    sc_printf("Nonce search limit: %s\n", err ? "FAIL" : "PASS");
+    return err;
+}
+
+// Each lane hashes its own message with FINAL; all lanes are started before any is polled
+static int sha256_lanes(void)
+{
+    static const char *const lane_str[2] = {str_abc, str_two};
+    static const unsigned int lane_len[2] = {3, 56};
+    static const unsigned int *const lane_digest[2] = {digest_abc, digest_two};
+    unsigned int i, j, k, w, n, cycles;
+    int err = 0;
+
+    ACCEL_REG(ACCEL_MODE) = ACCEL_MODE_SHA256;
+    cycles = read_csr(mcycle);
+    for (k = 0; k < ACCEL_LANES; ++k) {
+        n = k % 2;
+        ACCEL_LANE(k, ACCEL_DATALEN) = lane_len[n];
+        for (i = 0; 4 * i < lane_len[n]; ++i) {
+            for (j = 0, w = 0; j < 4; ++j)
+                w = (w << 8) | ((4 * i + j < lane_len[n]) ? (unsigned char)lane_str[n][4 * i + j] : 0);
+            ACCEL_LANE(k, ACCEL_MSG(i)) = w;
+        }
+        ACCEL_LANE(k, ACCEL_CTRL) = ACCEL_CTRL_INIT | ACCEL_CTRL_FINAL | ACCEL_CTRL_GO;
+    }
+    for (k = 0; k < ACCEL_LANES; ++k) {
+        while (!(ACCEL_LANE(k, ACCEL_CTRL) & ACCEL_CTRL_DONE))
+            ;
+    }
+    cycles = read_csr(mcycle) - cycles;
+    for (k = 0; k < ACCEL_LANES; ++k) {
+        for (i = 0; i < 8; ++i)
+            err |= (ACCEL_LANE(k, ACCEL_STATE(i)) != lane_digest[k % 2][i]);
+    }
+    sc_printf("SHA-256 %d lanes: %s, %d cycles\n", ACCEL_LANES, err ? "FAIL" : "PASS", cycles);
+    return err;
+}
+
+#if TCM
+// The two-block message as bytes in the TCM, fetched by the accelerator itself
+static unsigned char dma_msg[128] __attribute__((aligned(4)));
+
+static int sha256_dma(void)
+{
+    int i;
+    int err = 0;
+
+    for (i = 0; i < 128; ++i)
+        dma_msg[i] = (i < 56) ? str_two[i] : 0;
+    dma_msg[56]  = 0x80;
+    dma_msg[126] = 0x01;
+    dma_msg[127] = 0xc0;
+
+    ACCEL_REG(ACCEL_MODE) = ACCEL_MODE_SHA256;
+    ACCEL_REG(ACCEL_DMA_SRC) = (unsigned int)dma_msg;
+    ACCEL_REG(ACCEL_DMA_NBLK) = 2;
+    ACCEL_REG(ACCEL_CTRL) = ACCEL_CTRL_INIT | ACCEL_CTRL_DMA | ACCEL_CTRL_GO;
+    accel_wait();
+    err |= ((ACCEL_REG(ACCEL_CTRL) & ACCEL_CTRL_ERR) != 0);
+    for (i = 0; i < 8; ++i)
+        err |= (ACCEL_REG(ACCEL_STATE(i)) != digest_two[i]);
+    sc_printf("SHA-256 DMA 2 blocks: %s, %d cycles\n", err ? "FAIL" : "PASS", ACCEL_REG(ACCEL_COUNTER));
+    return err;
+}
+
+// A 64-element int8 vector in MSG against a row streamed from the TCM
+static signed char mac_row[64] __attribute__((aligned(4)));
+
+static int mac_dma(void)
+{
+    signed char x[64] __attribute__((aligned(4)));
+    int i, ref = 0;
+    int err = 0;
+
+    for (i = 0; i < 64; ++i) {
+        x[i] = (signed char)(i * 5 - 100);
+        mac_row[i] = (signed char)(77 - i * 3);
+        ref += x[i] * mac_row[i];
+    }
+    ACCEL_REG(ACCEL_MODE) = ACCEL_MODE_MAC;
+    for (i = 0; i < 16; ++i)
+        ACCEL_REG(ACCEL_MSG(i)) = ((unsigned int *)x)[i];
+    ACCEL_REG(ACCEL_DMA_SRC) = (unsigned int)mac_row;
+    ACCEL_REG(ACCEL_DMA_NBLK) = 16;
+    ACCEL_REG(ACCEL_CTRL) = ACCEL_CTRL_INIT | ACCEL_CTRL_DMA | ACCEL_CTRL_GO;
+    accel_wait();
+    err |= ((ACCEL_REG(ACCEL_CTRL) & ACCEL_CTRL_ERR) != 0);
+    err |= ((int)ACCEL_REG(ACCEL_DATA_C) != ref);
+    sc_printf("MAC DMA 64 elements: %s, %d cycles\n", err ? "FAIL" : "PASS", ACCEL_REG(ACCEL_COUNTER));
+    return err;
+}
+
+// A 128-element row: MSG holds 16 words, so DMA_NBLK 32 is refused with CTRL.ERR and
+// DATA_C untouched; two GOs of 16 words, the second without INIT, accumulate the row
+static signed char mac_row_long[128] __attribute__((aligned(4)));
+
+static int mac_dma_long(void)
+{
+    signed char x[128] __attribute__((aligned(4)));
+    int i, h, ref = 0;
+    int err = 0;
+
+    for (i = 0; i < 128; ++i) {
+        x[i] = (signed char)(i * 7 - 60);
+        mac_row_long[i] = (signed char)(90 - i * 3);
+        ref += x[i] * mac_row_long[i];
+    }
+    ACCEL_REG(ACCEL_MODE) = ACCEL_MODE_MAC;
+    ACCEL_REG(ACCEL_DATA_C) = 12345;
+    ACCEL_REG(ACCEL_DMA_SRC) = (unsigned int)mac_row_long;
+    ACCEL_REG(ACCEL_DMA_NBLK) = 32;
+    ACCEL_REG(ACCEL_CTRL) = ACCEL_CTRL_DMA | ACCEL_CTRL_GO;
+    accel_wait();
+    err |= ((ACCEL_REG(ACCEL_CTRL) & ACCEL_CTRL_ERR) == 0);
+    err |= (ACCEL_REG(ACCEL_DATA_C) != 12345);
+
+    ACCEL_REG(ACCEL_DMA_NBLK) = 16;
+    for (h = 0; h < 2; ++h) {
+        for (i = 0; i < 16; ++i)
+            ACCEL_REG(ACCEL_MSG(i)) = ((unsigned int *)x)[16 * h + i];
+        ACCEL_REG(ACCEL_DMA_SRC) = (unsigned int)(mac_row_long + 64 * h);
+        ACCEL_REG(ACCEL_CTRL) = (h ? 0 : ACCEL_CTRL_INIT) | ACCEL_CTRL_DMA | ACCEL_CTRL_GO;
+        accel_wait();
+        err |= ((ACCEL_REG(ACCEL_CTRL) & ACCEL_CTRL_ERR) != 0);
+    }
+    err |= ((int)ACCEL_REG(ACCEL_DATA_C) != ref);
+    sc_printf("MAC DMA 128 elements: %s\n", err ? "FAIL" : "PASS");
+    return err;
+}
+
+// Three messages queued on the ring; the digests are written back in byte order
+static unsigned char ring_msg[3][128] __attribute__((aligned(4)));
+static unsigned char ring_digest[3][32] __attribute__((aligned(4)));
+
+static int sha256_ring(void)
+{
+    static const char *const str[3] = {str_abc, str_two, str_long};
+    static const unsigned int len[3] = {3, 56, 112};
+    static const unsigned int *const digest[3] = {digest_abc, digest_two, digest_long};
+    unsigned int i, j, tail;
+    int err = 0;
+
+    ACCEL_REG(ACCEL_MODE) = ACCEL_MODE_SHA256;
+    tail = ACCEL_REG(ACCEL_RING_TAIL);
+    for (i = 0; i < 3; ++i) {
+        for (j = 0; j < len[i]; ++j)
+            ring_msg[i][j] = str[i][j];
+        ACCEL_REG(ACCEL_RING_ADDR(tail & 3)) = (unsigned int)ring_msg[i];
+        ACCEL_REG(ACCEL_RING_LEN(tail & 3))  = len[i];
+        ACCEL_REG(ACCEL_RING_DST(tail & 3))  = (unsigned int)ring_digest[i];
+        tail = (tail + 1) & 7;
+    }
+    ACCEL_REG(ACCEL_RING_TAIL) = tail;
+    accel_wait();
+    err |= (ACCEL_REG(ACCEL_RING_HEAD) != tail);
+    err |= ((ACCEL_REG(ACCEL_CTRL) & ACCEL_CTRL_ERR) != 0);
+    for (i = 0; i < 3; ++i)
+        for (j = 0; j < 32; ++j)
+            err |= (ring_digest[i][j] != ((digest[i][j / 4] >> (24 - 8 * (j % 4))) & 0xff));
+    sc_printf("SHA-256 ring 3 messages: %s, %d cycles\n", err ? "FAIL" : "PASS", ACCEL_REG(ACCEL_COUNTER));
+    return err;
+}
+
+// The top of the stack is the top of the TCM (common/link_tcm.ld)
+extern unsigned int __C_STACK_TOP__[];
+
+// "abc" in the last TCM word, borrowed from the frame of main: only that word may be
+// fetched, a whole tail block would run past the end of the TCM and set CTRL.ERR
+static int sha256_ring_top(void)
+{
+    volatile unsigned int *top = __C_STACK_TOP__ - 1;
+    unsigned int saved = *top;
+    unsigned int j, tail;
+    int err = 0;
+
+    *top = 'a' | ('b' << 8) | ('c' << 16);
+    ACCEL_REG(ACCEL_MODE) = ACCEL_MODE_SHA256;
+    tail = ACCEL_REG(ACCEL_RING_TAIL);
+    ACCEL_REG(ACCEL_RING_ADDR(tail & 3)) = (unsigned int)top;
+    ACCEL_REG(ACCEL_RING_LEN(tail & 3))  = 3;
+    ACCEL_REG(ACCEL_RING_DST(tail & 3))  = (unsigned int)ring_digest[0];
+    tail = (tail + 1) & 7;
+    ACCEL_REG(ACCEL_RING_TAIL) = tail;
+    accel_wait();
+    *top = saved;
+    err |= (ACCEL_REG(ACCEL_RING_HEAD) != tail);
+    err |= ((ACCEL_REG(ACCEL_CTRL) & ACCEL_CTRL_ERR) != 0);
+    for (j = 0; j < 32; ++j)
+        err |= (ring_digest[0][j] != ((digest_abc[j / 4] >> (24 - 8 * (j % 4))) & 0xff));
+    sc_printf("SHA-256 ring message at the TCM top: %s\n", err ? "FAIL" : "PASS");
+    return err;
+}
+
+// The first word past the TCM: the TCM answers the fetch with an error instead of
+// wrapping around, so a DMA GO ends with CTRL.ERR and a ring descriptor is skipped
+// (ACK clears the ERR of the GO, which a RING_TAIL write would leave set)
+static int sha256_dma_range(void)
+{
+    unsigned int tail;
+    int err = 0;
+
+    ACCEL_REG(ACCEL_MODE) = ACCEL_MODE_SHA256;
+    ACCEL_REG(ACCEL_DMA_SRC) = (unsigned int)__C_STACK_TOP__;
+    ACCEL_REG(ACCEL_DMA_NBLK) = 1;
+    ACCEL_REG(ACCEL_CTRL) = ACCEL_CTRL_INIT | ACCEL_CTRL_DMA | ACCEL_CTRL_GO;
+    accel_wait();
+    err |= ((ACCEL_REG(ACCEL_CTRL) & ACCEL_CTRL_ERR) == 0);
+
+    ACCEL_REG(ACCEL_CTRL) = ACCEL_CTRL_ACK;
+    tail = ACCEL_REG(ACCEL_RING_TAIL);
+    ACCEL_REG(ACCEL_RING_ADDR(tail & 3)) = (unsigned int)__C_STACK_TOP__;
+    ACCEL_REG(ACCEL_RING_LEN(tail & 3))  = 3;
+    ACCEL_REG(ACCEL_RING_DST(tail & 3))  = (unsigned int)ring_digest[0];
+    tail = (tail + 1) & 7;
+    ACCEL_REG(ACCEL_RING_TAIL) = tail;
+    accel_wait();
+    err |= (ACCEL_REG(ACCEL_RING_HEAD) != tail);
+    err |= ((ACCEL_REG(ACCEL_CTRL) & ACCEL_CTRL_ERR) == 0);
+    sc_printf("SHA-256 DMA past the TCM top: %s\n", err ? "FAIL" : "PASS");
+    return err;
+}
+#endif // TCM
+
+// Four signed products per GO: INIT starts a new sum, GO alone accumulates, and the
+// accumulator saturates instead of wrapping
+static int mac_lanes(void)
+{
+    int err = 0;
+
+    ACCEL_REG(ACCEL_MODE) = ACCEL_MODE_MAC;
+    ACCEL_REG(ACCEL_DATA_A) = 0xfc03fe01;   // {1, -2, 3, -4}
+    ACCEL_REG(ACCEL_DATA_B) = 0x08f90605;   // {5, 6, -7, 8}
+    ACCEL_REG(ACCEL_CTRL) = ACCEL_CTRL_INIT | ACCEL_CTRL_GO;
+    accel_wait();
+    err |= ((int)ACCEL_REG(ACCEL_DATA_C) != -60);
+    ACCEL_REG(ACCEL_CTRL) = ACCEL_CTRL_GO;
+    accel_wait();
+    err |= ((int)ACCEL_REG(ACCEL_DATA_C) != -120);
+
+    ACCEL_REG(ACCEL_DATA_C) = 0x7fffff00;
+    ACCEL_REG(ACCEL_DATA_A) = 0x7f7f7f7f;
+    ACCEL_REG(ACCEL_DATA_B) = 0x7f7f7f7f;
+    ACCEL_REG(ACCEL_CTRL) = ACCEL_CTRL_GO;
+    accel_wait();
+    err |= (ACCEL_REG(ACCEL_DATA_C) != 0x7fffffff);
+    sc_printf("MAC: %s\n", err ? "FAIL" : "PASS");
+    return err;
+}
+
+// ID: magic and version 1.x; CAPS: the lane count and RPC of the build and every feature
+static int accel_id(void)
+{
+    unsigned int id, caps;
+    int err = 0;
+
+    id = ACCEL_REG(ACCEL_ID);
+    caps = ACCEL_REG(ACCEL_CAPS);
+    err |= ((id >> 8) != 0x5C1A01);
+    err |= ((caps & 0x3f) != ACCEL_LANES);
+    err |= (((caps >> 8) & 0xf) != ACCEL_RPC);
+    err |= ((caps & 0x3f0000) != 0x3f0000);
+    sc_printf("ID %08x CAPS %08x: %s\n", id, caps, err ? "FAIL" : "PASS");
+    return err;
+}
+
+static int mul_lanes(void)
+{
+    int err;
+
+    ACCEL_REG(ACCEL_MODE) = ACCEL_MODE_MUL;
+    ACCEL_REG(ACCEL_DATA_A) = 0x00000c05;
+    ACCEL_REG(ACCEL_DATA_B) = 0x00000a07;
+    ACCEL_REG(ACCEL_CTRL) = ACCEL_CTRL_GO;
+    accel_wait();
+    err = ((ACCEL_REG(ACCEL_DATA_C) & 0xffff) != 0x7823);
+    sc_printf("MUL: %s\n", err ? "FAIL" : "PASS");
+    return err;
+}
+
+int main()
+{
+    int err = 0;
+
+    err |= accel_id();
+    err |= mul_lanes();
+    err |= mac_lanes();
+    err |= sha256_blocks(msg_abc, 1, digest_abc);
+    err |= sha256_blocks(msg_two, 2, digest_two);
+    err |= sha256_final(str_abc, 3, digest_abc);
+    err |= sha256_final(str_two, 56, digest_two);
+    err |= sha256_pipelined(str_two, 56, digest_two);
+    err |= sha256_pipelined(str_long, 112, digest_long);
+    err |= sha256_final_queued();
+    err |= sha256_context();
+    err |= sha256_hmac();
+    err |= sha256_search();
+    err |= sha256_lanes();
+#if TCM
+    err |= sha256_dma();
+    err |= sha256_ring();
+    err |= sha256_ring_top();
+    err |= sha256_dma_range();
+    err |= mac_dma();
+    err |= mac_dma_long();
+#endif // TCM
+    return err;
+}
@@ -0,0 +1,524 @@
+// Standalone throughput bench of the memory mapped accelerator (scr1_accel)
+//
+// Verilates scr1_accel alone (make run_verilator_accel_bench) and drives its dmem port
+// directly, one request per cycle, with a TCM model on the DMA port. Every lane runs a
+// script of bus transactions (writes, polled reads, result reads); the scripts of all lanes
+// are interleaved round-robin, so the bus carries back-to-back requests while the engines
+// compress. The workload is:
+//   - SHA-256 messages of random length on every lane, blocks streamed with queued GOs
+//     and closed with FINAL; digests are checked against a C++ reference;
+//   - int8 dot products on lane 0 (after its messages): PIO GOs with random operands and
+//     DMA GOs streaming random TCM vectors against MSG; accumulators are checked too.
+// Reported: SHA-256 blocks and MACs per cycle, bus utilization, and histograms of the bus
+// request-to-response latency and of the latency of every operation (from its first
+// register write to its done flag read back).
+//
+// Options: +seed=<n> +msgs=<messages per lane> +max_len=<bytes> +macs=<PIO MAC GOs>
+//          +mac_dma=<DMA MAC GOs> +gap=<% idle bus cycles> +dma_stall=<% DMA stall cycles>
+//          +max_cycles=<n>
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+#include <verilated.h>
+#include "Vscr1_accel.h"
+
+namespace {
+
+const uint32_t ACCEL_BASE      = 0xF0030000;
+const uint32_t ACCEL_CTRL      = 0x00;
+const uint32_t ACCEL_COUNTER   = 0x04;
+const uint32_t ACCEL_DATA_A    = 0x08;
+const uint32_t ACCEL_DATA_B    = 0x0C;
+const uint32_t ACCEL_DATA_C    = 0x10;
+const uint32_t ACCEL_MODE      = 0x14;
+const uint32_t ACCEL_DMA_SRC   = 0x18;
+const uint32_t ACCEL_DMA_NBLK  = 0x1C;
+const uint32_t ACCEL_DATALEN   = 0x34;
+const uint32_t ACCEL_STATE     = 0x40;
+const uint32_t ACCEL_MSG       = 0x80;
+
+const uint32_t CTRL_GO         = 1u << 0;
+const uint32_t CTRL_INIT       = 1u << 1;
+const uint32_t CTRL_DMA        = 1u << 2;
+const uint32_t CTRL_FINAL      = 1u << 3;
+const uint32_t CTRL_ACK        = 1u << 31;
+const uint32_t STAT_PEND       = 1u << 2;
+const uint32_t STAT_ERR        = 1u << 30;
+const uint32_t STAT_DONE       = 1u << 31;
+
+const uint32_t MODE_SHA256     = 1;
+const uint32_t MODE_MAC        = 2;
+
+// type_scr1_mem_cmd_e, type_scr1_mem_width_e, type_scr1_mem_resp_e
+const int MEM_CMD_RD    = 0;
+const int MEM_CMD_WR    = 1;
+const int MEM_WIDTH_WORD    = 2;
+const int MEM_RESP_NOTRDY   = 0;
+const int MEM_RESP_RDY_OK   = 1;
+
+const unsigned MAX_LANES    = 32;
+const unsigned TCM_WORDS    = 16384;
+
+//-------------------------------------------------------------------------------
+// Reference models
+//-------------------------------------------------------------------------------
+const uint32_t SHA256_K[64] = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+};
+
+uint32_t rotr(uint32_t x, unsigned n)
+{
+    return (x >> n) | (x << (32 - n));
+}
+
+void sha256_compress(uint32_t state[8], const uint8_t blk[64])
+{
+    uint32_t w[64];
+    uint32_t a[8];
+
+    for (int i = 0; i < 16; i++) {
+        w[i] = (uint32_t(blk[4 * i]) << 24) | (uint32_t(blk[4 * i + 1]) << 16)
+             | (uint32_t(blk[4 * i + 2]) << 8) | blk[4 * i + 3];
+    }
+    for (int i = 16; i < 64; i++) {
+        uint32_t s0 = rotr(w[i - 15], 7) ^ rotr(w[i - 15], 18) ^ (w[i - 15] >> 3);
+        uint32_t s1 = rotr(w[i - 2], 17) ^ rotr(w[i - 2], 19) ^ (w[i - 2] >> 10);
+        w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+    }
+    for (int i = 0; i < 8; i++) {
+        a[i] = state[i];
+    }
+    for (int i = 0; i < 64; i++) {
+        uint32_t t1 = a[7] + (rotr(a[4], 6) ^ rotr(a[4], 11) ^ rotr(a[4], 25))
+                    + ((a[4] & a[5]) ^ (~a[4] & a[6])) + SHA256_K[i] + w[i];
+        uint32_t t2 = (rotr(a[0], 2) ^ rotr(a[0], 13) ^ rotr(a[0], 22))
+                    + ((a[0] & a[1]) ^ (a[0] & a[2]) ^ (a[1] & a[2]));
+        for (int j = 7; j > 0; j--) {
+            a[j] = a[j - 1];
+        }
+        a[4] += t1;
+        a[0] = t1 + t2;
+    }
+    for (int i = 0; i < 8; i++) {
+        state[i] += a[i];
+    }
+}
+
+void sha256(const std::vector<uint8_t>& msg, uint32_t digest[8])
+{
+    static const uint32_t iv[8] = {
+        0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19
+    };
+    std::vector<uint8_t> buf(msg);
+    uint64_t bitlen = 8 * uint64_t(msg.size());
+
+    buf.push_back(0x80);
+    while (buf.size() % 64 != 56) {
+        buf.push_back(0);
+    }
+    for (int i = 7; i >= 0; i--) {
+        buf.push_back(uint8_t(bitlen >> (8 * i)));
+    }
+    memcpy(digest, iv, sizeof(iv));
+    for (size_t i = 0; i < buf.size(); i += 64) {
+        sha256_compress(digest, &buf[i]);
+    }
+}
+
+int32_t mac_dot(uint32_t a, uint32_t b)
+{
+    int32_t dot = 0;
+
+    for (int i = 0; i < 4; i++) {
+        dot += int32_t(int8_t(a >> (8 * i))) * int32_t(int8_t(b >> (8 * i)));
+    }
+    return dot;
+}
+
+int32_t mac_add(int32_t acc, int32_t dot)
+{
+    int64_t sum = int64_t(acc) + dot;
+
+    return (sum > INT32_MAX) ? INT32_MAX : (sum < INT32_MIN) ? INT32_MIN : int32_t(sum);
+}
+
+//-------------------------------------------------------------------------------
+// Bus scripts
+//-------------------------------------------------------------------------------
+struct Txn {
+    enum Kind { WRITE, POLL, CHECK, MARK } kind;
+    uint32_t addr;                      // lane window offset
+    uint32_t data;                      // WRITE: data; POLL: mask; CHECK: expected
+    uint32_t value;                     // POLL: value to wait for
+    std::string what;                   // CHECK: description; MARK: operation name
+};
+
+struct LaneScript {
+    std::deque<Txn> txns;
+    bool read_pending = false;          // a POLL/CHECK waits for its response
+    uint64_t op_start = 0;              // cycle of the last named MARK
+    std::string op_name;
+};
+
+// Power-of-two bucket histogram of latencies in cycles
+struct Histogram {
+    std::map<unsigned, uint64_t> buckets;
+    uint64_t count;
+    uint64_t sum;
+    uint64_t max;
+
+    Histogram() : count(0), sum(0), max(0) {}
+
+    void add(uint64_t v)
+    {
+        unsigned b = 0;
+        while ((uint64_t(1) << b) < v) {
+            b++;
+        }
+        buckets[b]++;
+        count++;
+        sum += v;
+        max = (v > max) ? v : max;
+    }
+
+    void print(const char* title) const
+    {
+        if (!count) {
+            return;
+        }
+        printf("%s: %llu samples, mean %.1f, max %llu cycles\n", title, (unsigned long long)count,
+               double(sum) / double(count), (unsigned long long)max);
+        for (const auto& b : buckets) {
+            uint64_t lo = b.first ? (uint64_t(1) << (b.first - 1)) + 1 : 0;
+            uint64_t hi = uint64_t(1) << b.first;
+            int bar = int(50 * b.second / count);
+            printf("  %6llu - %-6llu %8llu  %s\n", (unsigned long long)lo, (unsigned long long)hi,
+                   (unsigned long long)b.second, std::string(bar ? bar : 1, '#').c_str());
+        }
+    }
+};
+
+unsigned plusarg(const char* name, unsigned def)
+{
+    std::string match = std::string(name) + "=";
+    const char* arg = Verilated::commandArgsPlusMatch(match.c_str());
+
+    if (!arg || !arg[0]) {
+        return def;
+    }
+    return unsigned(strtoul(arg + match.size() + 1, nullptr, 0));
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    Verilated::commandArgs(argc, argv);
+
+    unsigned seed       = plusarg("seed", 1);
+    unsigned msgs       = plusarg("msgs", 32);
+    unsigned max_len    = plusarg("max_len", 300);
+    unsigned macs       = plusarg("macs", 256);
+    unsigned mac_dma    = plusarg("mac_dma", 32);
+    unsigned gap        = plusarg("gap", 0);
+    unsigned dma_stall  = plusarg("dma_stall", 0);
+    uint64_t max_cycles = plusarg("max_cycles", 20000000);
+
+    std::mt19937 rng(seed);
+    Vscr1_accel* top = new Vscr1_accel;
+    std::vector<uint32_t> tcm(TCM_WORDS);
+    uint64_t cycle = 0;
+
+    // Bus and DMA port state
+    bool tcm_resp = false;
+    uint32_t tcm_rdata = 0;
+
+    auto tick = [&]() {
+        top->dma_req_ack = (rng() % 100) >= dma_stall;
+        top->dma_resp    = tcm_resp ? MEM_RESP_RDY_OK : MEM_RESP_NOTRDY;
+        top->dma_rdata   = tcm_rdata;
+        top->clk = 0;
+        top->eval();
+        // The TCM answers an accepted request in the next cycle
+        tcm_resp = top->dma_req && top->dma_req_ack;
+        if (tcm_resp) {
+            uint32_t idx = (top->dma_addr >> 2) % TCM_WORDS;
+            if (top->dma_cmd == MEM_CMD_WR) {
+                tcm[idx] = top->dma_wdata;
+            } else {
+                tcm_rdata = tcm[idx];
+            }
+        }
+        top->clk = 1;
+        top->eval();
+        cycle++;
+    };
+
+    top->rst_n      = 0;
+    top->dmem_req   = 0;
+    for (int i = 0; i < 4; i++) {
+        tick();
+    }
+    top->rst_n = 1;
+    tick();
+
+    // Single transactions used before the run: lanes are found by their MODE register
+    auto bus = [&](int cmd, uint32_t addr, uint32_t wdata) {
+        top->dmem_req   = 1;
+        top->dmem_cmd   = cmd;
+        top->dmem_width = MEM_WIDTH_WORD;
+        top->dmem_addr  = ACCEL_BASE + addr;
+        top->dmem_wdata = wdata;
+        tick();
+        top->dmem_req   = 0;
+        uint32_t rdata  = top->dmem_rdata;
+        tick();
+        return rdata;
+    };
+
+    unsigned lanes = 1;
+    while (lanes < MAX_LANES && bus(MEM_CMD_RD, 0x100 * lanes + ACCEL_MODE, 0) == MODE_SHA256) {
+        lanes++;
+    }
+    bus(MEM_CMD_WR, ACCEL_MODE, MODE_SHA256);
+    bus(MEM_CMD_WR, ACCEL_MSG, 0);
+    bus(MEM_CMD_WR, ACCEL_CTRL, CTRL_INIT | CTRL_GO);
+    while (!(bus(MEM_CMD_RD, ACCEL_CTRL, 0) & STAT_DONE)) {
+    }
+    unsigned block_cycles = bus(MEM_CMD_RD, ACCEL_COUNTER, 0);
+    bus(MEM_CMD_WR, ACCEL_CTRL, CTRL_ACK);
+
+    // Workload
+    std::vector<LaneScript> scripts(lanes);
+    uint64_t sha_blocks = 0;
+    uint64_t mac_ops = 0;
+
+    for (unsigned k = 0; k < lanes; k++) {
+        std::deque<Txn>& t = scripts[k].txns;
+        for (unsigned m = 0; m < msgs; m++) {
+            std::vector<uint8_t> msg(rng() % (max_len + 1));
+            for (auto& b : msg) {
+                b = uint8_t(rng());
+            }
+            uint32_t digest[8];
+            sha256(msg, digest);
+
+            size_t nblk = msg.size() / 64;
+            size_t tail = msg.size() % 64;
+            sha_blocks += nblk + ((tail >= 56) ? 2 : 1);
+            t.push_back({Txn::MARK, 0, 0, 0, "SHA-256 message"});
+            for (size_t b = 0; b <= nblk; b++) {
+                size_t len = (b < nblk) ? 64 : tail;
+                // The next block is written once the queued GO of the previous one has started
+                t.push_back({Txn::POLL, ACCEL_CTRL, STAT_PEND, 0, ""});
+                for (size_t w = 0; 4 * w < len; w++) {
+                    uint32_t word = 0;
+                    for (size_t i = 0; i < 4; i++) {
+                        size_t pos = 64 * b + 4 * w + i;
+                        word |= uint32_t((pos < msg.size()) ? msg[pos] : 0) << (24 - 8 * i);
+                    }
+                    t.push_back({Txn::WRITE, ACCEL_MSG + 4 * uint32_t(w), word, 0, ""});
+                }
+                uint32_t cmd = CTRL_GO | ((b == 0) ? CTRL_INIT : 0);
+                if (b == nblk) {
+                    t.push_back({Txn::WRITE, ACCEL_DATALEN, uint32_t(tail), 0, ""});
+                    cmd |= CTRL_FINAL;
+                }
+                t.push_back({Txn::WRITE, ACCEL_CTRL, cmd, 0, ""});
+            }
+            t.push_back({Txn::POLL, ACCEL_CTRL, STAT_DONE, STAT_DONE, ""});
+            t.push_back({Txn::MARK, 0, 0, 0, ""});
+            for (uint32_t i = 0; i < 8; i++) {
+                t.push_back({Txn::CHECK, ACCEL_STATE + 4 * i, digest[i], 0,
+                             "lane " + std::to_string(k) + " SHA-256 of " + std::to_string(msg.size()) + " bytes"});
+            }
+            t.push_back({Txn::WRITE, ACCEL_CTRL, CTRL_ACK, 0, ""});
+        }
+    }
+
+    // Int8 MAC on lane 0: PIO GOs back to back, then DMA GOs over TCM vectors
+    std::deque<Txn>& t0 = scripts[0].txns;
+    int32_t acc = 0;
+    t0.push_back({Txn::WRITE, ACCEL_MODE, MODE_MAC, 0, ""});
+    t0.push_back({Txn::MARK, 0, 0, 0, "MAC PIO batch"});
+    for (unsigned i = 0; i < macs; i++) {
+        uint32_t a = rng();
+        uint32_t b = rng();
+        bool init = (i % 16) == 0;
+        acc = mac_add(init ? 0 : acc, mac_dot(a, b));
+        t0.push_back({Txn::WRITE, ACCEL_DATA_A, a, 0, ""});
+        t0.push_back({Txn::WRITE, ACCEL_DATA_B, b, 0, ""});
+        t0.push_back({Txn::WRITE, ACCEL_CTRL, CTRL_GO | (init ? CTRL_INIT : 0), 0, ""});
+        if ((i % 16) == 15 || i + 1 == macs) {
+            t0.push_back({Txn::CHECK, ACCEL_DATA_C, uint32_t(acc), 0, "PIO MAC accumulator"});
+        }
+    }
+    mac_ops += 4 * uint64_t(macs);
+    t0.push_back({Txn::MARK, 0, 0, 0, ""});
+
+    std::vector<uint32_t> vec(16);
+    for (unsigned i = 0; i < 16; i++) {
+        vec[i] = rng();
+        t0.push_back({Txn::WRITE, ACCEL_MSG + 4 * i, vec[i], 0, ""});
+    }
+    for (unsigned i = 0; i < mac_dma; i++) {
+        uint32_t nwords = 1 + rng() % 16;
+        uint32_t src = 4 * (64 * (i % 64));
+        acc = 0;
+        for (uint32_t w = 0; w < nwords; w++) {
+            tcm[src / 4 + w] = rng();
+            acc = mac_add(acc, mac_dot(tcm[src / 4 + w], vec[w]));
+        }
+        mac_ops += 4 * nwords;
+        t0.push_back({Txn::WRITE, ACCEL_DMA_SRC, src, 0, ""});
+        t0.push_back({Txn::WRITE, ACCEL_DMA_NBLK, nwords, 0, ""});
+        t0.push_back({Txn::MARK, 0, 0, 0, "MAC DMA"});
+        t0.push_back({Txn::WRITE, ACCEL_CTRL, CTRL_GO | CTRL_INIT | CTRL_DMA, 0, ""});
+        t0.push_back({Txn::POLL, ACCEL_CTRL, STAT_DONE, STAT_DONE, ""});
+        t0.push_back({Txn::MARK, 0, 0, 0, ""});
+        t0.push_back({Txn::CHECK, ACCEL_CTRL, 0, 0, "DMA MAC error flag"});
+        t0.push_back({Txn::CHECK, ACCEL_DATA_C, uint32_t(acc), 0, "DMA MAC accumulator"});
+        t0.push_back({Txn::WRITE, ACCEL_CTRL, CTRL_ACK, 0, ""});
+    }
+
+    // Run: one request per cycle from the lanes in turn
+    std::map<std::string, Histogram> op_lat;
+    Histogram bus_lat;
+    uint64_t requests = 0;
+    unsigned errors = 0;
+    unsigned turn = 0;
+    uint64_t start = cycle;
+    // Accepted requests waiting for their response, oldest first
+    struct Outstanding {
+        unsigned lane;
+        bool read;
+        uint64_t cycle;
+    };
+    std::deque<Outstanding> outstanding;
+
+    for (;;) {
+        // Local steps (MARK) do not use the bus
+        bool pending = false;
+        for (unsigned k = 0; k < lanes; k++) {
+            LaneScript& s = scripts[k];
+            while (!s.read_pending && !s.txns.empty() && s.txns.front().kind == Txn::MARK) {
+                if (!s.txns.front().what.empty()) {
+                    s.op_name   = s.txns.front().what;
+                    s.op_start  = cycle;
+                } else {
+                    op_lat[s.op_name].add(cycle - s.op_start);
+                }
+                s.txns.pop_front();
+            }
+            pending |= s.read_pending || !s.txns.empty();
+        }
+        if (!pending || cycle - start >= max_cycles) {
+            break;
+        }
+
+        // Pick the next lane with a transaction it may issue
+        top->dmem_req = 0;
+        bool issued = false;
+        unsigned issued_lane = 0;
+        bool issued_read = false;
+        if ((rng() % 100) >= gap) {
+            for (unsigned n = 0; n < lanes && !issued; n++) {
+                unsigned k = (turn + n) % lanes;
+                LaneScript& s = scripts[k];
+                if (s.read_pending || s.txns.empty()) {
+                    continue;
+                }
+                const Txn& x = s.txns.front();
+                top->dmem_req   = 1;
+                top->dmem_cmd   = (x.kind == Txn::WRITE) ? MEM_CMD_WR : MEM_CMD_RD;
+                top->dmem_width = MEM_WIDTH_WORD;
+                top->dmem_addr  = ACCEL_BASE + 0x100 * k + x.addr;
+                top->dmem_wdata = x.data;
+                issued          = true;
+                issued_lane     = k;
+                issued_read     = (x.kind != Txn::WRITE);
+                if (issued_read) {
+                    s.read_pending = true;
+                } else {
+                    s.txns.pop_front();
+                }
+                turn = (k + 1) % lanes;
+            }
+        }
+
+        tick();
+
+        // A request is accepted at the edge and answered in order from the next cycle on
+        if (issued) {
+            if (!top->dmem_req_ack) {
+                printf("REQUEST NOT ACCEPTED (cycle %llu)\n", (unsigned long long)cycle);
+                errors++;
+                break;
+            }
+            outstanding.push_back({issued_lane, issued_read, cycle - 1});
+            requests++;
+        }
+        if (top->dmem_resp != MEM_RESP_NOTRDY && !outstanding.empty()) {
+            Outstanding o = outstanding.front();
+            outstanding.pop_front();
+            bus_lat.add(cycle - o.cycle);
+            if (o.read) {
+                LaneScript& s = scripts[o.lane];
+                const Txn& x = s.txns.front();
+                uint32_t rdata = top->dmem_rdata;
+                s.read_pending = false;
+                if (x.kind == Txn::POLL) {
+                    if ((rdata & x.data) == x.value) {
+                        s.txns.pop_front();
+                    }
+                } else {
+                    uint32_t got = (x.addr == ACCEL_CTRL) ? (rdata & STAT_ERR) : rdata;
+                    if (got != x.data) {
+                        printf("MISMATCH: %s: 0x%08x, expected 0x%08x (cycle %llu)\n", x.what.c_str(),
+                               got, x.data, (unsigned long long)cycle);
+                        errors++;
+                    }
+                    s.txns.pop_front();
+                }
+            }
+        }
+    }
+
+    uint64_t cycles = cycle - start;
+    bool timeout = false;
+    for (const LaneScript& s : scripts) {
+        timeout |= !s.txns.empty();
+    }
+
+    printf("scr1_accel bench: %u lane(s), %u cycles per block, seed %u\n", lanes, block_cycles, seed);
+    printf("cycles            %llu%s\n", (unsigned long long)cycles, timeout ? " (timeout)" : "");
+    printf("bus requests      %llu (%.3f per cycle)\n", (unsigned long long)requests,
+           double(requests) / double(cycles));
+    printf("SHA-256 blocks    %llu (%.4f per cycle, %.3f bytes per cycle)\n", (unsigned long long)sha_blocks,
+           double(sha_blocks) / double(cycles), 64.0 * double(sha_blocks) / double(cycles));
+    printf("int8 MACs         %llu (%.4f per cycle)\n", (unsigned long long)mac_ops,
+           double(mac_ops) / double(cycles));
+    bus_lat.print("bus request to response");
+    for (const auto& h : op_lat) {
+        h.second.print((h.first + " latency").c_str());
+    }
+    printf("%s: %u mismatch(es)\n", (errors || timeout) ? "FAILED" : "PASSED", errors);
+
+    top->final();
+    delete top;
+    return (errors || timeout) ? 1 : 0;
+}
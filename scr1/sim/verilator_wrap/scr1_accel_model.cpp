@@ -0,0 +1,1024 @@
+// Behavioural model of the memory mapped accelerator (scr1_accel)
+//
+// Built into the Verilator testbench with ACCEL_MODEL=1, where src/tb/scr1_accel_model.sv
+// takes the place of the RTL and calls the functions at the end of this file on every
+// clock edge. The model implements the register map of scr1_accel.sv (all lanes, MUL,
+// MAC, SHA-256 PIO with queued GO, FINAL, HMAC, nonce search, DMA and the descriptor
+// ring) and drives the same DMA port, so it runs the sim/tests/accel_* programs and the
+// sw/ examples unchanged. It is a reference for the register-level behaviour and a fast
+// stand-in for exploring the latencies: each operation is a sequence of steps (wait N
+// cycles, DMA read, DMA write) whose functional effect is applied when the step ends.
+// Timing is cycle-approximate: a compression takes block_cycles (+accel_block_cycles,
+// 64 / RPC by default), a multiplication mul_cycles (+accel_mul_cycles, 2 by default)
+// and a DMA word one cycle plus the TCM latency, as in the RTL; the few cycles the RTL
+// spends between chained steps are not modelled.
+
+#include <array>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <vector>
+#include "svdpi.h"
+
+namespace {
+
+// Register offsets inside a lane window (scr1_accel.svh)
+const uint32_t ACCEL_CTRL      = 0x00;
+const uint32_t ACCEL_COUNTER   = 0x04;
+const uint32_t ACCEL_DATA_A    = 0x08;
+const uint32_t ACCEL_DATA_B    = 0x0C;
+const uint32_t ACCEL_DATA_C    = 0x10;
+const uint32_t ACCEL_MODE      = 0x14;
+const uint32_t ACCEL_DMA_SRC   = 0x18;
+const uint32_t ACCEL_DMA_NBLK  = 0x1C;
+const uint32_t ACCEL_RING_HEAD = 0x20;
+const uint32_t ACCEL_RING_TAIL = 0x24;
+const uint32_t ACCEL_IRQ_EN    = 0x28;
+const uint32_t ACCEL_NONCE     = 0x2C;
+const uint32_t ACCEL_NONCE_CNT = 0x30;
+const uint32_t ACCEL_DATALEN   = 0x34;
+const uint32_t ACCEL_BITLEN0   = 0x38;
+const uint32_t ACCEL_BITLEN1   = 0x3C;
+const uint32_t ACCEL_STATE     = 0x40;
+const uint32_t ACCEL_TARGET    = 0x60;
+const uint32_t ACCEL_MSG       = 0x80;
+const uint32_t ACCEL_RING      = 0xC0;
+
+// Identification window (0xFF00) and its registers
+const unsigned ACCEL_INFO_WINDOW = 0xFF;
+const uint32_t ACCEL_ID        = 0x00;
+const uint32_t ACCEL_CAPS      = 0x04;
+const uint32_t ACCEL_ID_VALUE  = 0x5C1A0100;   // magic, version 1.0
+
+// CAPS feature bits, above the lane count [5:0] and RPC [11:8]
+const uint32_t CAPS_FEATURES   = 0x3F0000;     // MUL, MAC, DMA, RING, HMAC, SEARCH
+const uint32_t CAPS_DMA_RING   = 0x0C0000;     // cleared without a TCM on the DMA port
+
+// CTRL command bits (write) and status bits (read)
+const uint32_t CTRL_GO     = 1u << 0;
+const uint32_t CTRL_INIT   = 1u << 1;
+const uint32_t CTRL_DMA    = 1u << 2;
+const uint32_t CTRL_FINAL  = 1u << 3;
+const uint32_t CTRL_KEY    = 1u << 4;
+const uint32_t CTRL_HMAC   = 1u << 5;
+const uint32_t CTRL_SEARCH = 1u << 6;
+const uint32_t CTRL_ACK    = 1u << 31;
+const uint32_t CTRL_CMD    = 0x7F;
+const uint32_t CTRL_LANE   = CTRL_GO | CTRL_INIT | CTRL_FINAL;
+
+const uint32_t STAT_GO     = 1u << 0;
+const uint32_t STAT_BUSY   = 1u << 1;
+const uint32_t STAT_PEND   = 1u << 2;
+const uint32_t STAT_FOUND  = 1u << 3;
+const uint32_t STAT_ERR    = 1u << 30;
+const uint32_t STAT_DONE   = 1u << 31;
+
+const uint32_t MODE_MUL    = 0;
+const uint32_t MODE_SHA256 = 1;
+const uint32_t MODE_MAC    = 2;
+
+// type_scr1_mem_resp_e
+const int RESP_NOTRDY = 0;
+const int RESP_RDY_OK = 1;
+const int RESP_RDY_ER = 2;
+
+const unsigned RING_DEPTH = 4;
+
+typedef std::array<uint32_t, 8> State;
+typedef std::array<uint32_t, 16> Block;
+
+const State SHA256_IV = {{
+    0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a,
+    0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19
+}};
+
+const uint32_t SHA256_K[64] = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+};
+
+uint32_t rotr(uint32_t x, unsigned n)
+{
+    return (x >> n) | (x << (32 - n));
+}
+
+uint32_t bswap(uint32_t x)
+{
+    return (x >> 24) | ((x >> 8) & 0xff00) | ((x << 8) & 0xff0000) | (x << 24);
+}
+
+void sha256_compress(State& state, const Block& msg)
+{
+    uint32_t w[64];
+    uint32_t a[8];
+
+    for (int i = 0; i < 16; i++) {
+        w[i] = msg[i];
+    }
+    for (int i = 16; i < 64; i++) {
+        uint32_t s0 = rotr(w[i - 15], 7) ^ rotr(w[i - 15], 18) ^ (w[i - 15] >> 3);
+        uint32_t s1 = rotr(w[i - 2], 17) ^ rotr(w[i - 2], 19) ^ (w[i - 2] >> 10);
+        w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+    }
+    for (int i = 0; i < 8; i++) {
+        a[i] = state[i];
+    }
+    for (int i = 0; i < 64; i++) {
+        uint32_t t1 = a[7] + (rotr(a[4], 6) ^ rotr(a[4], 11) ^ rotr(a[4], 25))
+                    + ((a[4] & a[5]) ^ (~a[4] & a[6])) + SHA256_K[i] + w[i];
+        uint32_t t2 = (rotr(a[0], 2) ^ rotr(a[0], 13) ^ rotr(a[0], 22))
+                    + ((a[0] & a[1]) ^ (a[0] & a[2]) ^ (a[1] & a[2]));
+        for (int j = 7; j > 0; j--) {
+            a[j] = a[j - 1];
+        }
+        a[4] += t1;
+        a[0] = t1 + t2;
+    }
+    for (int i = 0; i < 8; i++) {
+        state[i] += a[i];
+    }
+}
+
+// scr1_accel_sha256_pad: the first datalen bytes of the big-endian window, 0x80, zeroes
+Block sha256_pad(const Block& msg, unsigned datalen)
+{
+    Block pad{};
+
+    for (unsigned i = 0; i < 64; i++) {
+        unsigned shift = 24 - 8 * (i % 4);
+        uint32_t byte = (i < datalen) ? ((msg[i / 4] >> shift) & 0xff) : (i == datalen) ? 0x80 : 0;
+        pad[i / 4] |= byte << shift;
+    }
+    return pad;
+}
+
+int32_t mac_dot(uint32_t a, uint32_t b)
+{
+    int32_t dot = 0;
+
+    for (int i = 0; i < 4; i++) {
+        dot += int32_t(int8_t(a >> (8 * i))) * int32_t(int8_t(b >> (8 * i)));
+    }
+    return dot;
+}
+
+uint32_t mac_sat(int64_t sum)
+{
+    if (sum > INT32_MAX) {
+        return uint32_t(INT32_MAX);
+    }
+    if (sum < INT32_MIN) {
+        return uint32_t(INT32_MIN);
+    }
+    return uint32_t(int32_t(sum));
+}
+
+// One step of an operation; done() applies its effect and may start the next step
+struct Step {
+    enum Kind { WAIT, DMA_RD, DMA_WR } kind;
+    unsigned cycles;                    // WAIT: cycles left
+    uint32_t addr;                      // DMA: address of the first word
+    unsigned nwords;                    // DMA: words to transfer
+    State wdata;                        // DMA_WR: words to store
+    std::function<void(bool)> done;     // called with false when the DMA failed
+};
+
+struct Lane {
+    State state;
+    Block msg;
+    uint32_t datalen;
+    uint64_t bitlen;
+    uint32_t counter;
+    bool go_bit;
+    bool done;
+    bool go_pend;
+    uint32_t go_pend_cmd;
+    bool fresh;                         // started by this edge's bus write
+    std::deque<Step> steps;
+
+    bool busy() const { return !steps.empty(); }
+};
+
+class AccelModel {
+public:
+    AccelModel() { configure(1, 1, 64, 2, true); }
+
+    void configure(unsigned rpc, unsigned lanes, unsigned block_cycles, unsigned mul_cycles, bool tcm)
+    {
+        rpc_            = rpc;
+        tcm_            = tcm;
+        lanes_.resize(lanes ? lanes : 1);
+        block_cycles_   = block_cycles ? block_cycles : 1;
+        mul_cycles_     = mul_cycles ? mul_cycles : 1;
+        reset();
+    }
+
+    void reset();
+    uint32_t read(uint32_t addr) const;
+    void write(uint32_t addr, uint32_t wdata);
+    void clock(bool dma_ack, int dma_resp, uint32_t dma_rdata);
+
+    bool irq() const;
+
+    // DMA port, valid until the next clock()
+    bool        dma_req;
+    bool        dma_wr;
+    uint32_t    dma_addr;
+    uint32_t    dma_wdata;
+
+private:
+    Lane& lane0() { return lanes_[0]; }
+
+    void command(Lane& l, uint32_t cmd, bool queued);
+    void finish(Lane& l);
+
+    void wait(Lane& l, unsigned cycles, std::function<void()> fn);
+    void compress(Lane& l, const Block& blk, std::function<void()> fn);
+    void dma_read(uint32_t addr, unsigned nwords, std::function<void(bool)> fn);
+    void dma_write(uint32_t addr, const State& data, std::function<void(bool)> fn);
+    void advance(Lane& l);
+
+    void finalize(Lane& l, const Block& blk, std::function<void()> fn);
+    void dma_blocks(uint32_t addr, uint32_t nblk, std::function<void(uint32_t)> fn,
+                    std::function<void()> fail);
+    void key();
+    void search_attempt();
+    void ring_start();
+    void ring_end(bool ok);
+
+    std::vector<Lane> lanes_;
+    unsigned rpc_;
+    bool tcm_;
+    unsigned block_cycles_;
+    unsigned mul_cycles_;
+
+    // Lane 0 only
+    uint32_t mode_;
+    uint32_t data_a_;
+    uint32_t data_b_;
+    uint32_t data_c_;
+    uint32_t mac_acc_;
+    uint32_t dma_src_;
+    uint32_t dma_nblk_;
+    uint32_t irq_en_;
+    bool dma_err_;
+    bool dma_active_;
+
+    State hmac_istate_;
+    State hmac_ostate_;
+    bool hmac_active_;
+    bool key_first_;
+
+    uint32_t nonce_;
+    uint32_t nonce_cnt_;
+    State target_;
+    State search_mid_;
+    bool search_active_;
+    bool search_found_;
+
+    uint32_t ring_addr_[RING_DEPTH];
+    uint32_t ring_len_[RING_DEPTH];
+    uint32_t ring_dst_[RING_DEPTH];
+    uint32_t ring_head_;
+    uint32_t ring_tail_;
+    bool ring_active_;
+
+    // DMA transfer in progress (head step of lane 0)
+    uint32_t dma_buf_[16];
+    unsigned dma_issued_;
+    unsigned dma_recv_;
+    unsigned dma_stale_;                // responses still due for an aborted transfer
+    bool dma_fail_;
+};
+
+void AccelModel::reset()
+{
+    for (Lane& l : lanes_) {
+        l.state     = SHA256_IV;
+        l.msg       = Block{};
+        l.datalen   = 0;
+        l.bitlen    = 0;
+        l.counter   = 0;
+        l.go_bit    = false;
+        l.done      = false;
+        l.go_pend   = false;
+        l.go_pend_cmd   = 0;
+        l.fresh     = false;
+        l.steps.clear();
+    }
+    mode_       = MODE_MUL;
+    data_a_     = 0;
+    data_b_     = 0;
+    data_c_     = 0;
+    mac_acc_    = 0;
+    dma_src_    = 0;
+    dma_nblk_   = 0;
+    irq_en_     = 0;
+    dma_err_    = false;
+    dma_active_ = false;
+    hmac_istate_    = State{};
+    hmac_ostate_    = State{};
+    hmac_active_    = false;
+    key_first_      = false;
+    nonce_      = 0;
+    nonce_cnt_  = 0;
+    target_     = State{};
+    search_mid_ = State{};
+    search_active_  = false;
+    search_found_   = false;
+    for (unsigned i = 0; i < RING_DEPTH; i++) {
+        ring_addr_[i]   = 0;
+        ring_len_[i]    = 0;
+        ring_dst_[i]    = 0;
+    }
+    ring_head_      = 0;
+    ring_tail_      = 0;
+    ring_active_    = false;
+    dma_issued_ = 0;
+    dma_recv_   = 0;
+    dma_stale_  = 0;
+    dma_fail_   = false;
+    dma_req     = false;
+    dma_wr      = false;
+    dma_addr    = 0;
+    dma_wdata   = 0;
+}
+
+//-------------------------------------------------------------------------------
+// Register access
+//-------------------------------------------------------------------------------
+uint32_t AccelModel::read(uint32_t addr) const
+{
+    unsigned idx = (addr >> 8) & 0xff;
+    uint32_t off = addr & 0xfc;
+
+    if (idx == ACCEL_INFO_WINDOW) {
+        if (off == ACCEL_ID) {
+            return ACCEL_ID_VALUE;
+        }
+        if (off == ACCEL_CAPS) {
+            return (tcm_ ? CAPS_FEATURES : CAPS_FEATURES & ~CAPS_DMA_RING)
+                 | ((rpc_ & 0xf) << 8) | (uint32_t(lanes_.size()) & 0x3f);
+        }
+        return 0;
+    }
+    if (idx >= lanes_.size()) {
+        return 0;
+    }
+
+    const Lane& l = lanes_[idx];
+
+    if (off == ACCEL_CTRL) {
+        uint32_t ctrl = (l.go_bit ? STAT_GO : 0) | (l.busy() ? STAT_BUSY : 0)
+                      | (l.go_pend ? STAT_PEND : 0) | (l.done ? STAT_DONE : 0);
+        if (idx == 0) {
+            ctrl |= ((key_first_ | search_active_) ? STAT_PEND : 0)
+                 |  (search_found_ ? STAT_FOUND : 0) | (dma_err_ ? STAT_ERR : 0);
+        }
+        return ctrl;
+    }
+    if (off == ACCEL_COUNTER)   return l.counter;
+    if (off == ACCEL_DATALEN)   return l.datalen;
+    if (off == ACCEL_BITLEN0)   return uint32_t(l.bitlen);
+    if (off == ACCEL_BITLEN1)   return uint32_t(l.bitlen >> 32);
+    if ((off & 0xe0) == ACCEL_STATE)    return l.state[(off >> 2) & 7];
+    if ((off & 0xc0) == ACCEL_MSG)      return l.msg[(off >> 2) & 15];
+    if (idx != 0) {
+        return (off == ACCEL_MODE) ? MODE_SHA256 : 0;
+    }
+    switch (off) {
+        case ACCEL_DATA_A       : return data_a_;
+        case ACCEL_DATA_B       : return data_b_;
+        case ACCEL_DATA_C       : return (mode_ == MODE_MAC) ? mac_acc_ : data_c_;
+        case ACCEL_MODE         : return mode_;
+        case ACCEL_DMA_SRC      : return dma_src_;
+        case ACCEL_DMA_NBLK     : return dma_nblk_;
+        case ACCEL_RING_HEAD    : return ring_head_;
+        case ACCEL_RING_TAIL    : return ring_tail_;
+        case ACCEL_IRQ_EN       : return irq_en_;
+        case ACCEL_NONCE        : return nonce_;
+        case ACCEL_NONCE_CNT    : return nonce_cnt_;
+        default                 : break;
+    }
+    if ((off & 0xe0) == ACCEL_TARGET) {
+        return target_[(off >> 2) & 7];
+    }
+    if ((off & 0xc0) == ACCEL_RING) {
+        unsigned entry = (off >> 4) & (RING_DEPTH - 1);
+        switch ((off >> 2) & 3) {
+            case 0  : return ring_addr_[entry];
+            case 1  : return ring_len_[entry];
+            case 2  : return ring_dst_[entry];
+            default : break;
+        }
+    }
+    return 0;
+}
+
+// wdata is the replicated bus data, as dmem_writedata in the RTL
+void AccelModel::write(uint32_t addr, uint32_t wdata)
+{
+    unsigned idx = (addr >> 8) & 0xff;
+    uint32_t off = addr & 0xfc;
+
+    if (idx >= lanes_.size()) {
+        return;
+    }
+
+    Lane& l = lanes_[idx];
+    bool busy = l.busy();
+
+    if (off == ACCEL_CTRL) {
+        uint32_t cmd = wdata & ((idx == 0) ? CTRL_CMD : CTRL_LANE);
+        bool pio = (idx != 0) || ((mode_ == MODE_SHA256) && !(cmd & CTRL_DMA));
+        if (wdata & CTRL_ACK) {
+            l.done = false;
+            if (idx == 0) {
+                dma_err_ = false;
+            }
+        }
+        if (!busy) {
+            command(l, cmd, false);
+        } else if ((cmd & CTRL_GO) && !l.go_pend && pio) {
+            l.go_pend       = true;
+            l.go_pend_cmd   = cmd;
+        }
+        return;
+    }
+    if (off == ACCEL_DATALEN) {
+        if (!(idx == 0 && dma_active_)) {
+            l.datalen = wdata & 0x3f;
+        }
+        return;
+    }
+    if ((off & 0xc0) == ACCEL_MSG) {
+        l.msg[(off >> 2) & 15] = wdata;
+        return;
+    }
+    if (!busy) {
+        if (off == ACCEL_BITLEN0) {
+            l.bitlen = (l.bitlen & ~uint64_t(0xffffffff)) | wdata;
+            return;
+        }
+        if (off == ACCEL_BITLEN1) {
+            l.bitlen = (l.bitlen & 0xffffffff) | (uint64_t(wdata) << 32);
+            return;
+        }
+        if ((off & 0xe0) == ACCEL_STATE) {
+            l.state[(off >> 2) & 7] = wdata;
+            return;
+        }
+    }
+    if (idx != 0) {
+        return;
+    }
+    switch (off) {
+        case ACCEL_DATA_A       : data_a_ = wdata; return;
+        case ACCEL_DATA_B       : data_b_ = wdata; return;
+        case ACCEL_IRQ_EN       : irq_en_ = wdata & uint32_t((uint64_t(1) << lanes_.size()) - 1); return;
+        case ACCEL_RING_TAIL    :
+            ring_tail_  = wdata & (2 * RING_DEPTH - 1);
+            l.done      = false;
+            if (!busy) {
+                l.counter = 0;
+            }
+            return;
+        default                 : break;
+    }
+    if ((off & 0xc0) == ACCEL_RING) {
+        unsigned entry = (off >> 4) & (RING_DEPTH - 1);
+        switch ((off >> 2) & 3) {
+            case 0  : ring_addr_[entry] = wdata; break;
+            case 1  : ring_len_[entry]  = wdata; break;
+            case 2  : ring_dst_[entry]  = wdata; break;
+            default : break;
+        }
+        return;
+    }
+    if (busy) {
+        return;
+    }
+    switch (off) {
+        case ACCEL_DATA_C       : mac_acc_ = wdata; break;
+        case ACCEL_MODE         : mode_ = wdata & 3; break;
+        case ACCEL_DMA_SRC      : dma_src_ = wdata & ~3u; break;
+        case ACCEL_DMA_NBLK     : dma_nblk_ = wdata; break;
+        case ACCEL_NONCE        : nonce_ = wdata; break;
+        case ACCEL_NONCE_CNT    : nonce_cnt_ = wdata; break;
+        default                 :
+            if ((off & 0xe0) == ACCEL_TARGET) {
+                target_[(off >> 2) & 7] = wdata;
+            }
+            break;
+    }
+}
+
+bool AccelModel::irq() const
+{
+    for (std::size_t k = 0; k < lanes_.size(); k++) {
+        if (lanes_[k].done && ((irq_en_ >> k) & 1)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+//-------------------------------------------------------------------------------
+// Step sequencer
+//-------------------------------------------------------------------------------
+void AccelModel::wait(Lane& l, unsigned cycles, std::function<void()> fn)
+{
+    Step s;
+    s.kind      = Step::WAIT;
+    s.cycles    = cycles;
+    s.addr      = 0;
+    s.nwords    = 0;
+    s.done      = [fn](bool) { fn(); };
+    l.steps.push_back(s);
+}
+
+void AccelModel::compress(Lane& l, const Block& blk, std::function<void()> fn)
+{
+    wait(l, block_cycles_, [this, &l, blk, fn]() {
+        sha256_compress(l.state, blk);
+        fn();
+    });
+}
+
+void AccelModel::dma_read(uint32_t addr, unsigned nwords, std::function<void(bool)> fn)
+{
+    Step s;
+    s.kind      = Step::DMA_RD;
+    s.cycles    = 0;
+    s.addr      = addr & ~3u;
+    s.nwords    = nwords;
+    s.done      = fn;
+    lane0().steps.push_back(s);
+    dma_issued_ = 0;
+    dma_recv_   = 0;
+    dma_fail_   = false;
+}
+
+void AccelModel::dma_write(uint32_t addr, const State& data, std::function<void(bool)> fn)
+{
+    Step s;
+    s.kind      = Step::DMA_WR;
+    s.cycles    = 0;
+    s.addr      = addr & ~3u;
+    s.nwords    = 8;
+    s.wdata     = data;
+    s.done      = fn;
+    lane0().steps.push_back(s);
+    dma_issued_ = 0;
+    dma_recv_   = 0;
+    dma_fail_   = false;
+}
+
+// Ends the head WAIT step of a lane once its cycles have elapsed; the done callback
+// runs after the step is popped, so it may queue the next one
+void AccelModel::advance(Lane& l)
+{
+    Step& s = l.steps.front();
+
+    if (s.kind != Step::WAIT || --s.cycles != 0) {
+        return;
+    }
+
+    std::function<void(bool)> fn = s.done;
+    l.steps.pop_front();
+    fn(true);
+}
+
+void AccelModel::finish(Lane& l)
+{
+    // As in the RTL, the completion an already queued GO waits for does not set done
+    if (!l.go_pend) {
+        l.done = true;
+    }
+}
+
+void AccelModel::clock(bool ack, int resp, uint32_t rdata)
+{
+    Lane& l0 = lane0();
+
+    // DMA port: the request of the last cycle and the response to an earlier one
+    if (dma_req && ack) {
+        dma_issued_++;
+    }
+    if (resp != RESP_NOTRDY) {
+        if (dma_stale_) {
+            dma_stale_--;
+        } else if (resp == RESP_RDY_ER) {
+            dma_fail_ = true;
+        } else if (dma_recv_ < 16) {
+            dma_buf_[dma_recv_++] = rdata;
+        }
+    }
+
+    for (Lane& l : lanes_) {
+        l.go_bit = false;
+        if (!l.busy()) {
+            continue;
+        }
+        if (l.fresh) {
+            l.fresh = false;
+            continue;
+        }
+        l.counter++;
+        if (&l == &l0 && l.steps.front().kind != Step::WAIT) {
+            Step& s = l.steps.front();
+            if (dma_fail_ || dma_recv_ == s.nwords) {
+                std::function<void(bool)> fn = s.done;
+                bool ok = !dma_fail_;
+                dma_stale_ = dma_issued_ - dma_recv_ - (dma_fail_ ? 1 : 0);
+                l.steps.pop_front();
+                fn(ok);
+            }
+        } else {
+            advance(l);
+        }
+    }
+
+    // Queued GOs and ring descriptors start when their lane is idle
+    for (Lane& l : lanes_) {
+        if (!l.busy() && l.go_pend) {
+            l.go_pend = false;
+            command(l, l.go_pend_cmd, true);
+            l.fresh = false;
+        }
+    }
+    if (!l0.busy() && (mode_ == MODE_SHA256) && (ring_head_ != ring_tail_)) {
+        ring_start();
+    }
+
+    dma_req = false;
+    if (l0.busy() && l0.steps.front().kind != Step::WAIT) {
+        const Step& s = l0.steps.front();
+        if (!dma_fail_ && dma_issued_ < s.nwords) {
+            dma_req     = true;
+            dma_wr      = (s.kind == Step::DMA_WR);
+            dma_addr    = s.addr + 4 * dma_issued_;
+            dma_wdata   = dma_wr ? bswap(s.wdata[dma_issued_]) : 0;
+        }
+    }
+}
+
+//-------------------------------------------------------------------------------
+// Operations
+//-------------------------------------------------------------------------------
+void AccelModel::command(Lane& l, uint32_t cmd, bool queued)
+{
+    bool is_lane0 = (&l == &lanes_[0]);
+    uint32_t mode = is_lane0 ? mode_ : MODE_SHA256;
+
+    if (cmd & CTRL_GO) {
+        l.go_bit    = true;
+        l.done      = false;
+        l.fresh     = true;
+        if (!queued) {
+            l.counter = 0;
+        }
+        if (is_lane0) {
+            dma_err_        = false;
+            search_found_   = false;
+        }
+    }
+
+    if (mode == MODE_MUL) {
+        if (cmd & CTRL_GO) {
+            wait(l, mul_cycles_, [this]() {
+                data_c_ = (data_c_ & ~0xffffu)
+                        | (((((data_a_ >> 8) & 0xff) * ((data_b_ >> 8) & 0xff)) & 0xff) << 8)
+                        | (((data_a_ & 0xff) * (data_b_ & 0xff)) & 0xff);
+                finish(lane0());
+            });
+        }
+        return;
+    }
+
+    if (mode == MODE_MAC) {
+        if (cmd & CTRL_INIT) {
+            mac_acc_ = 0;
+        }
+        if (!(cmd & CTRL_GO)) {
+            return;
+        }
+        if (!(cmd & CTRL_DMA)) {
+            mac_acc_ = mac_sat(int64_t(int32_t(mac_acc_)) + mac_dot(data_a_, data_b_));
+            l.done  = true;
+            l.fresh = false;
+            return;
+        }
+        if (dma_nblk_ == 0 || dma_nblk_ > 16) {
+            dma_err_    = (dma_nblk_ != 0);
+            l.done      = true;
+            l.fresh     = false;
+            return;
+        }
+        dma_read(dma_src_, dma_nblk_, [this](bool ok) {
+            for (unsigned k = 0; k < dma_recv_; k++) {
+                mac_acc_ = mac_sat(int64_t(int32_t(mac_acc_)) + mac_dot(dma_buf_[k], lane0().msg[k]));
+            }
+            dma_err_ |= !ok;
+            finish(lane0());
+        });
+        return;
+    }
+
+    if (mode != MODE_SHA256) {
+        return;
+    }
+
+    bool search = (cmd & CTRL_SEARCH) != 0;
+    bool keyed  = (cmd & CTRL_KEY) && !search;
+    if ((cmd & CTRL_INIT) && !(cmd & CTRL_HMAC) && !search) {
+        l.state     = SHA256_IV;
+        l.bitlen    = 0;
+        if (is_lane0) {
+            hmac_active_ = false;
+        }
+    }
+    if ((cmd & CTRL_HMAC) && !keyed && !search) {
+        l.state     = hmac_istate_;
+        l.bitlen    = 512;
+        hmac_active_    = true;
+    }
+    if (!(cmd & CTRL_GO)) {
+        return;
+    }
+
+    if (cmd & CTRL_DMA) {
+        if (dma_nblk_ == 0) {
+            l.done  = true;
+            l.fresh = false;
+            return;
+        }
+        dma_active_ = true;
+        dma_blocks(dma_src_, dma_nblk_, [this](uint32_t) {
+            dma_active_ = false;
+            finish(lane0());
+        }, [this]() {
+            dma_active_ = false;
+            finish(lane0());
+        });
+    } else if (keyed) {
+        key();
+    } else if (search) {
+        search_active_  = true;
+        search_mid_     = l.state;
+        search_attempt();
+    } else if (cmd & CTRL_FINAL) {
+        finalize(l, l.msg, [this, &l]() { finish(l); });
+    } else {
+        compress(l, l.msg, [this, &l]() {
+            l.bitlen += 512;
+            finish(l);
+        });
+    }
+}
+
+// The DATALEN bytes of blk are padded and the length appended, in a second block when it
+// does not fit; in an HMAC message the outer block follows
+void AccelModel::finalize(Lane& l, const Block& blk, std::function<void()> fn)
+{
+    uint64_t len    = l.bitlen + 8 * uint64_t(l.datalen);
+    bool second     = (l.datalen >= 56);
+    Block tail{};
+    Block pad       = sha256_pad(blk, l.datalen);
+
+    tail[14]    = uint32_t(len >> 32);
+    tail[15]    = uint32_t(len);
+    if (!second) {
+        pad[14] = tail[14];
+        pad[15] = tail[15];
+    }
+
+    std::function<void()> outer = [this, &l, fn]() {
+        if (&l != &lanes_[0] || !hmac_active_) {
+            fn();
+            return;
+        }
+        Block hwin{};
+        for (int i = 0; i < 8; i++) {
+            hwin[i] = l.state[i];
+        }
+        hwin[8]     = 0x80000000;
+        hwin[15]    = 768;
+        l.state     = hmac_ostate_;
+        compress(l, hwin, [this, fn]() {
+            hmac_active_ = false;
+            fn();
+        });
+    };
+
+    compress(l, pad, [this, &l, second, tail, outer]() {
+        if (second) {
+            compress(l, tail, outer);
+        } else {
+            outer();
+        }
+    });
+}
+
+// KEY: the inner and outer midstates, each compressed from the IV
+void AccelModel::key()
+{
+    Lane& l = lane0();
+    Block blk;
+
+    for (int i = 0; i < 16; i++) {
+        blk[i] = l.msg[i] ^ 0x36363636;
+    }
+    l.state         = SHA256_IV;
+    l.bitlen        = 0;
+    hmac_active_    = false;
+    key_first_      = true;
+    compress(l, blk, [this, &l]() {
+        Block oblk;
+        for (int i = 0; i < 16; i++) {
+            oblk[i] = l.msg[i] ^ 0x5c5c5c5c;
+        }
+        hmac_istate_    = l.state;
+        key_first_      = false;
+        l.state         = SHA256_IV;
+        compress(l, oblk, [this, &l]() {
+            hmac_ostate_ = l.state;
+            finish(l);
+        });
+    });
+}
+
+// One nonce: the header tail from the midstate, then its digest from the IV
+void AccelModel::search_attempt()
+{
+    Lane& l = lane0();
+    Block blk{};
+
+    blk[0]  = l.msg[0];
+    blk[1]  = l.msg[1];
+    blk[2]  = l.msg[2];
+    blk[3]  = bswap(nonce_);
+    blk[4]  = 0x80000000;
+    blk[15] = 640;
+    l.state = search_mid_;
+    compress(l, blk, [this, &l]() {
+        Block hblk{};
+        for (int i = 0; i < 8; i++) {
+            hblk[i] = l.state[i];
+        }
+        hblk[8]     = 0x80000000;
+        hblk[15]    = 256;
+        l.state     = SHA256_IV;
+        compress(l, hblk, [this, &l]() {
+            // The hash read as a little-endian number against TARGET, top word first
+            bool hit = true;
+            for (int i = 0; i < 8; i++) {
+                if (bswap(l.state[i]) != target_[i]) {
+                    hit = (bswap(l.state[i]) < target_[i]);
+                }
+            }
+            bool last = hit || (nonce_cnt_ == 1);
+            if (!hit) {
+                nonce_++;
+                nonce_cnt_--;
+            }
+            if (last) {
+                search_active_  = false;
+                search_found_   = hit;
+                finish(l);
+            } else {
+                search_attempt();
+            }
+        });
+    });
+}
+
+// nblk blocks from addr, fetched one at a time and compressed into lane 0;
+// fn gets the address after the last block
+void AccelModel::dma_blocks(uint32_t addr, uint32_t nblk, std::function<void(uint32_t)> fn,
+                            std::function<void()> fail)
+{
+    dma_read(addr, 16, [this, addr, nblk, fn, fail](bool ok) {
+        if (!ok) {
+            dma_err_ = true;
+            fail();
+            return;
+        }
+        Block blk;
+        for (int i = 0; i < 16; i++) {
+            blk[i] = bswap(dma_buf_[i]);
+        }
+        Lane& l = lane0();
+        compress(l, blk, [this, &l, addr, nblk, fn, fail]() {
+            l.bitlen += 512;
+            if (nblk > 1) {
+                dma_blocks(addr + 64, nblk - 1, fn, fail);
+            } else {
+                fn(addr + 64);
+            }
+        });
+    });
+}
+
+// Descriptor: whole blocks, then the trailing bytes finalized and the digest stored
+void AccelModel::ring_start()
+{
+    Lane& l = lane0();
+    unsigned idx    = ring_head_ & (RING_DEPTH - 1);
+    uint32_t len    = ring_len_[idx];
+    uint32_t dst    = ring_dst_[idx];
+
+    ring_active_    = true;
+    dma_active_     = true;
+    l.state         = SHA256_IV;
+    l.bitlen        = 0;
+    l.datalen       = len & 63;
+    hmac_active_    = false;
+
+    // Only the words holding trailing bytes are fetched, so a message ending at the
+    // top of the TCM is not read past its end; the padding masks the stale rest
+    std::function<void(uint32_t)> tail = [this, &l, dst](uint32_t addr) {
+        std::function<void()> fin = [this, &l, dst]() {
+            Block blk;
+            for (int i = 0; i < 16; i++) {
+                blk[i] = bswap(dma_buf_[i]);
+            }
+            finalize(l, blk, [this, &l, dst]() {
+                dma_write(dst, l.state, [this](bool ok) { ring_end(ok); });
+            });
+        };
+        if (l.datalen == 0) {
+            fin();
+            return;
+        }
+        dma_read(addr, (l.datalen + 3) / 4, [this, fin](bool ok) {
+            if (!ok) {
+                ring_end(false);
+                return;
+            }
+            fin();
+        });
+    };
+
+    if ((len >> 6) == 0) {
+        tail(ring_addr_[idx]);
+    } else {
+        dma_blocks(ring_addr_[idx], len >> 6, tail, [this]() { ring_end(false); });
+    }
+}
+
+void AccelModel::ring_end(bool ok)
+{
+    dma_err_        = dma_err_ || !ok;
+    ring_active_    = false;
+    dma_active_     = false;
+    ring_head_      = (ring_head_ + 1) & (2 * RING_DEPTH - 1);
+    if (ring_head_ == ring_tail_) {
+        finish(lane0());
+    }
+}
+
+AccelModel model;
+
+} // namespace
+
+//-------------------------------------------------------------------------------
+// DPI interface (src/tb/scr1_accel_model.sv)
+//-------------------------------------------------------------------------------
+extern "C" void scr1_accel_model_init(int rpc, int lanes, int block_cycles, int mul_cycles, int tcm)
+{
+    model.configure(rpc, lanes, block_cycles, mul_cycles, tcm != 0);
+}
+
+extern "C" void scr1_accel_model_reset()
+{
+    model.reset();
+}
+
+extern "C" int scr1_accel_model_read(int addr)
+{
+    return int(model.read(uint32_t(addr)));
+}
+
+extern "C" void scr1_accel_model_write(int addr, int wdata)
+{
+    model.write(uint32_t(addr), uint32_t(wdata));
+}
+
+extern "C" void scr1_accel_model_clock(svBit dma_ack, int dma_resp, int dma_rdata,
+                                       svBit* dma_req, svBit* dma_wr, int* dma_addr,
+                                       int* dma_wdata, svBit* irq)
+{
+    model.clock(dma_ack != 0, dma_resp, uint32_t(dma_rdata));
+    *dma_req    = model.dma_req;
+    *dma_wr     = model.dma_wr;
+    *dma_addr   = int(model.dma_addr);
+    *dma_wdata  = int(model.dma_wdata);
+    *irq        = model.irq();
+}
@@ -0,0 +1,151 @@
+/// Copyright by Syntacore LLC © 2016-2021. See LICENSE for details
+/// @file       <scr1_accel_model.sv>
+/// @brief      DPI shim of the behavioural accelerator model
+///
+/// Stands in for scr1_accel (same module name, parameters and ports) when the simulation
+/// is built with ACCEL_MODEL=1: the register bus and the DMA port are handed to the C++
+/// model in sim/verilator_wrap/scr1_accel_model.cpp on every clock edge. Bus timing is that
+/// of the RTL (requests acknowledged at once, response and read data one cycle later); the
+/// operation latencies come from the model and can be changed at run time:
+///   +accel_block_cycles=<n>   cycles per SHA-256 compression (default 64 / RPC)
+///   +accel_mul_cycles=<n>     cycles per MODE_MUL operation (default 2)
+///
+
+`include "scr1_memif.svh"
+`include "scr1_arch_description.svh"
+
+module scr1_accel
+#(
+    parameter int unsigned SCR1_ACCEL_SHA256_RPC    = 1,    // SHA-256 rounds per clock: 1, 2, 4 or 8
+    parameter int unsigned SCR1_ACCEL_SHA256_LANES  = 1,    // SHA-256 lanes, 1 to 32
+    parameter bit          SCR1_ACCEL_TCM_EN        = 1     // DMA port connected to a TCM
+)
+(
+    // Control signals
+    input   logic                           clk,
+    input   logic                           rst_n,
+
+
+    // Core data interface
+    output  logic                           dmem_req_ack,
+    input   logic                           dmem_req,
+    input   type_scr1_mem_cmd_e             dmem_cmd,
+    input   type_scr1_mem_width_e           dmem_width,
+    input   logic [`SCR1_DMEM_AWIDTH-1:0]   dmem_addr,
+    input   logic [`SCR1_DMEM_DWIDTH-1:0]   dmem_wdata,
+    output  logic [`SCR1_DMEM_DWIDTH-1:0]   dmem_rdata,
+    output  type_scr1_mem_resp_e            dmem_resp,
+
+    // DMA interface (TCM)
+    input   logic                           dma_req_ack,
+    output  logic                           dma_req,
+    output  type_scr1_mem_cmd_e             dma_cmd,
+    output  logic [`SCR1_DMEM_AWIDTH-1:0]   dma_addr,
+    output  logic [`SCR1_DMEM_DWIDTH-1:0]   dma_wdata,
+    input   logic [`SCR1_DMEM_DWIDTH-1:0]   dma_rdata,
+    input   type_scr1_mem_resp_e            dma_resp,
+
+    // Interrupt
+    output  logic                           irq             // Operation done (CTRL.done & IRQ_EN)
+);
+
+//-------------------------------------------------------------------------------
+// Model interface
+//-------------------------------------------------------------------------------
+import "DPI-C" function void scr1_accel_model_init (input int rpc, input int lanes,
+                                                    input int block_cycles, input int mul_cycles,
+                                                    input int tcm);
+import "DPI-C" function void scr1_accel_model_reset ();
+import "DPI-C" function int  scr1_accel_model_read (input int addr);
+import "DPI-C" function void scr1_accel_model_write (input int addr, input int wdata);
+import "DPI-C" function void scr1_accel_model_clock (input bit dma_ack, input int dma_resp, input int dma_rdata,
+                                                     output bit req, output bit wr, output int addr,
+                                                     output int wdata, output bit irq_out);
+
+//-------------------------------------------------------------------------------
+// Local signal declaration
+//-------------------------------------------------------------------------------
+logic                               dmem_rd;
+logic                               dmem_wr;
+logic [`SCR1_DMEM_DWIDTH-1:0]       dmem_writedata;
+logic [`SCR1_DMEM_DWIDTH-1:0]       dmem_rdata_reg;
+logic [1:0]                         dmem_rdata_shift_reg;
+
+bit                                 model_req;
+bit                                 model_wr;
+int                                 model_addr;
+int                                 model_wdata;
+bit                                 model_irq;
+
+initial begin
+    int block_cycles;
+    int mul_cycles;
+
+    if (!$value$plusargs("accel_block_cycles=%d", block_cycles)) begin
+        block_cycles = 64 / SCR1_ACCEL_SHA256_RPC;
+    end
+    if (!$value$plusargs("accel_mul_cycles=%d", mul_cycles)) begin
+        mul_cycles = 2;
+    end
+    scr1_accel_model_init(SCR1_ACCEL_SHA256_RPC, SCR1_ACCEL_SHA256_LANES, block_cycles, mul_cycles,
+                          int'(SCR1_ACCEL_TCM_EN));
+end
+
+//-------------------------------------------------------------------------------
+// Core interface
+//-------------------------------------------------------------------------------
+assign dmem_req_ack = 1'b1;
+assign dmem_rd      = dmem_req & (dmem_cmd == SCR1_MEM_CMD_RD);
+assign dmem_wr      = dmem_req & (dmem_cmd == SCR1_MEM_CMD_WR);
+
+always_comb begin
+    dmem_writedata = dmem_wdata;
+    case ( dmem_width )
+        SCR1_MEM_WIDTH_BYTE : begin
+            dmem_writedata  = {(`SCR1_DMEM_DWIDTH /  8){dmem_wdata[7:0]}};
+        end
+        SCR1_MEM_WIDTH_HWORD : begin
+            dmem_writedata  = {(`SCR1_DMEM_DWIDTH / 16){dmem_wdata[15:0]}};
+        end
+        default : begin
+        end
+    endcase
+end
+
+// A read sees the registers before the edge, a write takes effect at it; the model then
+// advances one cycle, taking the DMA response and producing the next DMA request
+always_ff @(posedge clk, negedge rst_n) begin
+    if (~rst_n) begin
+        dmem_resp   <= SCR1_MEM_RESP_NOTRDY;
+        model_req   <= 1'b0;
+        model_wr    <= 1'b0;
+        model_addr  <= 0;
+        model_wdata <= 0;
+        model_irq   <= 1'b0;
+        scr1_accel_model_reset();
+    end else begin
+        dmem_resp   <= dmem_req ? SCR1_MEM_RESP_RDY_OK : SCR1_MEM_RESP_NOTRDY;
+        if (dmem_rd) begin
+            dmem_rdata_reg          <= scr1_accel_model_read(int'(dmem_addr));
+            dmem_rdata_shift_reg    <= dmem_addr[1:0];
+        end
+        if (dmem_wr) begin
+            scr1_accel_model_write(int'(dmem_addr), int'(dmem_writedata));
+        end
+        scr1_accel_model_clock(dma_req & dma_req_ack, int'(dma_resp), int'(dma_rdata),
+                               model_req, model_wr, model_addr, model_wdata, model_irq);
+    end
+end
+
+assign dmem_rdata   = dmem_rdata_reg >> ( 8 * dmem_rdata_shift_reg );
+
+//-------------------------------------------------------------------------------
+// DMA and interrupt
+//-------------------------------------------------------------------------------
+assign dma_req      = model_req;
+assign dma_cmd      = model_wr ? SCR1_MEM_CMD_WR : SCR1_MEM_CMD_RD;
+assign dma_addr     = `SCR1_DMEM_AWIDTH'(model_addr);
+assign dma_wdata    = `SCR1_DMEM_DWIDTH'(model_wdata);
+assign irq          = model_irq;
+
+endmodule : scr1_accel
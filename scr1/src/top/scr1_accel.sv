@@ -2,11 +2,108 @@
 /// @file       <scr1_accel.sv>
 /// @brief      Memory Mapped Accelerator
 ///
+/// Register map (word registers, offsets from the accelerator base):
+///   0x00        CTRL     W: [0] GO (in MODE_SHA256 without DMA, a GO written while busy is queued
+///                           together with INIT/FINAL and started when the current operation ends),
+///                           [1] INIT (load IV into STATE before GO),
+///                           [2] DMA (fetch DMA_NBLK blocks from DMA_SRC instead of using MSG),
+///                           [3] FINAL (pad the DATALEN bytes in MSG and append the message length)
+///                           [4] KEY (derive the HMAC midstates from the 64-byte key block in MSG;
+///                               INIT, FINAL and HMAC are ignored, see below)
+///                           [5] HMAC (instead of INIT: start an HMAC message from the inner midstate)
+///                           [6] SEARCH (double SHA-256 nonce search, see below)
+///                           [31] ACK (clear done, deasserting the interrupt)
+///                        R: [0] go, [1] busy, [2] GO queued or KEY/SEARCH reading MSG (MSG still in use),
+///                           [3] SEARCH found a nonce, [30] DMA error (kept until GO or ACK,
+///                           so it covers every descriptor finished since then),
+///                           [31] done (set when the last queued operation completes)
+///   0x04        COUNTER  cycles spent on the last operation (64 / SCR1_ACCEL_SHA256_RPC per block,
+///                        plus the block fetch time in DMA mode); not cleared by a queued GO, so it
+///                        accumulates over a pipelined run
+///   0x08-0x10   DATA_A, DATA_B, DATA_C   8-bit multiplier operands/result (MODE_MUL);
+///                        in MODE_MAC four int8 operands each in DATA_A/DATA_B (element 0 in
+///                        bits [7:0]) and the 32-bit accumulator in DATA_C (writable when idle)
+///   0x14        MODE     0 - MUL, 1 - SHA256, 2 - MAC
+///   0x18        DMA_SRC  TCM byte address of the first message block (word aligned);
+///                        the vector streamed against MSG in MODE_MAC
+///   0x1C        DMA_NBLK number of 64-byte blocks to hash in DMA mode; the number of 4-element
+///                        words (0..16) in MODE_MAC, where a larger value sets CTRL.ERR and
+///                        leaves DATA_C alone (longer rows take one GO per 16 words)
+///   0x20        RING_HEAD index of the next descriptor to hash (read-only)
+///   0x24        RING_TAIL index of the next free descriptor, written to submit descriptors
+///                        (indices count modulo 8, entry = index % 4; the ring is empty when
+///                         HEAD == TAIL and full when TAIL - HEAD == 4)
+///   0x28        IRQ_EN   [k] raise the irq output while CTRL.done of lane k is set (level, cleared
+///                        by CTRL.ACK, GO or a RING_TAIL write)
+///   0x2C        NONCE    SEARCH: first nonce to try; the winning nonce when CTRL.found is set,
+///                        otherwise the next untried one
+///   0x30        NONCE_CNT SEARCH: number of nonces to try (0 - all 2^32)
+///   0x34        DATALEN  number of valid bytes in MSG for FINAL (0..63)
+///   0x38-0x3C   BITLEN   64-bit count of message bits already compressed (low word first),
+///                        cleared by INIT and advanced by 512 per compressed block;
+///                        FINAL appends BITLEN + 8 * DATALEN as the message length
+///   0x40-0x5C   STATE    SHA-256 chaining state H0..H7
+///   0x60-0x7C   TARGET   SEARCH: 256-bit target, least significant word first
+///   0x80-0xBC   MSG      SHA-256 message buffer W0..W15 (big-endian words), copied into the
+///                        compression window when an operation starts: the next block may be
+///                        written while the current one is compressed, then GO queued
+///   0xC0-0xFC   RING     4 descriptors of 4 words: ADDR (TCM message address, word aligned),
+///                        LEN (message length in bytes), DST (TCM digest address, word aligned),
+///                        reserved. CTRL.done is set when the ring is drained; no word past
+///                        ADDR + LEN is read
+///
+/// DATALEN, BITLEN and STATE (0x34-0x5C) have the layout of the datalen, bitlen and state
+/// members of SHA256_CTX in sw/sha256: a stream is suspended by reading BITLEN and STATE once
+/// CTRL.done is set and resumed by writing them back. BITLEN and STATE writes are ignored
+/// while busy.
+///
+/// HMAC-SHA256 (lane 0): KEY|GO compresses (key ^ ipad) and (key ^ opad) from the IV and keeps
+/// both midstates. KEY takes the key zero-padded in MSG, so firmware hashes a key longer than
+/// 64 bytes first and loads its digest, as RFC 2104 requires. Then each message is hashed with
+/// HMAC in place of INIT on its first GO (BITLEN starts at 512). When the
+/// FINAL block of that message is done, the outer block (inner digest, padding, length 768) is
+/// compressed from the outer midstate; CTRL.done is set after it, and STATE holds the MAC.
+/// The midstates stay valid until the next KEY, so each further message costs only its own
+/// blocks plus the outer block.
+///
+/// Nonce search (lane 0): STATE holds the midstate of the first 64 bytes of an 80-byte header
+/// and MSG W0..W2 the next 12 bytes. SEARCH|GO hashes the header twice for every nonce from
+/// NONCE on, the nonce stored little-endian in bytes 76..79. Each attempt is two compressions:
+/// the tail block from the midstate, then the 32-byte digest from the IV. The search stops on
+/// the first double hash that, read as a little-endian 256-bit number, is not above TARGET
+/// (CTRL.found set, STATE holds that hash), or after NONCE_CNT attempts. CTRL.done is set
+/// either way.
+///
+/// Int8 dot product (MODE_MAC, lane 0): GO adds the dot product of the four signed bytes of
+/// DATA_A and DATA_B to the accumulator in one cycle, with INIT clearing the accumulator first
+/// (INIT alone just clears it). The sum saturates at the int32 limits. DMA|GO instead streams
+/// DMA_NBLK words from DMA_SRC in the TCM against MSG W0.. (the same byte order, one word per
+/// element quad), so a 64-element vector held in MSG is reused for every row of a layer at
+/// four MACs per fetched word.
+///
+/// The map above is lane 0. Lanes 1..SCR1_ACCEL_SHA256_LANES-1 are SHA-256 only and sit at
+/// k * 0x100 with CTRL (GO/INIT/FINAL/ACK, queued GO), COUNTER, DATALEN, BITLEN, STATE and MSG
+/// at the same offsets; each lane has its own engine, so independent messages hash in parallel.
+///
+/// Identification (read-only, writes ignored), at 0xFF00 above every lane window:
+///   0xFF00      ID       [31:16] 0x5C1A, [15:8] major and [7:0] minor version of this map
+///   0xFF04      CAPS     [5:0] SCR1_ACCEL_SHA256_LANES, [11:8] SCR1_ACCEL_SHA256_RPC, [16] MUL,
+///                        [17] MAC, [18] DMA, [19] RING, [20] HMAC, [21] SEARCH; DMA and RING are
+///                        set only when the DMA port reaches a TCM (SCR1_ACCEL_TCM_EN)
+/// Firmware built for several platforms reads ID to find out whether the accelerator is there
+/// and CAPS to pick the features it uses.
+///
 
 `include "scr1_memif.svh"
 `include "scr1_arch_description.svh"
+`include "scr1_accel.svh"
 
 module scr1_accel
+#(
+    parameter int unsigned SCR1_ACCEL_SHA256_RPC    = 1,    // SHA-256 rounds per clock: 1, 2, 4 or 8
+    parameter int unsigned SCR1_ACCEL_SHA256_LANES  = 1,    // SHA-256 lanes, 1 to 32
+    parameter bit          SCR1_ACCEL_TCM_EN        = 1     // DMA port connected to a TCM
+)
 (
     // Control signals
     input   logic                           clk,
@@ -21,31 +118,213 @@ module scr1_accel
     input   logic [`SCR1_DMEM_AWIDTH-1:0]   dmem_addr,
     input   logic [`SCR1_DMEM_DWIDTH-1:0]   dmem_wdata,
     output  logic [`SCR1_DMEM_DWIDTH-1:0]   dmem_rdata,
-    output  type_scr1_mem_resp_e            dmem_resp
-);
+    output  type_scr1_mem_resp_e            dmem_resp,
+
+    // DMA interface (TCM)
+    input   logic                           dma_req_ack,
+    output  logic                           dma_req,
+    output  type_scr1_mem_cmd_e             dma_cmd,
+    output  logic [`SCR1_DMEM_AWIDTH-1:0]   dma_addr,
+    output  logic [`SCR1_DMEM_DWIDTH-1:0]   dma_wdata,
+    input   logic [`SCR1_DMEM_DWIDTH-1:0]   dma_rdata,
+    input   type_scr1_mem_resp_e            dma_resp,
 
+    // Interrupt
+    output  logic                           irq             // Operation done (CTRL.done & IRQ_EN)
+);
 
+//-------------------------------------------------------------------------------
+// Local parameters declaration
+//-------------------------------------------------------------------------------
+localparam int unsigned SCR1_ACCEL_RING_DEPTH                               = 4;    // 16-byte descriptors in 0xC0-0xFF
+localparam int unsigned SCR1_ACCEL_RING_IDX_WIDTH                           = $clog2(SCR1_ACCEL_RING_DEPTH);
 
 //-------------------------------------------------------------------------------
 // Local signal declaration
 //-------------------------------------------------------------------------------
-logic                               dmem_req_en;
 logic                               dmem_rd;
 logic                               dmem_wr;
 logic [`SCR1_DMEM_DWIDTH-1:0]       dmem_writedata;
 logic [`SCR1_DMEM_DWIDTH-1:0]       dmem_rdata_local;
+logic [`SCR1_DMEM_DWIDTH-1:0]       dmem_rdata_reg;
 logic [1:0]                         dmem_rdata_shift_reg;
+
+logic                               ctrl_up;
+logic                               data_a_up;
+logic                               data_b_up;
+logic                               data_c_up;
+logic                               mode_up;
+logic                               dma_src_up;
+logic                               dma_nblk_up;
+logic                               datalen_up;
+logic                               bitlen0_up;
+logic                               bitlen1_up;
+logic                               ring_tail_up;
+logic                               ring_desc_up;
+logic                               irq_en_up;
+logic                               nonce_up;
+logic                               nonce_cnt_up;
+logic                               target_up;
+logic                               state_up;
+logic                               msg_up;
+
+logic                               go_bit;
+logic                               go_bit_in;
+logic                               go_queue;
+logic                               go_pend;
+logic [6:0]                         go_pend_cmd;
+logic                               cmd_up;
+logic [6:0]                         cmd;
+logic                               done_bit;
+logic                               done_bit_in;
+logic                               done_ack;
+logic [SCR1_ACCEL_SHA256_LANES-1:0] irq_en;
+logic                               busy;
+logic [31:0]                        counter;
+logic [1:0]                         mode;
+
+// Multiplier
+logic [31:0]                        data_A;
+logic [31:0]                        data_B;
+logic [31:0]                        data_C;
+logic                               mul_busy;
+logic                               mul_lane;
+logic [7:0]                         in1;
+logic [7:0]                         in2;
+logic [7:0]                         out;
+
+// Int8 dot product
+logic [31:0]                        mac_acc;
+logic [31:0]                        mac_a;
+logic [31:0]                        mac_b;
+logic signed [17:0]                 mac_dot;
+logic signed [32:0]                 mac_sum;
+logic                               mac_step;
+logic                               mac_clear;
+logic                               mac_dma_start;
+logic                               mac_dma_over;
+logic                               mac_fetch;
+logic                               mac_recv;
+logic                               mac_err_in;
+logic [4:0]                         mac_len;
+logic [4:0]                         mac_issue_cnt;
+logic [4:0]                         mac_recv_cnt;
+logic [`SCR1_DMEM_AWIDTH-1:0]       mac_addr;
+
+// SHA-256 engine
+logic                               sha_start;
+logic                               sha_init;
+logic                               sha_busy;
+logic                               sha_done;
+logic [7:0][31:0]                   sha_state;
+logic [15:0][31:0]                  sha_msg;
+logic [15:0][31:0]                  msg_buf;
+logic                               sha_msg_we;
+logic [3:0]                         sha_msg_idx;
+logic [31:0]                        sha_msg_wdata;
+logic                               sha_msg_load;
+logic [15:0][31:0]                  sha_msg_load_data;
+logic                               sha_state_load;
+logic [7:0][31:0]                   sha_state_load_data;
+logic                               sha_blk_done;
+
+// Finalization
+logic [5:0]                         datalen;
+logic [63:0]                        bitlen;
+logic [63:0]                        bitlen_cur;
+logic [63:0]                        fin_len;
+logic [63:0]                        fin_len_hold;
+logic                               fin_start;
+logic                               fin_active;
+logic                               fin_second;
+logic [15:0][31:0]                  fin_window;
+
+// HMAC
+logic                               key_start;
+logic                               key_next;
+logic                               key_first;
+logic                               key_second;
+logic [7:0][31:0]                   hmac_istate;
+logic [7:0][31:0]                   hmac_ostate;
+logic                               hmac_start;
+logic                               hmac_active;
+logic                               hmac_outer;
+logic                               hmac_outer_start;
+logic [15:0][31:0]                  hmac_window;
+
+// Nonce search
+logic [31:0]                        nonce;
+logic [31:0]                        nonce_cnt;
+logic [7:0][31:0]                   target;
+logic [7:0][31:0]                   search_mid;
+logic [7:0][31:0]                   search_hash;
+logic [31:0]                        search_nonce;
+logic                               search_start;
+logic                               search_next;
+logic                               search_inner_done;
+logic                               search_outer_done;
+logic                               search_hit;
+logic                               search_end;
+logic                               search_active;
+logic                               search_outer;
+logic                               search_found;
+logic [15:0][31:0]                  search_window;
+
+// DMA
+logic [31:0]                        dma_src;
+logic [31:0]                        dma_nblk;
+logic                               dma_start;
+logic                               dma_active;
+logic                               dma_fetch;
+logic                               dma_fetch_done;
+logic                               dma_store;
+logic                               dma_store_done;
+logic                               dma_final;
+logic                               dma_tail_go;
+logic                               dma_tail_skip;
+logic [4:0]                         dma_fetch_words;
+logic                               dma_block_done;
+logic                               dma_resp_ok;
+logic                               dma_last;
+logic                               dma_err;
+logic                               dma_err_in;
+logic [31:0]                        dma_blocks_left;
+logic [`SCR1_DMEM_AWIDTH-1:0]       dma_addr_reg;
+logic [4:0]                         dma_issue_cnt;
+logic [3:0]                         dma_recv_cnt;
+logic                               dma_recv;
+
+// Descriptor ring
+logic [SCR1_ACCEL_RING_DEPTH-1:0][31:0]     ring_addr;
+logic [SCR1_ACCEL_RING_DEPTH-1:0][31:0]     ring_len;
+logic [SCR1_ACCEL_RING_DEPTH-1:0][31:0]     ring_dst;
+logic [SCR1_ACCEL_RING_IDX_WIDTH:0]         ring_head;
+logic [SCR1_ACCEL_RING_IDX_WIDTH:0]         ring_tail;
+logic [SCR1_ACCEL_RING_IDX_WIDTH:0]         ring_tail_next;
+logic [SCR1_ACCEL_RING_IDX_WIDTH-1:0]       ring_head_idx;
+logic                                       ring_active;
+logic                                       ring_start;
+logic                                       ring_done_in;
+logic                                       ring_drained;
+
+// Lanes
+logic                                                       lane0_sel;
+logic [SCR1_ACCEL_SHA256_LANES-1:0]                         lane_done;
+logic [SCR1_ACCEL_SHA256_LANES-1:0][`SCR1_DMEM_DWIDTH-1:0]  lane_rdata;
+
+// Identification
+logic                                                       info_sel;
+logic [`SCR1_DMEM_DWIDTH-1:0]                               info_id;
+logic [`SCR1_DMEM_DWIDTH-1:0]                               info_caps;
+
 //-------------------------------------------------------------------------------
 // Core interface
 //-------------------------------------------------------------------------------
-assign dmem_req_en = (dmem_resp == SCR1_MEM_RESP_RDY_OK) ^ dmem_req;
-
-
 always_ff @(posedge clk, negedge rst_n) begin
     if (~rst_n) begin
-        dmem_resp <= SCR1_MEM_RESP_NOTRDY;
-    end else if (dmem_req_en) begin
-        dmem_resp <= dmem_req ? SCR1_MEM_RESP_RDY_OK : SCR1_MEM_RESP_NOTRDY;
+        dmem_resp   <= SCR1_MEM_RESP_NOTRDY;
+    end else begin
+        dmem_resp   <= dmem_req ? SCR1_MEM_RESP_RDY_OK : SCR1_MEM_RESP_NOTRDY;
     end
 end
 
@@ -70,102 +349,875 @@ always_comb begin
     endcase
 end
 
- 
-	 reg go_bit;
-	 wire go_bit_in;
-	 reg done_bit;
-	 wire done_bit_in;
-	 reg [15:0] counter;
-	 reg [31:0] data_A;
-	 reg [31:0] data_B;
-	 wire [31:0] data_C;
-	 reg [31:0] result;
-	 reg [7:0] in1, in2;
-	 wire[7:0] out;
-
-	 assign ctr = counter;
-	 
-	 always @(dmem_addr[4:2], data_A, data_B, data_C, counter, done_bit, go_bit, counter) begin
-		case(dmem_addr[4:2])
-		3'b000: dmem_rdata_local = {done_bit, 30'b0, go_bit};
-		3'b001: dmem_rdata_local = {16'b0, counter}; 
-		3'b010: dmem_rdata_local = data_A;
-		3'b011: dmem_rdata_local = data_B;
-		3'b100: dmem_rdata_local = data_C;
-		default: dmem_rdata_local = 32'b0;
-		endcase
-	 end
-	 
-	 assign go_bit_in = (dmem_wr & (dmem_addr[4:2] == 3'b000));
-	
-	 always @(posedge clk or negedge rst_n)
-		if(~rst_n) go_bit <= 1'b0;
-		else go_bit <=  go_bit_in ? 1'b1 : 1'b0;
-		
-	 always @(posedge clk or negedge rst_n)
-		if(~rst_n) begin
-			counter <=16'b0;
-			data_A <= 32'b0;
-			data_B <= 32'b0;
-		end
-		else begin
-			if (dmem_wr) begin
-				data_A <= (dmem_addr[4:2] == 3'b010) ? dmem_writedata : data_A;
-				data_B <= (dmem_addr[4:2] == 3'b011) ? dmem_writedata : data_B;
-			end
-			else begin
-				data_A <= data_A;
-				data_B <= data_B;
-			end
-			counter <= go_bit_in? 16'h00 : done_bit_in ? counter : counter +16'h01;
-		end
-		
-	 		
-	 always @(data_A, counter) begin
-		case(counter)
-		16'b0: 	in1 = data_A[7:0];
-		16'b1:	in1 = data_A[15:8];
-		default: in1 = data_A[7:0];
-		endcase
-	 end
-	
-	  always @(data_B, counter) begin
-		case(counter)
-		32'b0: 	in2 = data_B[7:0];
-		32'b1:	in2 = data_B[15:8];
-		default: in2 = data_B[7:0];
-		endcase
-	 end
-	 
-	 
-	 assign out = in1 * in2; // original
-	 
-	wire [31:0] result_in;
-
-	assign result_in = (counter==16'd0) ? {result[31:8], out} : 
-							(counter==16'd1) ? {result[31:16], out, result[7:0]}:
-							 result; // Thready said we can delete if we don't use word split.
-							 
-	 always @(posedge clk or negedge rst_n)
-		if(~rst_n) result <=32'h0;
-		else result <= result_in;
-	 	 
-	 assign data_C = result; // the note is ours in1*in2;
-	 
-	 assign done_bit_in = (counter == 16'd2);
-	 
-	 always @(posedge clk or negedge rst_n)
-		if(~rst_n) done_bit <= 1'b0;
-		else done_bit <= go_bit_in ? 1'b0 : done_bit_in;
-	 
+always_comb begin
+    ctrl_up     = 1'b0;
+    data_a_up   = 1'b0;
+    data_b_up   = 1'b0;
+    data_c_up   = 1'b0;
+    mode_up     = 1'b0;
+    dma_src_up  = 1'b0;
+    dma_nblk_up = 1'b0;
+    datalen_up  = 1'b0;
+    bitlen0_up  = 1'b0;
+    bitlen1_up  = 1'b0;
+    ring_tail_up    = 1'b0;
+    ring_desc_up    = 1'b0;
+    irq_en_up   = 1'b0;
+    nonce_up    = 1'b0;
+    nonce_cnt_up    = 1'b0;
+    target_up   = 1'b0;
+    state_up    = 1'b0;
+    msg_up      = 1'b0;
+    if (dmem_wr & lane0_sel) begin
+        case (dmem_addr[SCR1_ACCEL_ADDR_WIDTH-1:2])
+            SCR1_ACCEL_CTRL[SCR1_ACCEL_ADDR_WIDTH-1:2]      : ctrl_up   = 1'b1;
+            SCR1_ACCEL_DATA_A[SCR1_ACCEL_ADDR_WIDTH-1:2]    : data_a_up = 1'b1;
+            SCR1_ACCEL_DATA_B[SCR1_ACCEL_ADDR_WIDTH-1:2]    : data_b_up = 1'b1;
+            SCR1_ACCEL_DATA_C[SCR1_ACCEL_ADDR_WIDTH-1:2]    : data_c_up = 1'b1;
+            SCR1_ACCEL_MODE[SCR1_ACCEL_ADDR_WIDTH-1:2]      : mode_up   = 1'b1;
+            SCR1_ACCEL_DMA_SRC[SCR1_ACCEL_ADDR_WIDTH-1:2]   : dma_src_up    = 1'b1;
+            SCR1_ACCEL_DMA_NBLK[SCR1_ACCEL_ADDR_WIDTH-1:2]  : dma_nblk_up   = 1'b1;
+            SCR1_ACCEL_DATALEN[SCR1_ACCEL_ADDR_WIDTH-1:2]   : datalen_up    = 1'b1;
+            SCR1_ACCEL_BITLEN0[SCR1_ACCEL_ADDR_WIDTH-1:2]   : bitlen0_up    = 1'b1;
+            SCR1_ACCEL_BITLEN1[SCR1_ACCEL_ADDR_WIDTH-1:2]   : bitlen1_up    = 1'b1;
+            SCR1_ACCEL_RING_TAIL[SCR1_ACCEL_ADDR_WIDTH-1:2] : ring_tail_up  = 1'b1;
+            SCR1_ACCEL_IRQ_EN[SCR1_ACCEL_ADDR_WIDTH-1:2]    : irq_en_up     = 1'b1;
+            SCR1_ACCEL_NONCE[SCR1_ACCEL_ADDR_WIDTH-1:2]     : nonce_up      = 1'b1;
+            SCR1_ACCEL_NONCE_CNT[SCR1_ACCEL_ADDR_WIDTH-1:2] : nonce_cnt_up  = 1'b1;
+            default                                         : begin
+                state_up    = (dmem_addr[SCR1_ACCEL_ADDR_WIDTH-1:5] == SCR1_ACCEL_STATE[SCR1_ACCEL_ADDR_WIDTH-1:5]);
+                target_up   = (dmem_addr[SCR1_ACCEL_ADDR_WIDTH-1:5] == SCR1_ACCEL_TARGET[SCR1_ACCEL_ADDR_WIDTH-1:5]);
+                msg_up      = (dmem_addr[SCR1_ACCEL_ADDR_WIDTH-1:6] == SCR1_ACCEL_MSG[SCR1_ACCEL_ADDR_WIDTH-1:6]);
+                ring_desc_up    = (dmem_addr[SCR1_ACCEL_ADDR_WIDTH-1:6] == SCR1_ACCEL_RING[SCR1_ACCEL_ADDR_WIDTH-1:6]);
+            end
+        endcase
+    end
+end
+
+// Lane k is decoded from the address bits above the lane window
+assign lane0_sel = (dmem_addr[15:SCR1_ACCEL_ADDR_WIDTH] == '0);
+assign info_sel  = (dmem_addr[15:SCR1_ACCEL_ADDR_WIDTH] == SCR1_ACCEL_INFO_WINDOW);
+
+assign info_id   = {SCR1_ACCEL_ID_MAGIC, SCR1_ACCEL_VERSION_MAJOR, SCR1_ACCEL_VERSION_MINOR};
+
+always_comb begin
+    info_caps                                       = '0;
+    info_caps[SCR1_ACCEL_CAPS_LANES_OFFSET+:6]      = 6'(SCR1_ACCEL_SHA256_LANES);
+    info_caps[SCR1_ACCEL_CAPS_RPC_OFFSET+:4]        = 4'(SCR1_ACCEL_SHA256_RPC);
+    info_caps[SCR1_ACCEL_CAPS_MUL_OFFSET]           = 1'b1;
+    info_caps[SCR1_ACCEL_CAPS_MAC_OFFSET]           = 1'b1;
+    info_caps[SCR1_ACCEL_CAPS_DMA_OFFSET]           = SCR1_ACCEL_TCM_EN;
+    info_caps[SCR1_ACCEL_CAPS_RING_OFFSET]          = SCR1_ACCEL_TCM_EN;
+    info_caps[SCR1_ACCEL_CAPS_HMAC_OFFSET]          = 1'b1;
+    info_caps[SCR1_ACCEL_CAPS_SEARCH_OFFSET]        = 1'b1;
+end
+
+always_comb begin
+    dmem_rdata_local = '0;
+    if (info_sel) begin
+        case (dmem_addr[SCR1_ACCEL_ADDR_WIDTH-1:2])
+            SCR1_ACCEL_ID[SCR1_ACCEL_ADDR_WIDTH-1:2]    : dmem_rdata_local = info_id;
+            SCR1_ACCEL_CAPS[SCR1_ACCEL_ADDR_WIDTH-1:2]  : dmem_rdata_local = info_caps;
+            default                                     : begin end
+        endcase
+    end else if (~lane0_sel) begin
+        if (dmem_addr[15:SCR1_ACCEL_ADDR_WIDTH] < SCR1_ACCEL_SHA256_LANES) begin
+            dmem_rdata_local = lane_rdata[dmem_addr[15:SCR1_ACCEL_ADDR_WIDTH]];
+        end
+    end else case (dmem_addr[SCR1_ACCEL_ADDR_WIDTH-1:2])
+        SCR1_ACCEL_CTRL[SCR1_ACCEL_ADDR_WIDTH-1:2]      : begin
+            dmem_rdata_local[SCR1_ACCEL_CTRL_GO_OFFSET]     = go_bit;
+            dmem_rdata_local[SCR1_ACCEL_CTRL_BUSY_OFFSET]   = busy;
+            dmem_rdata_local[SCR1_ACCEL_CTRL_PEND_OFFSET]   = go_pend | key_first | search_active;
+            dmem_rdata_local[SCR1_ACCEL_CTRL_FOUND_OFFSET]  = search_found;
+            dmem_rdata_local[SCR1_ACCEL_CTRL_ERR_OFFSET]    = dma_err;
+            dmem_rdata_local[SCR1_ACCEL_CTRL_DONE_OFFSET]   = done_bit;
+        end
+        SCR1_ACCEL_COUNTER[SCR1_ACCEL_ADDR_WIDTH-1:2]   : dmem_rdata_local = counter;
+        SCR1_ACCEL_DATA_A[SCR1_ACCEL_ADDR_WIDTH-1:2]    : dmem_rdata_local = data_A;
+        SCR1_ACCEL_DATA_B[SCR1_ACCEL_ADDR_WIDTH-1:2]    : dmem_rdata_local = data_B;
+        SCR1_ACCEL_DATA_C[SCR1_ACCEL_ADDR_WIDTH-1:2]    : dmem_rdata_local = (mode == SCR1_ACCEL_MODE_MAC) ? mac_acc : data_C;
+        SCR1_ACCEL_MODE[SCR1_ACCEL_ADDR_WIDTH-1:2]      : dmem_rdata_local = `SCR1_DMEM_DWIDTH'(mode);
+        SCR1_ACCEL_DMA_SRC[SCR1_ACCEL_ADDR_WIDTH-1:2]   : dmem_rdata_local = dma_src;
+        SCR1_ACCEL_DMA_NBLK[SCR1_ACCEL_ADDR_WIDTH-1:2]  : dmem_rdata_local = dma_nblk;
+        SCR1_ACCEL_DATALEN[SCR1_ACCEL_ADDR_WIDTH-1:2]   : dmem_rdata_local = `SCR1_DMEM_DWIDTH'(datalen);
+        SCR1_ACCEL_BITLEN0[SCR1_ACCEL_ADDR_WIDTH-1:2]   : dmem_rdata_local = bitlen[31:0];
+        SCR1_ACCEL_BITLEN1[SCR1_ACCEL_ADDR_WIDTH-1:2]   : dmem_rdata_local = bitlen[63:32];
+        SCR1_ACCEL_RING_HEAD[SCR1_ACCEL_ADDR_WIDTH-1:2] : dmem_rdata_local = `SCR1_DMEM_DWIDTH'(ring_head);
+        SCR1_ACCEL_RING_TAIL[SCR1_ACCEL_ADDR_WIDTH-1:2] : dmem_rdata_local = `SCR1_DMEM_DWIDTH'(ring_tail);
+        SCR1_ACCEL_IRQ_EN[SCR1_ACCEL_ADDR_WIDTH-1:2]    : dmem_rdata_local = `SCR1_DMEM_DWIDTH'(irq_en);
+        SCR1_ACCEL_NONCE[SCR1_ACCEL_ADDR_WIDTH-1:2]     : dmem_rdata_local = nonce;
+        SCR1_ACCEL_NONCE_CNT[SCR1_ACCEL_ADDR_WIDTH-1:2] : dmem_rdata_local = nonce_cnt;
+        default                                         : begin
+            if (dmem_addr[SCR1_ACCEL_ADDR_WIDTH-1:5] == SCR1_ACCEL_STATE[SCR1_ACCEL_ADDR_WIDTH-1:5]) begin
+                dmem_rdata_local = sha_state[dmem_addr[4:2]];
+            end else if (dmem_addr[SCR1_ACCEL_ADDR_WIDTH-1:5] == SCR1_ACCEL_TARGET[SCR1_ACCEL_ADDR_WIDTH-1:5]) begin
+                dmem_rdata_local = target[dmem_addr[4:2]];
+            end else if (dmem_addr[SCR1_ACCEL_ADDR_WIDTH-1:6] == SCR1_ACCEL_MSG[SCR1_ACCEL_ADDR_WIDTH-1:6]) begin
+                dmem_rdata_local = msg_buf[dmem_addr[5:2]];
+            end else if (dmem_addr[SCR1_ACCEL_ADDR_WIDTH-1:6] == SCR1_ACCEL_RING[SCR1_ACCEL_ADDR_WIDTH-1:6]) begin
+                case (dmem_addr[3:2])
+                    2'd0    : dmem_rdata_local = ring_addr[dmem_addr[SCR1_ACCEL_RING_IDX_WIDTH+3:4]];
+                    2'd1    : dmem_rdata_local = ring_len[dmem_addr[SCR1_ACCEL_RING_IDX_WIDTH+3:4]];
+                    2'd2    : dmem_rdata_local = ring_dst[dmem_addr[SCR1_ACCEL_RING_IDX_WIDTH+3:4]];
+                    default : begin end
+                endcase
+            end
+        end
+    endcase
+end
+
+//-------------------------------------------------------------------------------
+// Control and status
+//-------------------------------------------------------------------------------
+// The CTRL command is taken from the bus when idle, or from the queue when the
+// operation it was queued behind completes
+assign cmd_up       = ~busy & (go_pend | ctrl_up);
+assign cmd          = go_pend ? go_pend_cmd : dmem_writedata[6:0];
+assign go_bit_in    = cmd_up & cmd[SCR1_ACCEL_CTRL_GO_OFFSET];
+assign go_queue     = ctrl_up & dmem_writedata[SCR1_ACCEL_CTRL_GO_OFFSET] & busy & ~go_pend
+                    & (mode == SCR1_ACCEL_MODE_SHA256) & ~dmem_writedata[SCR1_ACCEL_CTRL_DMA_OFFSET];
+assign done_ack     = ctrl_up & dmem_writedata[SCR1_ACCEL_CTRL_ACK_OFFSET];
+assign done_bit_in  = (mode == SCR1_ACCEL_MODE_SHA256)
+                    ? ((sha_done & ~fin_second & ~dma_active & ~key_first & ~hmac_outer_start & ~search_active)
+                    |  search_end
+                    |  (dma_block_done & dma_last & ~dma_final)
+                    |  (dma_err_in & ~ring_active)
+                    |  (dma_start & (dma_nblk == '0))
+                    |  ring_drained)
+                    : (mode == SCR1_ACCEL_MODE_MAC)
+                    ? ((go_bit_in & ~cmd[SCR1_ACCEL_CTRL_DMA_OFFSET])
+                    |  (mac_dma_start & ((dma_nblk == '0) | mac_dma_over))
+                    |  (mac_recv & (mac_recv_cnt == mac_len - 1'b1))
+                    |  mac_err_in)
+                    : (mul_busy & mul_lane);
+assign busy         = mul_busy | sha_busy | dma_active | fin_second | key_first | hmac_outer_start
+                    | search_active | mac_fetch;
+
+always_ff @(posedge clk, negedge rst_n) begin
+    if (~rst_n) begin
+        go_bit  <= 1'b0;
+    end else begin
+        go_bit  <= go_bit_in;
+    end
+end
+
+always_ff @(posedge clk, negedge rst_n) begin
+    if (~rst_n) begin
+        go_pend     <= 1'b0;
+        go_pend_cmd <= '0;
+    end else begin
+        if (go_queue) begin
+            go_pend     <= 1'b1;
+            go_pend_cmd <= dmem_writedata[6:0];
+        end else if (~busy) begin
+            go_pend     <= 1'b0;
+        end
+    end
+end
+
+always_ff @(posedge clk, negedge rst_n) begin
+    if (~rst_n) begin
+        done_bit    <= 1'b0;
+    end else begin
+        // A completion in the same cycle as the clear is not lost, unless it is the
+        // completion of the operation a queued GO was waiting for
+        done_bit    <= ((go_bit_in | ring_tail_up | done_ack) ? 1'b0 : done_bit) | (done_bit_in & ~go_pend);
+    end
+end
+
+always_ff @(posedge clk, negedge rst_n) begin
+    if (~rst_n) begin
+        irq_en  <= 1'b0;
+    end else begin
+        if (irq_en_up) begin
+            irq_en  <= dmem_writedata[SCR1_ACCEL_SHA256_LANES-1:0];
+        end
+    end
+end
+
+assign lane_done[0] = done_bit;
+assign irq          = |(lane_done & irq_en);
+
+always_ff @(posedge clk, negedge rst_n) begin
+    if (~rst_n) begin
+        counter <= '0;
+    end else begin
+        if ((go_bit_in & ~go_pend) | (ring_tail_up & ~busy)) begin
+            counter <= '0;
+        end else if (busy) begin
+            counter <= counter + 1'b1;
+        end
+    end
+end
+
+always_ff @(posedge clk, negedge rst_n) begin
+    if (~rst_n) begin
+        mode    <= SCR1_ACCEL_MODE_MUL;
+    end else begin
+        if (mode_up & ~busy) begin
+            mode    <= dmem_writedata[1:0];
+        end
+    end
+end
+
+//-------------------------------------------------------------------------------
+// 8-bit multiplier (MODE_MUL): two byte lanes of DATA_A/DATA_B, one lane per cycle
+//-------------------------------------------------------------------------------
+always_ff @(posedge clk, negedge rst_n) begin
+    if (~rst_n) begin
+        data_A  <= 32'b0;
+        data_B  <= 32'b0;
+    end else begin
+        if (data_a_up) begin
+            data_A  <= dmem_writedata;
+        end
+        if (data_b_up) begin
+            data_B  <= dmem_writedata;
+        end
+    end
+end
+
+always_ff @(posedge clk, negedge rst_n) begin
+    if (~rst_n) begin
+        mul_busy    <= 1'b0;
+        mul_lane    <= 1'b0;
+    end else begin
+        if (go_bit_in & (mode == SCR1_ACCEL_MODE_MUL)) begin
+            mul_busy    <= 1'b1;
+            mul_lane    <= 1'b0;
+        end else if (mul_busy) begin
+            mul_busy    <= ~mul_lane;
+            mul_lane    <= 1'b1;
+        end
+    end
+end
+
+assign in1 = mul_lane ? data_A[15:8] : data_A[7:0];
+assign in2 = mul_lane ? data_B[15:8] : data_B[7:0];
+assign out = in1 * in2;
+
+always_ff @(posedge clk, negedge rst_n) begin
+    if (~rst_n) begin
+        data_C  <= 32'h0;
+    end else begin
+        if (mul_busy) begin
+            if (mul_lane) begin
+                data_C[15:8]    <= out;
+            end else begin
+                data_C[7:0]     <= out;
+            end
+        end
+    end
+end
+
+//-------------------------------------------------------------------------------
+// Int8 dot product (MODE_MAC): four signed byte products summed per cycle, from
+// DATA_A/DATA_B or from a TCM word against the matching MSG word
+//-------------------------------------------------------------------------------
+assign mac_clear        = cmd_up & (mode == SCR1_ACCEL_MODE_MAC) & cmd[SCR1_ACCEL_CTRL_INIT_OFFSET];
+assign mac_dma_start    = go_bit_in & (mode == SCR1_ACCEL_MODE_MAC) & cmd[SCR1_ACCEL_CTRL_DMA_OFFSET];
+// MSG holds 16 words, so a longer row is refused rather than cut short
+assign mac_dma_over     = mac_dma_start & (dma_nblk > 32'd16);
+assign mac_recv         = mac_fetch & (dma_resp == SCR1_MEM_RESP_RDY_OK);
+assign mac_err_in       = mac_fetch & (dma_resp == SCR1_MEM_RESP_RDY_ER);
+assign mac_step         = (go_bit_in & (mode == SCR1_ACCEL_MODE_MAC) & ~cmd[SCR1_ACCEL_CTRL_DMA_OFFSET]) | mac_recv;
+
+assign mac_a    = mac_fetch ? dma_rdata : data_A;
+assign mac_b    = mac_fetch ? msg_buf[mac_recv_cnt[3:0]] : data_B;
+
+always_comb begin
+    mac_dot = '0;
+    for (int i = 0; i < 4; i++) begin
+        mac_dot = mac_dot + 18'($signed(mac_a[8*i +: 8]) * $signed(mac_b[8*i +: 8]));
+    end
+end
+
+assign mac_sum  = (mac_clear ? 33'sd0 : 33'($signed(mac_acc))) + 33'(mac_dot);
+
+always_ff @(posedge clk, negedge rst_n) begin
+    if (~rst_n) begin
+        mac_acc <= '0;
+    end else begin
+        if (mac_step) begin
+            // Saturate on int32 overflow (the two top bits of the 33-bit sum differ)
+            case (mac_sum[32:31])
+                2'b01   : mac_acc <= 32'h7fffffff;
+                2'b10   : mac_acc <= 32'h80000000;
+                default : mac_acc <= mac_sum[31:0];
+            endcase
+        end else if (mac_clear) begin
+            mac_acc <= '0;
+        end else if (data_c_up & ~busy) begin
+            mac_acc <= dmem_writedata;
+        end
+    end
+end
+
+always_ff @(posedge clk, negedge rst_n) begin
+    if (~rst_n) begin
+        mac_fetch       <= 1'b0;
+        mac_len         <= '0;
+        mac_addr        <= '0;
+        mac_issue_cnt   <= '0;
+        mac_recv_cnt    <= '0;
+    end else begin
+        if (mac_dma_start) begin
+            mac_fetch       <= (dma_nblk != '0) & ~mac_dma_over;
+            mac_len         <= dma_nblk[4:0];
+            mac_addr        <= dma_src;
+            mac_issue_cnt   <= '0;
+            mac_recv_cnt    <= '0;
+        end else if (mac_err_in | (mac_recv & (mac_recv_cnt == mac_len - 1'b1))) begin
+            mac_fetch       <= 1'b0;
+        end else if (mac_fetch) begin
+            if (dma_req & dma_req_ack) begin
+                mac_addr        <= mac_addr + `SCR1_DMEM_AWIDTH'd4;
+                mac_issue_cnt   <= mac_issue_cnt + 1'b1;
+            end
+            if (mac_recv) begin
+                mac_recv_cnt    <= mac_recv_cnt + 1'b1;
+            end
+        end
+    end
+end
+
+//-------------------------------------------------------------------------------
+// SHA-256 compression engine (MODE_SHA256)
+//-------------------------------------------------------------------------------
+assign sha_start    = (go_bit_in & (mode == SCR1_ACCEL_MODE_SHA256) & ~cmd[SCR1_ACCEL_CTRL_DMA_OFFSET])
+                    | (dma_fetch_done & (dma_blocks_left != '0))
+                    | dma_tail_go
+                    | (sha_done & fin_second)
+                    | key_next
+                    | hmac_outer_start
+                    | search_next
+                    | search_inner_done;
+assign sha_init     = (cmd_up & (mode == SCR1_ACCEL_MODE_SHA256) & cmd[SCR1_ACCEL_CTRL_INIT_OFFSET]
+                       & ~cmd[SCR1_ACCEL_CTRL_HMAC_OFFSET] & ~cmd[SCR1_ACCEL_CTRL_SEARCH_OFFSET])
+                    | ring_start | key_start | key_next | search_inner_done;
+// A compressed message block, accounted in BITLEN
+assign sha_blk_done = sha_done & ~fin_active & ~key_first & ~key_second & ~hmac_outer & ~search_active;
+
+// The bus writes the message buffer, which is copied into the compression window
+// when a PIO operation starts; the DMA writes the window directly
+always_ff @(posedge clk, negedge rst_n) begin
+    if (~rst_n) begin
+        msg_buf <= '0;
+    end else begin
+        if (msg_up) begin
+            msg_buf[dmem_addr[5:2]] <= dmem_writedata;
+        end
+    end
+end
+
+assign sha_msg_we       = dma_recv;
+assign sha_msg_idx      = dma_recv_cnt;
+assign sha_msg_wdata    = {dma_rdata[7:0], dma_rdata[15:8], dma_rdata[23:16], dma_rdata[31:24]};
+assign sha_msg_load         = (go_bit_in & (mode == SCR1_ACCEL_MODE_SHA256) & ~cmd[SCR1_ACCEL_CTRL_DMA_OFFSET])
+                            | fin_start | (sha_done & fin_second) | key_next | hmac_outer_start
+                            | search_next | search_inner_done;
+always_comb begin
+    if (search_start | search_next) begin
+        sha_msg_load_data   = search_window;
+    end else if (search_inner_done) begin
+        sha_msg_load_data   = search_hash;
+    end else if (key_start) begin
+        sha_msg_load_data   = msg_buf ^ SCR1_ACCEL_HMAC_IPAD;
+    end else if (key_next) begin
+        sha_msg_load_data   = msg_buf ^ SCR1_ACCEL_HMAC_OPAD;
+    end else if (hmac_outer_start) begin
+        sha_msg_load_data   = hmac_window;
+    end else if (fin_start | fin_second) begin
+        sha_msg_load_data   = fin_window;
+    end else begin
+        sha_msg_load_data   = msg_buf;
+    end
+end
+assign sha_state_load       = hmac_start | hmac_outer_start | search_next;
+always_comb begin
+    if (search_next) begin
+        sha_state_load_data = search_mid;
+    end else if (hmac_outer_start) begin
+        sha_state_load_data = hmac_ostate;
+    end else begin
+        sha_state_load_data = hmac_istate;
+    end
+end
+
+scr1_accel_sha256 #(
+    .SCR1_SHA256_RPC    (SCR1_ACCEL_SHA256_RPC)
+) i_sha256 (
+    .clk            (clk                ),
+    .rst_n          (rst_n              ),
 
+    .start          (sha_start          ),
+    .init           (sha_init           ),
+    .busy           (sha_busy           ),
+    .done           (sha_done           ),
+
+    .state_we       (state_up & ~busy   ),
+    .state_idx      (dmem_addr[4:2]     ),
+    .state_wdata    (dmem_writedata     ),
+    .state_load     (sha_state_load     ),
+    .state_load_data(sha_state_load_data),
+    .state          (sha_state          ),
+
+    .msg_we         (sha_msg_we         ),
+    .msg_idx        (sha_msg_idx        ),
+    .msg_wdata      (sha_msg_wdata      ),
+    .msg_load       (sha_msg_load       ),
+    .msg_load_data  (sha_msg_load_data  ),
+    .msg            (sha_msg            )
+);
+
+//-------------------------------------------------------------------------------
+// DMA sequencer (MODE_SHA256)
+//-------------------------------------------------------------------------------
+// CTRL.DMA: DMA_NBLK blocks are fetched from the TCM one at a time into the
+// message window (little-endian memory words are byte-swapped to the big-endian
+// message words) and compressed back-to-back into STATE.
+// Ring descriptor: the state is initialized, the whole blocks of the message are
+// hashed as above, the trailing bytes are fetched and finalized (CTRL.FINAL) and
+// the digest is written back to the destination in byte order. Only the words
+// holding trailing bytes are fetched, none when the length is a multiple of 64,
+// so a message that ends at the top of the TCM is never read past its end.
+assign dma_start        = go_bit_in & (mode == SCR1_ACCEL_MODE_SHA256) & cmd[SCR1_ACCEL_CTRL_DMA_OFFSET];
+assign dma_resp_ok      = (dma_fetch | dma_store) & (dma_resp == SCR1_MEM_RESP_RDY_OK);
+assign dma_recv         = dma_fetch & dma_resp_ok;
+assign dma_err_in       = (dma_fetch | dma_store) & (dma_resp == SCR1_MEM_RESP_RDY_ER);
+assign dma_fetch_words  = (dma_final & (dma_blocks_left == '0)) ? 5'((7'(datalen) + 7'd3) >> 2) : 5'd16;
+assign dma_fetch_done   = dma_recv & ({1'b0, dma_recv_cnt} == dma_fetch_words - 5'd1);
+assign dma_store_done   = dma_store & dma_resp_ok & (dma_recv_cnt == 4'd7);
+assign dma_block_done   = dma_active & sha_done & ~fin_active;
+assign dma_last         = (dma_blocks_left == 32'd1);
+
+assign dma_req          = mac_fetch ? (mac_issue_cnt < mac_len)
+                        : dma_fetch ? (dma_issue_cnt < dma_fetch_words) : (dma_store & ~dma_issue_cnt[3]);
+assign dma_cmd          = dma_store ? SCR1_MEM_CMD_WR : SCR1_MEM_CMD_RD;
+assign dma_addr         = mac_fetch ? mac_addr : dma_addr_reg;
+assign dma_wdata        = {sha_state[dma_issue_cnt[2:0]][7:0],   sha_state[dma_issue_cnt[2:0]][15:8],
+                           sha_state[dma_issue_cnt[2:0]][23:16], sha_state[dma_issue_cnt[2:0]][31:24]};
+
+always_ff @(posedge clk, negedge rst_n) begin
+    if (~rst_n) begin
+        dma_src     <= '0;
+        dma_nblk    <= '0;
+    end else begin
+        if (dma_src_up & ~busy) begin
+            dma_src     <= {dmem_writedata[31:2], 2'b00};
+        end
+        if (dma_nblk_up & ~busy) begin
+            dma_nblk    <= dmem_writedata;
+        end
+    end
+end
+
+always_ff @(posedge clk, negedge rst_n) begin
+    if (~rst_n) begin
+        dma_active      <= 1'b0;
+        dma_fetch       <= 1'b0;
+        dma_store       <= 1'b0;
+        dma_final       <= 1'b0;
+        dma_blocks_left <= '0;
+    end else begin
+        if (dma_start) begin
+            dma_active      <= (dma_nblk != '0);
+            dma_fetch       <= (dma_nblk != '0);
+            dma_final       <= 1'b0;
+            dma_blocks_left <= dma_nblk;
+        end else if (ring_start) begin
+            dma_active      <= 1'b1;
+            dma_fetch       <= (ring_len[ring_head_idx] != '0);
+            dma_final       <= 1'b1;
+            dma_blocks_left <= 32'(ring_len[ring_head_idx][31:6]);
+        end else if (dma_err_in) begin
+            dma_active      <= 1'b0;
+            dma_fetch       <= 1'b0;
+            dma_store       <= 1'b0;
+            dma_final       <= 1'b0;
+        end else if (dma_fetch_done) begin
+            dma_fetch       <= 1'b0;
+        end else if (dma_block_done) begin
+            // The trailing bytes are fetched after the last whole block
+            dma_active      <= ~dma_last | dma_final;
+            dma_fetch       <= ~dma_last | (dma_final & (datalen != '0));
+            dma_blocks_left <= dma_blocks_left - 1'b1;
+        end else if (dma_active & sha_done & fin_active & ~fin_second) begin
+            dma_store       <= 1'b1;
+            dma_final       <= 1'b0;
+        end else if (dma_store_done) begin
+            dma_active      <= 1'b0;
+            dma_store       <= 1'b0;
+        end
+    end
+end
+
+// The window is finalized the cycle after the trailing bytes are in, or right
+// after the last whole block when there are none
+assign dma_tail_skip    = (ring_start & (ring_len[ring_head_idx] == '0))
+                        | (dma_block_done & dma_last & dma_final & (datalen == '0));
+
+always_ff @(posedge clk, negedge rst_n) begin
+    if (~rst_n) begin
+        dma_tail_go <= 1'b0;
+    end else begin
+        dma_tail_go <= (dma_fetch_done & (dma_blocks_left == '0)) | dma_tail_skip;
+    end
+end
+
+always_ff @(posedge clk, negedge rst_n) begin
+    if (~rst_n) begin
+        dma_addr_reg    <= '0;
+        dma_issue_cnt   <= '0;
+        dma_recv_cnt    <= '0;
+    end else begin
+        if (dma_start) begin
+            dma_addr_reg    <= dma_src;
+        end else if (ring_start) begin
+            dma_addr_reg    <= {ring_addr[ring_head_idx][31:2], 2'b00};
+        end else if (dma_active & sha_done & fin_active & ~fin_second) begin
+            dma_addr_reg    <= {ring_dst[ring_head_idx][31:2], 2'b00};
+        end else if (dma_req & dma_req_ack) begin
+            dma_addr_reg    <= dma_addr_reg + `SCR1_DMEM_AWIDTH'd4;
+        end
+
+        if (~dma_fetch & ~dma_store) begin
+            dma_issue_cnt   <= '0;
+            dma_recv_cnt    <= '0;
+        end else begin
+            if (dma_req & dma_req_ack) begin
+                dma_issue_cnt   <= dma_issue_cnt + 1'b1;
+            end
+            if (dma_resp_ok) begin
+                dma_recv_cnt    <= dma_recv_cnt + 1'b1;
+            end
+        end
+    end
+end
+
+always_ff @(posedge clk, negedge rst_n) begin
+    if (~rst_n) begin
+        dma_err <= 1'b0;
+    end else begin
+        dma_err <= ((go_bit_in | done_ack) ? 1'b0 : dma_err) | dma_err_in | mac_err_in | mac_dma_over;
+    end
+end
+
+//-------------------------------------------------------------------------------
+// Descriptor ring (MODE_SHA256): entries RING_HEAD..RING_TAIL-1 are hashed in
+// order whenever the accelerator is idle; a descriptor that fails on the bus
+// is skipped with CTRL.ERR set. RING_TAIL writes leave ERR alone, so firmware
+// appending descriptors does not lose the error of one already finished
+//-------------------------------------------------------------------------------
+assign ring_head_idx    = ring_head[SCR1_ACCEL_RING_IDX_WIDTH-1:0];
+assign ring_tail_next   = ring_tail_up ? dmem_writedata[SCR1_ACCEL_RING_IDX_WIDTH:0] : ring_tail;
+assign ring_start       = (mode == SCR1_ACCEL_MODE_SHA256) & ~busy & ~go_bit_in & (ring_head != ring_tail);
+assign ring_done_in     = ring_active & (dma_store_done | dma_err_in);
+assign ring_drained     = ring_done_in & ((ring_head + 1'b1) == ring_tail_next);
+
+always_ff @(posedge clk, negedge rst_n) begin
+    if (~rst_n) begin
+        ring_active <= 1'b0;
+        ring_head   <= '0;
+        ring_tail   <= '0;
+    end else begin
+        if (ring_start) begin
+            ring_active <= 1'b1;
+        end else if (ring_done_in) begin
+            ring_active <= 1'b0;
+            ring_head   <= ring_head + 1'b1;
+        end
+        ring_tail   <= ring_tail_next;
+    end
+end
+
+always_ff @(posedge clk, negedge rst_n) begin
+    if (~rst_n) begin
+        ring_addr   <= '0;
+        ring_len    <= '0;
+        ring_dst    <= '0;
+    end else begin
+        if (ring_desc_up) begin
+            case (dmem_addr[3:2])
+                2'd0    : ring_addr[dmem_addr[SCR1_ACCEL_RING_IDX_WIDTH+3:4]]   <= dmem_writedata;
+                2'd1    : ring_len[dmem_addr[SCR1_ACCEL_RING_IDX_WIDTH+3:4]]    <= dmem_writedata;
+                2'd2    : ring_dst[dmem_addr[SCR1_ACCEL_RING_IDX_WIDTH+3:4]]    <= dmem_writedata;
+                default : begin end
+            endcase
+        end
+    end
+end
+
+//-------------------------------------------------------------------------------
+// Finalization (MODE_SHA256, CTRL.FINAL): the DATALEN bytes left in the window are
+// padded and the message length is appended; with DATALEN >= 56 the length does
+// not fit and goes into a second, otherwise empty block
+//-------------------------------------------------------------------------------
+assign fin_start    = (go_bit_in & (mode == SCR1_ACCEL_MODE_SHA256) & cmd[SCR1_ACCEL_CTRL_FINAL_OFFSET]
+                       & ~cmd[SCR1_ACCEL_CTRL_DMA_OFFSET] & ~cmd[SCR1_ACCEL_CTRL_KEY_OFFSET]
+                       & ~cmd[SCR1_ACCEL_CTRL_SEARCH_OFFSET])
+                    | dma_tail_go;
+// A FINAL queued behind a block starts in the cycle that block is accounted for.
+// The length is latched when the FINAL starts: the second block takes it from
+// fin_len_hold, so DATALEN may already hold the length of the next queued FINAL
+assign fin_len      = (sha_init ? 64'd0 : hmac_start ? 64'd512 : bitlen_cur) + {55'd0, datalen, 3'd0};
+assign bitlen_cur   = sha_blk_done ? (bitlen + 64'd512) : bitlen;
+
+always_comb begin
+    if (fin_second) begin
+        fin_window  = '0;
+    end else begin
+        fin_window  = scr1_accel_sha256_pad(dma_active ? sha_msg : msg_buf, datalen);
+    end
+    if (fin_second) begin
+        fin_window[14]  = fin_len_hold[63:32];
+        fin_window[15]  = fin_len_hold[31:0];
+    end else if (datalen < 6'd56) begin
+        fin_window[14]  = fin_len[63:32];
+        fin_window[15]  = fin_len[31:0];
+    end
+end
+
+always_ff @(posedge clk, negedge rst_n) begin
+    if (~rst_n) begin
+        datalen <= '0;
+        bitlen  <= '0;
+    end else begin
+        // DATALEN may be written for a FINAL queued behind any PIO operation, a FINAL included
+        if (ring_start) begin
+            datalen <= ring_len[ring_head_idx][5:0];
+        end else if (datalen_up & ~dma_active) begin
+            datalen <= dmem_writedata[5:0];
+        end
+        if (sha_init) begin
+            bitlen  <= '0;
+        end else if (hmac_start) begin
+            bitlen  <= 64'd512;
+        end else if (~busy & (bitlen0_up | bitlen1_up)) begin
+            if (bitlen0_up) begin
+                bitlen[31:0]    <= dmem_writedata;
+            end
+            if (bitlen1_up) begin
+                bitlen[63:32]   <= dmem_writedata;
+            end
+        end else if (sha_blk_done) begin
+            bitlen  <= bitlen + 64'd512;
+        end
+    end
+end
+
+always_ff @(posedge clk, negedge rst_n) begin
+    if (~rst_n) begin
+        fin_active      <= 1'b0;
+        fin_second      <= 1'b0;
+        fin_len_hold    <= '0;
+    end else begin
+        if (fin_start) begin
+            fin_active      <= 1'b1;
+            fin_second      <= (datalen >= 6'd56);
+            fin_len_hold    <= fin_len;
+        end else if (sha_done & fin_active) begin
+            fin_active      <= fin_second;
+            fin_second      <= 1'b0;
+        end
+    end
+end
+
+//-------------------------------------------------------------------------------
+// HMAC-SHA256 (MODE_SHA256, CTRL.KEY and CTRL.HMAC)
+//-------------------------------------------------------------------------------
+// KEY: two compressions from the IV, (key ^ ipad) then (key ^ opad), both read from
+// MSG, which therefore stays in use (CTRL.PEND) until the second one starts
+assign key_start        = go_bit_in & (mode == SCR1_ACCEL_MODE_SHA256) & cmd[SCR1_ACCEL_CTRL_KEY_OFFSET]
+                        & ~cmd[SCR1_ACCEL_CTRL_DMA_OFFSET] & ~cmd[SCR1_ACCEL_CTRL_SEARCH_OFFSET];
+assign key_next         = sha_done & key_first;
+assign hmac_start       = cmd_up & (mode == SCR1_ACCEL_MODE_SHA256) & cmd[SCR1_ACCEL_CTRL_HMAC_OFFSET]
+                        & ~cmd[SCR1_ACCEL_CTRL_KEY_OFFSET] & ~cmd[SCR1_ACCEL_CTRL_SEARCH_OFFSET];
+// The outer block follows the last block of a FINAL started in an HMAC message
+assign hmac_outer_start = sha_done & fin_active & ~fin_second & hmac_active & ~hmac_outer;
+
+always_comb begin
+    hmac_window         = '0;
+    hmac_window[7:0]    = sha_state;
+    hmac_window[8]      = 32'h80000000;
+    hmac_window[15]     = 32'd768;
+end
+
+always_ff @(posedge clk, negedge rst_n) begin
+    if (~rst_n) begin
+        key_first   <= 1'b0;
+        key_second  <= 1'b0;
+        hmac_istate <= '0;
+        hmac_ostate <= '0;
+    end else begin
+        if (key_start) begin
+            key_first   <= 1'b1;
+        end else if (key_next) begin
+            key_first   <= 1'b0;
+            key_second  <= 1'b1;
+            hmac_istate <= sha_state;
+        end else if (sha_done & key_second) begin
+            key_second  <= 1'b0;
+            hmac_ostate <= sha_state;
+        end
+    end
+end
+
+always_ff @(posedge clk, negedge rst_n) begin
+    if (~rst_n) begin
+        hmac_active <= 1'b0;
+        hmac_outer  <= 1'b0;
+    end else begin
+        if (hmac_start) begin
+            hmac_active <= 1'b1;
+        end else if (sha_init) begin
+            hmac_active <= 1'b0;
+        end else if (hmac_outer_start) begin
+            hmac_outer  <= 1'b1;
+        end else if (sha_done & hmac_outer) begin
+            hmac_active <= 1'b0;
+            hmac_outer  <= 1'b0;
+        end
+    end
+end
+
+//-------------------------------------------------------------------------------
+// Nonce search (MODE_SHA256, CTRL.SEARCH)
+//-------------------------------------------------------------------------------
+// Every attempt compresses the header tail from the saved midstate (inner), then
+// its digest from the IV (outer); the next attempt starts as the outer one ends
+assign search_start         = go_bit_in & (mode == SCR1_ACCEL_MODE_SHA256) & cmd[SCR1_ACCEL_CTRL_SEARCH_OFFSET]
+                            & ~cmd[SCR1_ACCEL_CTRL_DMA_OFFSET];
+assign search_inner_done    = sha_done & search_active & ~search_outer;
+assign search_outer_done    = sha_done & search_active & search_outer;
+assign search_end           = search_outer_done & (search_hit | (nonce_cnt == 32'd1));
+assign search_next          = search_outer_done & ~search_end;
+assign search_nonce         = search_start ? nonce : (nonce + 1'b1);
+
+// The nonce is stored little-endian in the header, so it is byte-swapped into W3
+always_comb begin
+    search_window       = '0;
+    search_window[2:0]  = msg_buf[2:0];
+    search_window[3]    = {search_nonce[7:0], search_nonce[15:8], search_nonce[23:16], search_nonce[31:24]};
+    search_window[4]    = 32'h80000000;
+    search_window[15]   = 32'd640;
+end
+
+always_comb begin
+    search_hash         = '0;
+    search_hash[7:0]    = sha_state;
+    search_hash[8]      = 32'h80000000;
+    search_hash[15]     = 32'd256;
+end
+
+// The hash bytes read as a little-endian number: word k is the byte-swapped H[k]
+always_comb begin
+    search_hit = 1'b1;
+    for (int i = 0; i < 8; i++) begin
+        if ({sha_state[i][7:0], sha_state[i][15:8], sha_state[i][23:16], sha_state[i][31:24]} != target[i]) begin
+            search_hit = ({sha_state[i][7:0], sha_state[i][15:8], sha_state[i][23:16], sha_state[i][31:24]} < target[i]);
+        end
+    end
+end
+
+always_ff @(posedge clk, negedge rst_n) begin
+    if (~rst_n) begin
+        target  <= '0;
+    end else begin
+        if (target_up & ~busy) begin
+            target[dmem_addr[4:2]]  <= dmem_writedata;
+        end
+    end
+end
+
+always_ff @(posedge clk, negedge rst_n) begin
+    if (~rst_n) begin
+        nonce       <= '0;
+        nonce_cnt   <= '0;
+    end else begin
+        if (~busy & nonce_up) begin
+            nonce       <= dmem_writedata;
+        end else if (search_outer_done & ~search_hit) begin
+            nonce       <= nonce + 1'b1;
+        end
+        if (~busy & nonce_cnt_up) begin
+            nonce_cnt   <= dmem_writedata;
+        end else if (search_outer_done & ~search_hit) begin
+            nonce_cnt   <= nonce_cnt - 1'b1;
+        end
+    end
+end
+
+always_ff @(posedge clk, negedge rst_n) begin
+    if (~rst_n) begin
+        search_active   <= 1'b0;
+        search_outer    <= 1'b0;
+        search_found    <= 1'b0;
+        search_mid      <= '0;
+    end else begin
+        if (search_start) begin
+            search_active   <= 1'b1;
+            search_outer    <= 1'b0;
+            search_found    <= 1'b0;
+            search_mid      <= sha_state;
+        end else if (go_bit_in) begin
+            search_found    <= 1'b0;
+        end else if (search_inner_done) begin
+            search_outer    <= 1'b1;
+        end else if (search_outer_done) begin
+            search_active   <= ~search_end;
+            search_outer    <= 1'b0;
+            search_found    <= search_hit;
+        end
+    end
+end
+
+//-------------------------------------------------------------------------------
+// SHA-256 lanes 1..SCR1_ACCEL_SHA256_LANES-1
+//-------------------------------------------------------------------------------
+assign lane_rdata[0] = '0;
+
+genvar lane;
+generate
+    for (lane = 1; lane < SCR1_ACCEL_SHA256_LANES; lane++) begin : gen_lane
+        scr1_accel_sha256_lane #(
+            .SCR1_SHA256_RPC    (SCR1_ACCEL_SHA256_RPC)
+        ) i_lane (
+            .clk        (clk                                                        ),
+            .rst_n      (rst_n                                                      ),
+            .reg_wr     (dmem_wr & (dmem_addr[15:SCR1_ACCEL_ADDR_WIDTH] == 8'(lane))),
+            .reg_addr   (dmem_addr[SCR1_ACCEL_ADDR_WIDTH-1:0]                       ),
+            .reg_wdata  (dmem_writedata                                             ),
+            .reg_rdata  (lane_rdata[lane]                                           ),
+            .done       (lane_done[lane]                                            )
+        );
+    end : gen_lane
+endgenerate
+
+//-------------------------------------------------------------------------------
+// Data memory output generation
+//-------------------------------------------------------------------------------
 always_ff @(posedge clk) begin
     if (dmem_rd) begin
-        dmem_rdata_shift_reg <= dmem_addr[1:0];
+        dmem_rdata_reg          <= dmem_rdata_local;
+        dmem_rdata_shift_reg    <= dmem_addr[1:0];
     end
 end
 
-assign dmem_rdata = dmem_rdata_local >> ( 8 * dmem_rdata_shift_reg ); // this is output
+assign dmem_rdata = dmem_rdata_reg >> ( 8 * dmem_rdata_shift_reg );
+
+`ifdef SCR1_TRGT_SIMULATION
+//-------------------------------------------------------------------------------
+// Assertion
+//-------------------------------------------------------------------------------
+
+initial begin
+    if ((SCR1_ACCEL_SHA256_LANES < 1) || (SCR1_ACCEL_SHA256_LANES > 32)) begin
+        $error("Accelerator Error: SCR1_ACCEL_SHA256_LANES must be 1 to 32");
+    end
+end
 
+`endif // SCR1_TRGT_SIMULATION
 
-endmodule : scr1_accel
\ No newline at end of file
+endmodule : scr1_accel
@@ -0,0 +1,200 @@
+/// Copyright by Syntacore LLC © 2016-2021. See LICENSE for details
+/// @file       <scr1_accel_ahb.sv>
+/// @brief      AHB-Lite slave wrapper of the memory mapped accelerator
+///
+/// Puts scr1_accel on an AHB-Lite interconnect, for a build where the accelerator sits on an
+/// AHB bus. scr1_top_ahb connects scr1_accel to dmem router port 3 directly, and only with
+/// SCR1_ACCEL_EXT_BUS reaches this wrapper through its own scr1_dmem_ahb bridge, at the bridge
+/// latency. The accelerator takes a request every cycle and answers the next one, so both are
+/// zero wait state:
+///   - a write is issued to the accelerator in its data phase, when HWDATA is valid;
+///   - a read is issued in its address phase and returns HRDATA in the data phase.
+/// A read whose address phase overlaps the data phase of a write is issued one cycle later,
+/// with one wait state. Bursts (SINGLE, INCR, INCRx, WRAPx) are beats of single transfers,
+/// so a message block written with an INCR16 burst costs 16 cycles. HRESP is always OKAY.
+///
+/// HSIZE must not exceed the bus width and the address must be aligned to it; HPROT and
+/// HMASTLOCK are ignored.
+///
+
+`include "scr1_ahb.svh"
+`include "scr1_memif.svh"
+
+module scr1_accel_ahb
+#(
+    parameter int unsigned SCR1_ACCEL_SHA256_RPC    = 1,    // SHA-256 rounds per clock: 1, 2, 4 or 8
+    parameter int unsigned SCR1_ACCEL_SHA256_LANES  = 1,    // SHA-256 lanes, 1 to 32
+    parameter bit          SCR1_ACCEL_TCM_EN        = 1     // DMA port connected to a TCM
+)
+(
+    // Control signals
+    input   logic                           rst_n,
+    input   logic                           clk,
+
+    // AHB-Lite slave interface
+    input   logic                           hsel,
+    input   logic   [SCR1_AHB_WIDTH-1:0]    haddr,
+    input   logic   [1:0]                   htrans,
+    input   logic   [2:0]                   hsize,
+    input   logic   [2:0]                   hburst,
+    input   logic                           hwrite,
+    input   logic   [SCR1_AHB_WIDTH-1:0]    hwdata,
+    input   logic                           hready,
+    output  logic                           hreadyout,
+    output  logic   [SCR1_AHB_WIDTH-1:0]    hrdata,
+    output  logic                           hresp,
+
+    // DMA interface (TCM)
+    input   logic                           dma_req_ack,
+    output  logic                           dma_req,
+    output  type_scr1_mem_cmd_e             dma_cmd,
+    output  logic [`SCR1_DMEM_AWIDTH-1:0]   dma_addr,
+    output  logic [`SCR1_DMEM_DWIDTH-1:0]   dma_wdata,
+    input   logic [`SCR1_DMEM_DWIDTH-1:0]   dma_rdata,
+    input   type_scr1_mem_resp_e            dma_resp,
+
+    // Interrupt
+    output  logic                           irq
+);
+
+//-------------------------------------------------------------------------------
+// Local functions
+//-------------------------------------------------------------------------------
+function automatic type_scr1_mem_width_e scr1_conv_ahb2mem_width (
+    input   logic   [2:0]   hwidth
+);
+    type_scr1_mem_width_e   tmp;
+begin
+    case (hwidth)
+        SCR1_HSIZE_8B : begin
+            tmp = SCR1_MEM_WIDTH_BYTE;
+        end
+        SCR1_HSIZE_16B : begin
+            tmp = SCR1_MEM_WIDTH_HWORD;
+        end
+        default : begin
+            tmp = SCR1_MEM_WIDTH_WORD;
+        end
+    endcase
+    return tmp;
+end
+endfunction : scr1_conv_ahb2mem_width
+
+//-------------------------------------------------------------------------------
+// Local signal declaration
+//-------------------------------------------------------------------------------
+logic                                       ahb_trans;
+logic                                       ahb_rd;
+
+// Transfer in the data phase
+logic                                       dph_wr;
+logic                                       dph_rd;
+logic   [SCR1_AHB_WIDTH-1:0]                dph_addr;
+logic   [2:0]                               dph_size;
+logic                                       rd_sent;
+
+logic                                       wr_issue;
+logic                                       rd_issue_now;
+logic                                       rd_issue_late;
+
+logic                                       accel_req;
+type_scr1_mem_cmd_e                         accel_cmd;
+type_scr1_mem_width_e                       accel_width;
+logic   [`SCR1_DMEM_AWIDTH-1:0]             accel_addr;
+logic   [`SCR1_DMEM_DWIDTH-1:0]             accel_wdata;
+logic   [`SCR1_DMEM_DWIDTH-1:0]             accel_rdata;
+type_scr1_mem_resp_e                        accel_resp;
+logic                                       accel_req_ack;
+
+//-------------------------------------------------------------------------------
+// AHB control
+//-------------------------------------------------------------------------------
+assign ahb_trans    = hsel & htrans[1] & hready;
+assign ahb_rd       = ahb_trans & ~hwrite;
+
+always_ff @(negedge rst_n, posedge clk) begin
+    if (~rst_n) begin
+        dph_wr  <= 1'b0;
+        dph_rd  <= 1'b0;
+        rd_sent <= 1'b0;
+    end else begin
+        if (hready) begin
+            dph_wr  <= ahb_trans & hwrite;
+            dph_rd  <= ahb_rd;
+        end
+        rd_sent <= rd_issue_now | rd_issue_late;
+    end
+end
+
+always_ff @(posedge clk) begin
+    if (ahb_trans) begin
+        dph_addr    <= haddr;
+        dph_size    <= hsize;
+    end
+end
+
+// The write of the data phase has the accelerator port; a read arriving meanwhile waits
+assign wr_issue         = dph_wr;
+assign rd_issue_now     = ahb_rd & ~dph_wr;
+assign rd_issue_late    = dph_rd & ~rd_sent & ~dph_wr;
+
+assign hreadyout    = ~dph_rd | rd_sent;
+assign hresp        = SCR1_HRESP_OKAY;
+assign hrdata       = accel_rdata << (8 * dph_addr[1:0]);
+
+//-------------------------------------------------------------------------------
+// Accelerator request
+//-------------------------------------------------------------------------------
+assign accel_req    = wr_issue | rd_issue_now | rd_issue_late;
+assign accel_cmd    = wr_issue ? SCR1_MEM_CMD_WR : SCR1_MEM_CMD_RD;
+assign accel_width  = scr1_conv_ahb2mem_width(rd_issue_now ? hsize : dph_size);
+assign accel_addr   = rd_issue_now ? haddr : dph_addr;
+// The accelerator takes byte and halfword data in the low bits, as the core stores it
+assign accel_wdata  = hwdata >> (8 * dph_addr[1:0]);
+
+scr1_accel #(
+    .SCR1_ACCEL_SHA256_RPC      (SCR1_ACCEL_SHA256_RPC  ),
+    .SCR1_ACCEL_SHA256_LANES    (SCR1_ACCEL_SHA256_LANES),
+    .SCR1_ACCEL_TCM_EN          (SCR1_ACCEL_TCM_EN      )
+) i_accel (
+    .clk            (clk          ),
+    .rst_n          (rst_n        ),
+
+    .dmem_req_ack   (accel_req_ack),
+    .dmem_req       (accel_req    ),
+    .dmem_cmd       (accel_cmd    ),
+    .dmem_width     (accel_width  ),
+    .dmem_addr      (accel_addr   ),
+    .dmem_wdata     (accel_wdata  ),
+    .dmem_rdata     (accel_rdata  ),
+    .dmem_resp      (accel_resp   ),
+
+    .dma_req_ack    (dma_req_ack  ),
+    .dma_req        (dma_req      ),
+    .dma_cmd        (dma_cmd      ),
+    .dma_addr       (dma_addr     ),
+    .dma_wdata      (dma_wdata    ),
+    .dma_rdata      (dma_rdata    ),
+    .dma_resp       (dma_resp     ),
+
+    .irq            (irq          )
+);
+
+`ifdef SCR1_TRGT_SIMULATION
+//-------------------------------------------------------------------------------
+// Assertion
+//-------------------------------------------------------------------------------
+
+SCR1_SVA_ACCEL_AHB_RESP : assert property (
+    @(negedge clk) disable iff (~rst_n)
+    accel_req |=> (accel_resp == SCR1_MEM_RESP_RDY_OK)
+    ) else $error("ACCEL AHB Error: the accelerator did not answer in one cycle");
+
+SCR1_SVA_ACCEL_AHB_SIZE : assert property (
+    @(negedge clk) disable iff (~rst_n)
+    ahb_trans |-> (hsize <= SCR1_HSIZE_32B)
+    ) else $error("ACCEL AHB Error: HSIZE above the bus width");
+
+`endif // SCR1_TRGT_SIMULATION
+
+endmodule : scr1_accel_ahb
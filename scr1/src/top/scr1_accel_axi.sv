@@ -0,0 +1,190 @@
+/// Copyright by Syntacore LLC © 2016-2021. See LICENSE for details
+/// @file       <scr1_accel_axi.sv>
+/// @brief      AXI4-Lite slave wrapper of the memory mapped accelerator
+///
+/// Puts scr1_accel on an AXI4-Lite interconnect. scr1_top_axi reaches it from dmem router port 3
+/// through its own scr1_mem_axi bridge. The accelerator takes a request every cycle and
+/// answers the next one: a write is accepted when AWVALID and WVALID are both high and answered
+/// on B one cycle later, a read is answered on R one cycle after AR. With BREADY/RREADY held high, writes and reads go back to back at one word per
+/// cycle; when both are pending in the same cycle they alternate. BRESP and RRESP are OKAY.
+///
+/// WSTRB selects the access width: 4'b1111 is a word, 4'b0011/4'b1100 a halfword and a single
+/// bit a byte (other patterns are written as a word). Reads are always words. The read data
+/// is taken from the accelerator, which holds it until its next read, so RDATA stays stable
+/// while RREADY is low.
+///
+
+`include "scr1_memif.svh"
+`include "scr1_arch_description.svh"
+
+module scr1_accel_axi
+#(
+    parameter int unsigned SCR1_ACCEL_SHA256_RPC    = 1,    // SHA-256 rounds per clock: 1, 2, 4 or 8
+    parameter int unsigned SCR1_ACCEL_SHA256_LANES  = 1,    // SHA-256 lanes, 1 to 32
+    parameter bit          SCR1_ACCEL_TCM_EN        = 1,    // DMA port connected to a TCM
+    parameter SCR1_ADDR_WIDTH                       = 32
+)
+(
+    // Clock and Reset
+    input   logic                           clk,
+    input   logic                           rst_n,
+
+    // AXI4-Lite slave interface
+    input   logic [SCR1_ADDR_WIDTH-1:0]     awaddr,
+    input   logic [ 2:0]                    awprot,
+    input   logic                           awvalid,
+    output  logic                           awready,
+    input   logic [31:0]                    wdata,
+    input   logic [3:0]                     wstrb,
+    input   logic                           wvalid,
+    output  logic                           wready,
+    output  logic [ 1:0]                    bresp,
+    output  logic                           bvalid,
+    input   logic                           bready,
+    input   logic [SCR1_ADDR_WIDTH-1:0]     araddr,
+    input   logic [ 2:0]                    arprot,
+    input   logic                           arvalid,
+    output  logic                           arready,
+    output  logic [31:0]                    rdata,
+    output  logic [ 1:0]                    rresp,
+    output  logic                           rvalid,
+    input   logic                           rready,
+
+    // DMA interface (TCM)
+    input   logic                           dma_req_ack,
+    output  logic                           dma_req,
+    output  type_scr1_mem_cmd_e             dma_cmd,
+    output  logic [`SCR1_DMEM_AWIDTH-1:0]   dma_addr,
+    output  logic [`SCR1_DMEM_DWIDTH-1:0]   dma_wdata,
+    input   logic [`SCR1_DMEM_DWIDTH-1:0]   dma_rdata,
+    input   type_scr1_mem_resp_e            dma_resp,
+
+    // Interrupt
+    output  logic                           irq
+);
+
+//-------------------------------------------------------------------------------
+// Local signal declaration
+//-------------------------------------------------------------------------------
+logic                                   wr_pend;
+logic                                   rd_pend;
+logic                                   wr_go;
+logic                                   rd_go;
+logic                                   rd_turn;
+logic [1:0]                             wr_offs;
+
+logic                                   accel_req;
+type_scr1_mem_cmd_e                     accel_cmd;
+type_scr1_mem_width_e                   accel_width;
+logic [`SCR1_DMEM_AWIDTH-1:0]           accel_addr;
+logic [`SCR1_DMEM_DWIDTH-1:0]           accel_wdata;
+logic [`SCR1_DMEM_DWIDTH-1:0]           accel_rdata;
+type_scr1_mem_resp_e                    accel_resp;
+logic                                   accel_req_ack;
+
+//-------------------------------------------------------------------------------
+// Arbitration
+//-------------------------------------------------------------------------------
+// A request is taken when its response slot frees up by the next cycle
+assign wr_pend  = awvalid & wvalid & (~bvalid | bready);
+assign rd_pend  = arvalid & (~rvalid | rready);
+assign wr_go    = wr_pend & ~(rd_pend & rd_turn);
+assign rd_go    = rd_pend & ~wr_go;
+
+assign awready  = wr_go;
+assign wready   = wr_go;
+assign arready  = rd_go;
+
+always_ff @(posedge clk, negedge rst_n) begin
+    if (~rst_n) begin
+        rd_turn <= 1'b0;
+        bvalid  <= 1'b0;
+        rvalid  <= 1'b0;
+    end else begin
+        if (wr_pend & rd_pend) begin
+            rd_turn <= ~rd_turn;
+        end
+        if (wr_go) begin
+            bvalid  <= 1'b1;
+        end else if (bready) begin
+            bvalid  <= 1'b0;
+        end
+        if (rd_go) begin
+            rvalid  <= 1'b1;
+        end else if (rready) begin
+            rvalid  <= 1'b0;
+        end
+    end
+end
+
+assign bresp    = 2'b00;
+assign rresp    = 2'b00;
+assign rdata    = accel_rdata;
+
+//-------------------------------------------------------------------------------
+// Accelerator request
+//-------------------------------------------------------------------------------
+always_comb begin
+    accel_width = SCR1_MEM_WIDTH_WORD;
+    wr_offs     = 2'd0;
+    case (wstrb)
+        4'b0001 : begin accel_width = SCR1_MEM_WIDTH_BYTE;  wr_offs = 2'd0; end
+        4'b0010 : begin accel_width = SCR1_MEM_WIDTH_BYTE;  wr_offs = 2'd1; end
+        4'b0100 : begin accel_width = SCR1_MEM_WIDTH_BYTE;  wr_offs = 2'd2; end
+        4'b1000 : begin accel_width = SCR1_MEM_WIDTH_BYTE;  wr_offs = 2'd3; end
+        4'b0011 : begin accel_width = SCR1_MEM_WIDTH_HWORD; wr_offs = 2'd0; end
+        4'b1100 : begin accel_width = SCR1_MEM_WIDTH_HWORD; wr_offs = 2'd2; end
+        default : begin end
+    endcase
+    if (~wr_go) begin
+        accel_width = SCR1_MEM_WIDTH_WORD;
+    end
+end
+
+assign accel_req    = wr_go | rd_go;
+assign accel_cmd    = wr_go ? SCR1_MEM_CMD_WR : SCR1_MEM_CMD_RD;
+assign accel_addr   = wr_go ? {awaddr[`SCR1_DMEM_AWIDTH-1:2], wr_offs} : {araddr[`SCR1_DMEM_AWIDTH-1:2], 2'b00};
+// The accelerator takes byte and halfword data in the low bits, as the core stores it
+assign accel_wdata  = wdata >> (8 * wr_offs);
+
+scr1_accel #(
+    .SCR1_ACCEL_SHA256_RPC      (SCR1_ACCEL_SHA256_RPC  ),
+    .SCR1_ACCEL_SHA256_LANES    (SCR1_ACCEL_SHA256_LANES),
+    .SCR1_ACCEL_TCM_EN          (SCR1_ACCEL_TCM_EN      )
+) i_accel (
+    .clk            (clk          ),
+    .rst_n          (rst_n        ),
+
+    .dmem_req_ack   (accel_req_ack),
+    .dmem_req       (accel_req    ),
+    .dmem_cmd       (accel_cmd    ),
+    .dmem_width     (accel_width  ),
+    .dmem_addr      (accel_addr   ),
+    .dmem_wdata     (accel_wdata  ),
+    .dmem_rdata     (accel_rdata  ),
+    .dmem_resp      (accel_resp   ),
+
+    .dma_req_ack    (dma_req_ack  ),
+    .dma_req        (dma_req      ),
+    .dma_cmd        (dma_cmd      ),
+    .dma_addr       (dma_addr     ),
+    .dma_wdata      (dma_wdata    ),
+    .dma_rdata      (dma_rdata    ),
+    .dma_resp       (dma_resp     ),
+
+    .irq            (irq          )
+);
+
+`ifdef SCR1_TRGT_SIMULATION
+//-------------------------------------------------------------------------------
+// Assertion
+//-------------------------------------------------------------------------------
+
+SCR1_SVA_ACCEL_AXI_RESP : assert property (
+    @(negedge clk) disable iff (~rst_n)
+    accel_req |=> (accel_resp == SCR1_MEM_RESP_RDY_OK)
+    ) else $error("ACCEL AXI Error: the accelerator did not answer in one cycle");
+
+`endif // SCR1_TRGT_SIMULATION
+
+endmodule : scr1_accel_axi
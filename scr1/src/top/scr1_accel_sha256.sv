@@ -0,0 +1,246 @@
+/// Copyright by Syntacore LLC © 2016-2021. See LICENSE for details
+/// @file       <scr1_accel_sha256.sv>
+/// @brief      SHA-256 compression engine of the memory-mapped accelerator
+///
+
+`include "scr1_arch_description.svh"
+
+module scr1_accel_sha256
+#(
+    parameter int unsigned SCR1_SHA256_RPC  = 1         // Rounds per clock: 1, 2, 4 or 8
+)
+(
+    // Control signals
+    input   logic                           clk,
+    input   logic                           rst_n,
+
+    // Command interface
+    input   logic                           start,          // Compress the message window into the state
+    input   logic                           init,           // Load the initial hash value into the state
+    output  logic                           busy,           // Compression in progress
+    output  logic                           done,           // Compression finished, state updated (pulse)
+
+    // State registers H0..H7
+    input   logic                           state_we,
+    input   logic [2:0]                     state_idx,
+    input   logic [31:0]                    state_wdata,
+    input   logic                           state_load,     // Load the whole state at once (unless init)
+    input   logic [7:0][31:0]               state_load_data,
+    output  logic [7:0][31:0]               state,
+
+    // Message window W0..W15
+    input   logic                           msg_we,
+    input   logic [3:0]                     msg_idx,
+    input   logic [31:0]                    msg_wdata,
+    input   logic                           msg_load,       // Load the whole window at once
+    input   logic [15:0][31:0]              msg_load_data,
+    output  logic [15:0][31:0]              msg
+);
+
+//-------------------------------------------------------------------------------
+// Local parameters declaration
+//-------------------------------------------------------------------------------
+localparam int unsigned SCR1_SHA256_ROUNDS                  = 64;
+
+localparam logic [7:0][31:0] SCR1_SHA256_IV                 = {32'h5be0cd19, 32'h1f83d9ab,
+                                                               32'h9b05688c, 32'h510e527f,
+                                                               32'ha54ff53a, 32'h3c6ef372,
+                                                               32'hbb67ae85, 32'h6a09e667};
+
+//-------------------------------------------------------------------------------
+// Local functions
+//-------------------------------------------------------------------------------
+function automatic logic [31:0] sha256_rotr (
+    input   logic [31:0]    x,
+    input   int unsigned    n
+);
+    sha256_rotr = (x >> n) | (x << (32 - n));
+endfunction : sha256_rotr
+
+function automatic logic [31:0] sha256_ep0 (input logic [31:0] x);
+    sha256_ep0 = sha256_rotr(x, 2) ^ sha256_rotr(x, 13) ^ sha256_rotr(x, 22);
+endfunction : sha256_ep0
+
+function automatic logic [31:0] sha256_ep1 (input logic [31:0] x);
+    sha256_ep1 = sha256_rotr(x, 6) ^ sha256_rotr(x, 11) ^ sha256_rotr(x, 25);
+endfunction : sha256_ep1
+
+function automatic logic [31:0] sha256_sig0 (input logic [31:0] x);
+    sha256_sig0 = sha256_rotr(x, 7) ^ sha256_rotr(x, 18) ^ (x >> 3);
+endfunction : sha256_sig0
+
+function automatic logic [31:0] sha256_sig1 (input logic [31:0] x);
+    sha256_sig1 = sha256_rotr(x, 17) ^ sha256_rotr(x, 19) ^ (x >> 10);
+endfunction : sha256_sig1
+
+// One compression round; working variables are packed as {h, g, f, e, d, c, b, a}
+function automatic logic [7:0][31:0] sha256_round (
+    input   logic [7:0][31:0]   v,
+    input   logic [31:0]        kw              // K[t] + W[t]
+);
+    logic [31:0] t1;
+    logic [31:0] t2;
+    t1 = v[7] + sha256_ep1(v[4]) + ((v[4] & v[5]) ^ (~v[4] & v[6])) + kw;
+    t2 = sha256_ep0(v[0]) + ((v[0] & v[1]) ^ (v[0] & v[2]) ^ (v[1] & v[2]));
+    sha256_round    = {v[6:4], v[3] + t1, v[2:0], t1 + t2};
+endfunction : sha256_round
+
+function automatic logic [31:0] sha256_k (input logic [5:0] idx);
+    case (idx)
+        6'd0  : sha256_k = 32'h428a2f98;    6'd1  : sha256_k = 32'h71374491;
+        6'd2  : sha256_k = 32'hb5c0fbcf;    6'd3  : sha256_k = 32'he9b5dba5;
+        6'd4  : sha256_k = 32'h3956c25b;    6'd5  : sha256_k = 32'h59f111f1;
+        6'd6  : sha256_k = 32'h923f82a4;    6'd7  : sha256_k = 32'hab1c5ed5;
+        6'd8  : sha256_k = 32'hd807aa98;    6'd9  : sha256_k = 32'h12835b01;
+        6'd10 : sha256_k = 32'h243185be;    6'd11 : sha256_k = 32'h550c7dc3;
+        6'd12 : sha256_k = 32'h72be5d74;    6'd13 : sha256_k = 32'h80deb1fe;
+        6'd14 : sha256_k = 32'h9bdc06a7;    6'd15 : sha256_k = 32'hc19bf174;
+        6'd16 : sha256_k = 32'he49b69c1;    6'd17 : sha256_k = 32'hefbe4786;
+        6'd18 : sha256_k = 32'h0fc19dc6;    6'd19 : sha256_k = 32'h240ca1cc;
+        6'd20 : sha256_k = 32'h2de92c6f;    6'd21 : sha256_k = 32'h4a7484aa;
+        6'd22 : sha256_k = 32'h5cb0a9dc;    6'd23 : sha256_k = 32'h76f988da;
+        6'd24 : sha256_k = 32'h983e5152;    6'd25 : sha256_k = 32'ha831c66d;
+        6'd26 : sha256_k = 32'hb00327c8;    6'd27 : sha256_k = 32'hbf597fc7;
+        6'd28 : sha256_k = 32'hc6e00bf3;    6'd29 : sha256_k = 32'hd5a79147;
+        6'd30 : sha256_k = 32'h06ca6351;    6'd31 : sha256_k = 32'h14292967;
+        6'd32 : sha256_k = 32'h27b70a85;    6'd33 : sha256_k = 32'h2e1b2138;
+        6'd34 : sha256_k = 32'h4d2c6dfc;    6'd35 : sha256_k = 32'h53380d13;
+        6'd36 : sha256_k = 32'h650a7354;    6'd37 : sha256_k = 32'h766a0abb;
+        6'd38 : sha256_k = 32'h81c2c92e;    6'd39 : sha256_k = 32'h92722c85;
+        6'd40 : sha256_k = 32'ha2bfe8a1;    6'd41 : sha256_k = 32'ha81a664b;
+        6'd42 : sha256_k = 32'hc24b8b70;    6'd43 : sha256_k = 32'hc76c51a3;
+        6'd44 : sha256_k = 32'hd192e819;    6'd45 : sha256_k = 32'hd6990624;
+        6'd46 : sha256_k = 32'hf40e3585;    6'd47 : sha256_k = 32'h106aa070;
+        6'd48 : sha256_k = 32'h19a4c116;    6'd49 : sha256_k = 32'h1e376c08;
+        6'd50 : sha256_k = 32'h2748774c;    6'd51 : sha256_k = 32'h34b0bcb5;
+        6'd52 : sha256_k = 32'h391c0cb3;    6'd53 : sha256_k = 32'h4ed8aa4a;
+        6'd54 : sha256_k = 32'h5b9cca4f;    6'd55 : sha256_k = 32'h682e6ff3;
+        6'd56 : sha256_k = 32'h748f82ee;    6'd57 : sha256_k = 32'h78a5636f;
+        6'd58 : sha256_k = 32'h84c87814;    6'd59 : sha256_k = 32'h8cc70208;
+        6'd60 : sha256_k = 32'h90befffa;    6'd61 : sha256_k = 32'ha4506ceb;
+        6'd62 : sha256_k = 32'hbef9a3f7;    default : sha256_k = 32'hc67178f2;
+    endcase
+endfunction : sha256_k
+
+//-------------------------------------------------------------------------------
+// Local signals declaration
+//-------------------------------------------------------------------------------
+logic [5:0]                                         round;
+logic                                               round_last;
+logic [7:0][31:0]                                   work;
+logic [7:0][31:0]                                   work_next;
+logic [SCR1_SHA256_RPC:0][7:0][31:0]                work_chain;
+logic [15+SCR1_SHA256_RPC:0][31:0]                  sched;
+
+//-------------------------------------------------------------------------------
+// Round counter
+//-------------------------------------------------------------------------------
+assign round_last = busy & (round == 6'(SCR1_SHA256_ROUNDS - SCR1_SHA256_RPC));
+
+always_ff @(posedge clk, negedge rst_n) begin
+    if (~rst_n) begin
+        busy    <= 1'b0;
+        round   <= '0;
+    end else begin
+        if (~busy) begin
+            busy    <= start;
+            round   <= '0;
+        end else begin
+            busy    <= ~round_last;
+            round   <= round + 6'(SCR1_SHA256_RPC);
+        end
+    end
+end
+
+always_ff @(posedge clk, negedge rst_n) begin
+    if (~rst_n) begin
+        done    <= 1'b0;
+    end else begin
+        done    <= round_last;
+    end
+end
+
+//-------------------------------------------------------------------------------
+// Datapath
+//-------------------------------------------------------------------------------
+// The window is consumed in place as the message schedule: W[t] is always at msg[0]
+// and the next SCR1_SHA256_RPC schedule words are shifted in at the top
+always_comb begin
+    sched[15:0] = msg;
+    for (int j = 0; j < SCR1_SHA256_RPC; j++) begin
+        sched[16+j] = sha256_sig1(sched[14+j]) + sched[9+j] + sha256_sig0(sched[1+j]) + sched[j];
+    end
+end
+
+// SCR1_SHA256_RPC rounds are chained combinationally in one clock
+always_comb begin
+    work_chain[0] = work;
+    for (int j = 0; j < SCR1_SHA256_RPC; j++) begin
+        work_chain[j+1] = sha256_round(work_chain[j], sha256_k(round + 6'(j)) + sched[j]);
+    end
+end
+
+assign work_next = work_chain[SCR1_SHA256_RPC];
+
+always_ff @(posedge clk, negedge rst_n) begin
+    if (~rst_n) begin
+        work    <= '0;
+    end else begin
+        if (~busy) begin
+            if (start) begin
+                work    <= init ? SCR1_SHA256_IV : (state_load ? state_load_data : state);
+            end
+        end else begin
+            work    <= work_next;
+        end
+    end
+end
+
+always_ff @(posedge clk, negedge rst_n) begin
+    if (~rst_n) begin
+        state   <= SCR1_SHA256_IV;
+    end else begin
+        if (round_last) begin
+            for (int i = 0; i < 8; i++) begin
+                state[i]    <= state[i] + work_next[i];
+            end
+        end else if (~busy) begin
+            if (init) begin
+                state   <= SCR1_SHA256_IV;
+            end else if (state_load) begin
+                state   <= state_load_data;
+            end else if (state_we) begin
+                state[state_idx]    <= state_wdata;
+            end
+        end
+    end
+end
+
+always_ff @(posedge clk, negedge rst_n) begin
+    if (~rst_n) begin
+        msg     <= '0;
+    end else begin
+        if (busy) begin
+            msg     <= sched[SCR1_SHA256_RPC +: 16];
+        end else if (msg_load) begin
+            msg     <= msg_load_data;
+        end else if (msg_we) begin
+            msg[msg_idx]    <= msg_wdata;
+        end
+    end
+end
+
+`ifdef SCR1_TRGT_SIMULATION
+//-------------------------------------------------------------------------------
+// Assertion
+//-------------------------------------------------------------------------------
+
+initial begin
+    if (!(SCR1_SHA256_RPC inside {1, 2, 4, 8})) begin
+        $error("SHA-256 accelerator Error: SCR1_SHA256_RPC must be 1, 2, 4 or 8");
+    end
+end
+
+`endif // SCR1_TRGT_SIMULATION
+
+endmodule : scr1_accel_sha256
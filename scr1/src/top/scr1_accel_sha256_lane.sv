@@ -0,0 +1,273 @@
+/// Copyright by Syntacore LLC © 2016-2021. See LICENSE for details
+/// @file       <scr1_accel_sha256_lane.sv>
+/// @brief      Additional SHA-256 lane of the memory-mapped accelerator
+///
+/// A lane is the SHA-256 PIO subset of the lane 0 register map: CTRL (GO/INIT/FINAL/ACK
+/// with a queued GO; go, busy, pend, done), COUNTER, DATALEN, BITLEN, STATE and MSG.
+/// MODE reads as MODE_SHA256, other offsets read as zero.
+///
+
+`include "scr1_arch_description.svh"
+`include "scr1_accel.svh"
+
+module scr1_accel_sha256_lane
+#(
+    parameter int unsigned SCR1_SHA256_RPC  = 1         // Rounds per clock: 1, 2, 4 or 8
+)
+(
+    // Control signals
+    input   logic                               clk,
+    input   logic                               rst_n,
+
+    // Register interface (lane window)
+    input   logic                               reg_wr,
+    input   logic [SCR1_ACCEL_ADDR_WIDTH-1:0]   reg_addr,
+    input   logic [31:0]                        reg_wdata,
+    output  logic [31:0]                        reg_rdata,
+
+    // Status
+    output  logic                               done            // CTRL.done
+);
+
+//-------------------------------------------------------------------------------
+// Local signal declaration
+//-------------------------------------------------------------------------------
+logic                               ctrl_up;
+logic                               datalen_up;
+logic                               bitlen0_up;
+logic                               bitlen1_up;
+logic                               state_up;
+logic                               msg_up;
+
+logic                               go_bit;
+logic                               go_bit_in;
+logic                               go_queue;
+logic                               go_pend;
+logic [3:0]                         go_pend_cmd;
+logic                               cmd_up;
+logic [3:0]                         cmd;
+logic                               done_bit_in;
+logic                               done_ack;
+logic                               busy;
+logic [31:0]                        counter;
+
+logic                               sha_start;
+logic                               sha_init;
+logic                               sha_busy;
+logic                               sha_done;
+logic [7:0][31:0]                   sha_state;
+logic [15:0][31:0]                  sha_msg;
+logic [15:0][31:0]                  msg_buf;
+
+logic [5:0]                         datalen;
+logic [63:0]                        bitlen;
+logic [63:0]                        bitlen_cur;
+logic [63:0]                        fin_len;
+logic [63:0]                        fin_len_hold;
+logic                               fin_start;
+logic                               fin_active;
+logic                               fin_second;
+logic [15:0][31:0]                  fin_window;
+
+//-------------------------------------------------------------------------------
+// Register access
+//-------------------------------------------------------------------------------
+always_comb begin
+    ctrl_up     = 1'b0;
+    datalen_up  = 1'b0;
+    bitlen0_up  = 1'b0;
+    bitlen1_up  = 1'b0;
+    state_up    = 1'b0;
+    msg_up      = 1'b0;
+    if (reg_wr) begin
+        case (reg_addr[SCR1_ACCEL_ADDR_WIDTH-1:2])
+            SCR1_ACCEL_CTRL[SCR1_ACCEL_ADDR_WIDTH-1:2]      : ctrl_up       = 1'b1;
+            SCR1_ACCEL_DATALEN[SCR1_ACCEL_ADDR_WIDTH-1:2]   : datalen_up    = 1'b1;
+            SCR1_ACCEL_BITLEN0[SCR1_ACCEL_ADDR_WIDTH-1:2]   : bitlen0_up    = 1'b1;
+            SCR1_ACCEL_BITLEN1[SCR1_ACCEL_ADDR_WIDTH-1:2]   : bitlen1_up    = 1'b1;
+            default                                         : begin
+                state_up    = (reg_addr[SCR1_ACCEL_ADDR_WIDTH-1:5] == SCR1_ACCEL_STATE[SCR1_ACCEL_ADDR_WIDTH-1:5]);
+                msg_up      = (reg_addr[SCR1_ACCEL_ADDR_WIDTH-1:6] == SCR1_ACCEL_MSG[SCR1_ACCEL_ADDR_WIDTH-1:6]);
+            end
+        endcase
+    end
+end
+
+always_comb begin
+    reg_rdata = '0;
+    case (reg_addr[SCR1_ACCEL_ADDR_WIDTH-1:2])
+        SCR1_ACCEL_CTRL[SCR1_ACCEL_ADDR_WIDTH-1:2]      : begin
+            reg_rdata[SCR1_ACCEL_CTRL_GO_OFFSET]    = go_bit;
+            reg_rdata[SCR1_ACCEL_CTRL_BUSY_OFFSET]  = busy;
+            reg_rdata[SCR1_ACCEL_CTRL_PEND_OFFSET]  = go_pend;
+            reg_rdata[SCR1_ACCEL_CTRL_DONE_OFFSET]  = done;
+        end
+        SCR1_ACCEL_COUNTER[SCR1_ACCEL_ADDR_WIDTH-1:2]   : reg_rdata = counter;
+        SCR1_ACCEL_MODE[SCR1_ACCEL_ADDR_WIDTH-1:2]      : reg_rdata = 32'(SCR1_ACCEL_MODE_SHA256);
+        SCR1_ACCEL_DATALEN[SCR1_ACCEL_ADDR_WIDTH-1:2]   : reg_rdata = 32'(datalen);
+        SCR1_ACCEL_BITLEN0[SCR1_ACCEL_ADDR_WIDTH-1:2]   : reg_rdata = bitlen[31:0];
+        SCR1_ACCEL_BITLEN1[SCR1_ACCEL_ADDR_WIDTH-1:2]   : reg_rdata = bitlen[63:32];
+        default                                         : begin
+            if (reg_addr[SCR1_ACCEL_ADDR_WIDTH-1:5] == SCR1_ACCEL_STATE[SCR1_ACCEL_ADDR_WIDTH-1:5]) begin
+                reg_rdata = sha_state[reg_addr[4:2]];
+            end else if (reg_addr[SCR1_ACCEL_ADDR_WIDTH-1:6] == SCR1_ACCEL_MSG[SCR1_ACCEL_ADDR_WIDTH-1:6]) begin
+                reg_rdata = msg_buf[reg_addr[5:2]];
+            end
+        end
+    endcase
+end
+
+//-------------------------------------------------------------------------------
+// Control and status
+//-------------------------------------------------------------------------------
+// As in lane 0: a GO written while busy is queued and taken when the lane is idle
+assign cmd_up       = ~busy & (go_pend | ctrl_up);
+assign cmd          = go_pend ? go_pend_cmd : reg_wdata[3:0];
+assign go_bit_in    = cmd_up & cmd[SCR1_ACCEL_CTRL_GO_OFFSET];
+assign go_queue     = ctrl_up & reg_wdata[SCR1_ACCEL_CTRL_GO_OFFSET] & busy & ~go_pend;
+assign done_ack     = ctrl_up & reg_wdata[SCR1_ACCEL_CTRL_ACK_OFFSET];
+assign done_bit_in  = sha_done & ~fin_second;
+assign busy         = sha_busy | fin_second;
+
+always_ff @(posedge clk, negedge rst_n) begin
+    if (~rst_n) begin
+        go_bit      <= 1'b0;
+        go_pend     <= 1'b0;
+        go_pend_cmd <= '0;
+    end else begin
+        go_bit  <= go_bit_in;
+        if (go_queue) begin
+            go_pend     <= 1'b1;
+            go_pend_cmd <= reg_wdata[3:0];
+        end else if (~busy) begin
+            go_pend     <= 1'b0;
+        end
+    end
+end
+
+always_ff @(posedge clk, negedge rst_n) begin
+    if (~rst_n) begin
+        done    <= 1'b0;
+    end else begin
+        done    <= ((go_bit_in | done_ack) ? 1'b0 : done) | (done_bit_in & ~go_pend);
+    end
+end
+
+always_ff @(posedge clk, negedge rst_n) begin
+    if (~rst_n) begin
+        counter <= '0;
+    end else begin
+        if (go_bit_in & ~go_pend) begin
+            counter <= '0;
+        end else if (busy) begin
+            counter <= counter + 1'b1;
+        end
+    end
+end
+
+//-------------------------------------------------------------------------------
+// SHA-256 compression engine
+//-------------------------------------------------------------------------------
+assign sha_start    = go_bit_in | (sha_done & fin_second);
+assign sha_init     = cmd_up & cmd[SCR1_ACCEL_CTRL_INIT_OFFSET];
+
+always_ff @(posedge clk, negedge rst_n) begin
+    if (~rst_n) begin
+        msg_buf <= '0;
+    end else begin
+        if (msg_up) begin
+            msg_buf[reg_addr[5:2]]  <= reg_wdata;
+        end
+    end
+end
+
+scr1_accel_sha256 #(
+    .SCR1_SHA256_RPC    (SCR1_SHA256_RPC)
+) i_sha256 (
+    .clk            (clk                ),
+    .rst_n          (rst_n              ),
+
+    .start          (sha_start          ),
+    .init           (sha_init           ),
+    .busy           (sha_busy           ),
+    .done           (sha_done           ),
+
+    .state_we       (state_up & ~busy   ),
+    .state_idx      (reg_addr[4:2]      ),
+    .state_wdata    (reg_wdata          ),
+    .state_load     (1'b0               ),
+    .state_load_data('0                 ),
+    .state          (sha_state          ),
+
+    .msg_we         (1'b0               ),
+    .msg_idx        ('0                 ),
+    .msg_wdata      ('0                 ),
+    .msg_load       (sha_start          ),
+    .msg_load_data  ((fin_start | fin_second) ? fin_window : msg_buf),
+    .msg            (sha_msg            )
+);
+
+//-------------------------------------------------------------------------------
+// Finalization (CTRL.FINAL), as in lane 0: the length is latched when the FINAL
+// starts, so DATALEN may be written for a FINAL queued behind it
+//-------------------------------------------------------------------------------
+assign fin_start    = go_bit_in & cmd[SCR1_ACCEL_CTRL_FINAL_OFFSET];
+assign bitlen_cur   = (sha_done & ~fin_active) ? (bitlen + 64'd512) : bitlen;
+assign fin_len      = (sha_init ? 64'd0 : bitlen_cur) + {55'd0, datalen, 3'd0};
+
+always_comb begin
+    if (fin_second) begin
+        fin_window  = '0;
+    end else begin
+        fin_window  = scr1_accel_sha256_pad(msg_buf, datalen);
+    end
+    if (fin_second) begin
+        fin_window[14]  = fin_len_hold[63:32];
+        fin_window[15]  = fin_len_hold[31:0];
+    end else if (datalen < 6'd56) begin
+        fin_window[14]  = fin_len[63:32];
+        fin_window[15]  = fin_len[31:0];
+    end
+end
+
+always_ff @(posedge clk, negedge rst_n) begin
+    if (~rst_n) begin
+        datalen <= '0;
+        bitlen  <= '0;
+    end else begin
+        if (datalen_up) begin
+            datalen <= reg_wdata[5:0];
+        end
+        if (sha_init) begin
+            bitlen  <= '0;
+        end else if (~busy & (bitlen0_up | bitlen1_up)) begin
+            if (bitlen0_up) begin
+                bitlen[31:0]    <= reg_wdata;
+            end
+            if (bitlen1_up) begin
+                bitlen[63:32]   <= reg_wdata;
+            end
+        end else if (sha_done & ~fin_active) begin
+            bitlen  <= bitlen + 64'd512;
+        end
+    end
+end
+
+always_ff @(posedge clk, negedge rst_n) begin
+    if (~rst_n) begin
+        fin_active      <= 1'b0;
+        fin_second      <= 1'b0;
+        fin_len_hold    <= '0;
+    end else begin
+        if (fin_start) begin
+            fin_active      <= 1'b1;
+            fin_second      <= (datalen >= 6'd56);
+            fin_len_hold    <= fin_len;
+        end else if (sha_done & fin_active) begin
+            fin_active      <= fin_second;
+            fin_second      <= 1'b0;
+        end
+    end
+end
+
+endmodule : scr1_accel_sha256_lane
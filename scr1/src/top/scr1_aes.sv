@@ -0,0 +1,509 @@
+/// Copyright by Syntacore LLC © 2016-2021. See LICENSE for details
+/// @file       <scr1_aes.sv>
+/// @brief      Memory-mapped AES-128/256 accelerator
+///
+/// Register map (word registers, offsets from the AES base):
+///   0x00        CTRL     W: [0] GO (process DATA_IN),
+///                           [1] KEY (expand KEY into the round keys; with GO, the block
+///                               starts when the expansion ends),
+///                           [2] DEC (decrypt instead of encrypt, ECB only),
+///                           [3] CTR (counter mode, see below)
+///                        R: [0] go, [1] busy,
+///                           [30] err (a GO or KEY was written while busy and dropped; cleared
+///                                by the next GO or KEY taken),
+///                           [31] done (set when the block, or a KEY without GO, completes;
+///                                cleared by the next GO or KEY)
+///                        Commands written while busy are not queued, since DATA_OUT would be
+///                        overwritten before it is read: poll CTRL.done before the next GO
+///   0x04        COUNTER  cycles spent on the last operation (Nr per block; 41 for an AES-128
+///                        KEY, 53 for AES-256, one per expanded round key word plus one)
+///   0x08        KEYLEN   0 - AES-128 (10 rounds), 1 - AES-256 (14 rounds), written when idle
+///   0x10-0x1C   CTR      128-bit counter block, written when idle
+///   0x20-0x3C   KEY      cipher key, write-only (AES-128 uses 0x20-0x2C)
+///   0x40-0x4C   DATA_IN  input block, latched when the block starts: the next block may be
+///                        written while the current one is processed
+///   0x50-0x5C   DATA_OUT output block, updated when the block is done
+///
+/// The 128-bit registers hold their bytes in memory order (byte 0 in bits [7:0] of the first
+/// word), so blocks, keys and counters are copied with plain word accesses.
+///
+/// ECB: GO encrypts DATA_IN, or decrypts it with DEC, into DATA_OUT. CTR: GO encrypts CTR,
+/// XORs the result with DATA_IN into DATA_OUT and increments CTR as a big-endian 128-bit
+/// number (NIST SP 800-38A), so a stream is processed by writing DATA_IN and GO per block;
+/// DEC is ignored, CTR decryption being the same operation. The round keys are kept until
+/// the next KEY, so a key is expanded once and reused for every block.
+///
+
+`include "scr1_memif.svh"
+`include "scr1_arch_description.svh"
+`include "scr1_aes.svh"
+
+module scr1_aes
+(
+    // Control signals
+    input   logic                           clk,
+    input   logic                           rst_n,
+
+    // Core data interface
+    output  logic                           dmem_req_ack,
+    input   logic                           dmem_req,
+    input   type_scr1_mem_cmd_e             dmem_cmd,
+    input   type_scr1_mem_width_e           dmem_width,
+    input   logic [`SCR1_DMEM_AWIDTH-1:0]   dmem_addr,
+    input   logic [`SCR1_DMEM_DWIDTH-1:0]   dmem_wdata,
+    output  logic [`SCR1_DMEM_DWIDTH-1:0]   dmem_rdata,
+    output  type_scr1_mem_resp_e            dmem_resp
+);
+
+//-------------------------------------------------------------------------------
+// Local parameters declaration
+//-------------------------------------------------------------------------------
+localparam logic [7:0] SCR1_AES_SBOX [256] = '{
+    8'h63, 8'h7c, 8'h77, 8'h7b, 8'hf2, 8'h6b, 8'h6f, 8'hc5, 8'h30, 8'h01, 8'h67, 8'h2b, 8'hfe, 8'hd7, 8'hab, 8'h76,
+    8'hca, 8'h82, 8'hc9, 8'h7d, 8'hfa, 8'h59, 8'h47, 8'hf0, 8'had, 8'hd4, 8'ha2, 8'haf, 8'h9c, 8'ha4, 8'h72, 8'hc0,
+    8'hb7, 8'hfd, 8'h93, 8'h26, 8'h36, 8'h3f, 8'hf7, 8'hcc, 8'h34, 8'ha5, 8'he5, 8'hf1, 8'h71, 8'hd8, 8'h31, 8'h15,
+    8'h04, 8'hc7, 8'h23, 8'hc3, 8'h18, 8'h96, 8'h05, 8'h9a, 8'h07, 8'h12, 8'h80, 8'he2, 8'heb, 8'h27, 8'hb2, 8'h75,
+    8'h09, 8'h83, 8'h2c, 8'h1a, 8'h1b, 8'h6e, 8'h5a, 8'ha0, 8'h52, 8'h3b, 8'hd6, 8'hb3, 8'h29, 8'he3, 8'h2f, 8'h84,
+    8'h53, 8'hd1, 8'h00, 8'hed, 8'h20, 8'hfc, 8'hb1, 8'h5b, 8'h6a, 8'hcb, 8'hbe, 8'h39, 8'h4a, 8'h4c, 8'h58, 8'hcf,
+    8'hd0, 8'hef, 8'haa, 8'hfb, 8'h43, 8'h4d, 8'h33, 8'h85, 8'h45, 8'hf9, 8'h02, 8'h7f, 8'h50, 8'h3c, 8'h9f, 8'ha8,
+    8'h51, 8'ha3, 8'h40, 8'h8f, 8'h92, 8'h9d, 8'h38, 8'hf5, 8'hbc, 8'hb6, 8'hda, 8'h21, 8'h10, 8'hff, 8'hf3, 8'hd2,
+    8'hcd, 8'h0c, 8'h13, 8'hec, 8'h5f, 8'h97, 8'h44, 8'h17, 8'hc4, 8'ha7, 8'h7e, 8'h3d, 8'h64, 8'h5d, 8'h19, 8'h73,
+    8'h60, 8'h81, 8'h4f, 8'hdc, 8'h22, 8'h2a, 8'h90, 8'h88, 8'h46, 8'hee, 8'hb8, 8'h14, 8'hde, 8'h5e, 8'h0b, 8'hdb,
+    8'he0, 8'h32, 8'h3a, 8'h0a, 8'h49, 8'h06, 8'h24, 8'h5c, 8'hc2, 8'hd3, 8'hac, 8'h62, 8'h91, 8'h95, 8'he4, 8'h79,
+    8'he7, 8'hc8, 8'h37, 8'h6d, 8'h8d, 8'hd5, 8'h4e, 8'ha9, 8'h6c, 8'h56, 8'hf4, 8'hea, 8'h65, 8'h7a, 8'hae, 8'h08,
+    8'hba, 8'h78, 8'h25, 8'h2e, 8'h1c, 8'ha6, 8'hb4, 8'hc6, 8'he8, 8'hdd, 8'h74, 8'h1f, 8'h4b, 8'hbd, 8'h8b, 8'h8a,
+    8'h70, 8'h3e, 8'hb5, 8'h66, 8'h48, 8'h03, 8'hf6, 8'h0e, 8'h61, 8'h35, 8'h57, 8'hb9, 8'h86, 8'hc1, 8'h1d, 8'h9e,
+    8'he1, 8'hf8, 8'h98, 8'h11, 8'h69, 8'hd9, 8'h8e, 8'h94, 8'h9b, 8'h1e, 8'h87, 8'he9, 8'hce, 8'h55, 8'h28, 8'hdf,
+    8'h8c, 8'ha1, 8'h89, 8'h0d, 8'hbf, 8'he6, 8'h42, 8'h68, 8'h41, 8'h99, 8'h2d, 8'h0f, 8'hb0, 8'h54, 8'hbb, 8'h16
+};
+
+localparam logic [7:0] SCR1_AES_INV_SBOX [256] = '{
+    8'h52, 8'h09, 8'h6a, 8'hd5, 8'h30, 8'h36, 8'ha5, 8'h38, 8'hbf, 8'h40, 8'ha3, 8'h9e, 8'h81, 8'hf3, 8'hd7, 8'hfb,
+    8'h7c, 8'he3, 8'h39, 8'h82, 8'h9b, 8'h2f, 8'hff, 8'h87, 8'h34, 8'h8e, 8'h43, 8'h44, 8'hc4, 8'hde, 8'he9, 8'hcb,
+    8'h54, 8'h7b, 8'h94, 8'h32, 8'ha6, 8'hc2, 8'h23, 8'h3d, 8'hee, 8'h4c, 8'h95, 8'h0b, 8'h42, 8'hfa, 8'hc3, 8'h4e,
+    8'h08, 8'h2e, 8'ha1, 8'h66, 8'h28, 8'hd9, 8'h24, 8'hb2, 8'h76, 8'h5b, 8'ha2, 8'h49, 8'h6d, 8'h8b, 8'hd1, 8'h25,
+    8'h72, 8'hf8, 8'hf6, 8'h64, 8'h86, 8'h68, 8'h98, 8'h16, 8'hd4, 8'ha4, 8'h5c, 8'hcc, 8'h5d, 8'h65, 8'hb6, 8'h92,
+    8'h6c, 8'h70, 8'h48, 8'h50, 8'hfd, 8'hed, 8'hb9, 8'hda, 8'h5e, 8'h15, 8'h46, 8'h57, 8'ha7, 8'h8d, 8'h9d, 8'h84,
+    8'h90, 8'hd8, 8'hab, 8'h00, 8'h8c, 8'hbc, 8'hd3, 8'h0a, 8'hf7, 8'he4, 8'h58, 8'h05, 8'hb8, 8'hb3, 8'h45, 8'h06,
+    8'hd0, 8'h2c, 8'h1e, 8'h8f, 8'hca, 8'h3f, 8'h0f, 8'h02, 8'hc1, 8'haf, 8'hbd, 8'h03, 8'h01, 8'h13, 8'h8a, 8'h6b,
+    8'h3a, 8'h91, 8'h11, 8'h41, 8'h4f, 8'h67, 8'hdc, 8'hea, 8'h97, 8'hf2, 8'hcf, 8'hce, 8'hf0, 8'hb4, 8'he6, 8'h73,
+    8'h96, 8'hac, 8'h74, 8'h22, 8'he7, 8'had, 8'h35, 8'h85, 8'he2, 8'hf9, 8'h37, 8'he8, 8'h1c, 8'h75, 8'hdf, 8'h6e,
+    8'h47, 8'hf1, 8'h1a, 8'h71, 8'h1d, 8'h29, 8'hc5, 8'h89, 8'h6f, 8'hb7, 8'h62, 8'h0e, 8'haa, 8'h18, 8'hbe, 8'h1b,
+    8'hfc, 8'h56, 8'h3e, 8'h4b, 8'hc6, 8'hd2, 8'h79, 8'h20, 8'h9a, 8'hdb, 8'hc0, 8'hfe, 8'h78, 8'hcd, 8'h5a, 8'hf4,
+    8'h1f, 8'hdd, 8'ha8, 8'h33, 8'h88, 8'h07, 8'hc7, 8'h31, 8'hb1, 8'h12, 8'h10, 8'h59, 8'h27, 8'h80, 8'hec, 8'h5f,
+    8'h60, 8'h51, 8'h7f, 8'ha9, 8'h19, 8'hb5, 8'h4a, 8'h0d, 8'h2d, 8'he5, 8'h7a, 8'h9f, 8'h93, 8'hc9, 8'h9c, 8'hef,
+    8'ha0, 8'he0, 8'h3b, 8'h4d, 8'hae, 8'h2a, 8'hf5, 8'hb0, 8'hc8, 8'heb, 8'hbb, 8'h3c, 8'h83, 8'h53, 8'h99, 8'h61,
+    8'h17, 8'h2b, 8'h04, 8'h7e, 8'hba, 8'h77, 8'hd6, 8'h26, 8'he1, 8'h69, 8'h14, 8'h63, 8'h55, 8'h21, 8'h0c, 8'h7d
+};
+
+//-------------------------------------------------------------------------------
+// Local functions
+//-------------------------------------------------------------------------------
+// Blocks are packed as bytes 0..15 in memory order: column c is bytes 4c..4c+3, row r
+// of column c is byte 4c+r
+
+function automatic logic [7:0] aes_xtime (input logic [7:0] b);
+    aes_xtime = {b[6:0], 1'b0} ^ (b[7] ? 8'h1b : 8'h00);
+endfunction : aes_xtime
+
+function automatic logic [31:0] aes_sub_word (input logic [3:0][7:0] w);
+    for (int i = 0; i < 4; i++) begin
+        aes_sub_word[8*i +: 8]  = SCR1_AES_SBOX[w[i]];
+    end
+endfunction : aes_sub_word
+
+function automatic logic [15:0][7:0] aes_sub_bytes (input logic [15:0][7:0] s);
+    for (int i = 0; i < 16; i++) begin
+        aes_sub_bytes[i]    = SCR1_AES_SBOX[s[i]];
+    end
+endfunction : aes_sub_bytes
+
+function automatic logic [15:0][7:0] aes_inv_sub_bytes (input logic [15:0][7:0] s);
+    for (int i = 0; i < 16; i++) begin
+        aes_inv_sub_bytes[i]    = SCR1_AES_INV_SBOX[s[i]];
+    end
+endfunction : aes_inv_sub_bytes
+
+// Row r is rotated left by r columns
+function automatic logic [15:0][7:0] aes_shift_rows (input logic [15:0][7:0] s);
+    for (int c = 0; c < 4; c++) begin
+        for (int r = 0; r < 4; r++) begin
+            aes_shift_rows[4*c+r]   = s[4*((c+r)%4)+r];
+        end
+    end
+endfunction : aes_shift_rows
+
+function automatic logic [15:0][7:0] aes_inv_shift_rows (input logic [15:0][7:0] s);
+    for (int c = 0; c < 4; c++) begin
+        for (int r = 0; r < 4; r++) begin
+            aes_inv_shift_rows[4*c+r]   = s[4*((c+4-r)%4)+r];
+        end
+    end
+endfunction : aes_inv_shift_rows
+
+// Each column is multiplied by {03}x^3 + {01}x^2 + {01}x + {02}
+function automatic logic [15:0][7:0] aes_mix_columns (input logic [15:0][7:0] s);
+    logic [3:0][7:0] a;
+    for (int c = 0; c < 4; c++) begin
+        a   = s[4*c +: 4];
+        for (int r = 0; r < 4; r++) begin
+            aes_mix_columns[4*c+r]  = aes_xtime(a[r]) ^ aes_xtime(a[(r+1)%4]) ^ a[(r+1)%4]
+                                    ^ a[(r+2)%4] ^ a[(r+3)%4];
+        end
+    end
+endfunction : aes_mix_columns
+
+// Each column is multiplied by {0b}x^3 + {0d}x^2 + {09}x + {0e}
+function automatic logic [15:0][7:0] aes_inv_mix_columns (input logic [15:0][7:0] s);
+    logic [3:0][7:0] a;
+    logic [3:0][7:0] x2;
+    logic [3:0][7:0] x4;
+    logic [3:0][7:0] x8;
+    for (int c = 0; c < 4; c++) begin
+        a   = s[4*c +: 4];
+        for (int j = 0; j < 4; j++) begin
+            x2[j]   = aes_xtime(a[j]);
+            x4[j]   = aes_xtime(x2[j]);
+            x8[j]   = aes_xtime(x4[j]);
+        end
+        for (int r = 0; r < 4; r++) begin
+            aes_inv_mix_columns[4*c+r]  = (x8[r]       ^ x4[r]       ^ x2[r]      )     // {0e}
+                                        ^ (x8[(r+1)%4] ^ x2[(r+1)%4] ^ a[(r+1)%4] )     // {0b}
+                                        ^ (x8[(r+2)%4] ^ x4[(r+2)%4] ^ a[(r+2)%4] )     // {0d}
+                                        ^ (x8[(r+3)%4] ^ a[(r+3)%4]               );    // {09}
+        end
+    end
+endfunction : aes_inv_mix_columns
+
+// Big-endian increment: byte 15 is the least significant
+function automatic logic [15:0][7:0] aes_ctr_inc (input logic [15:0][7:0] ctr);
+    logic [127:0] n;
+    for (int i = 0; i < 16; i++) begin
+        n[8*(15-i) +: 8]    = ctr[i];
+    end
+    n   = n + 1'b1;
+    for (int i = 0; i < 16; i++) begin
+        aes_ctr_inc[i]  = n[8*(15-i) +: 8];
+    end
+endfunction : aes_ctr_inc
+
+//-------------------------------------------------------------------------------
+// Local signal declaration
+//-------------------------------------------------------------------------------
+logic                               dmem_rd;
+logic                               dmem_wr;
+logic [`SCR1_DMEM_DWIDTH-1:0]       dmem_writedata;
+logic [`SCR1_DMEM_DWIDTH-1:0]       dmem_rdata_local;
+logic [`SCR1_DMEM_DWIDTH-1:0]       dmem_rdata_reg;
+logic [1:0]                         dmem_rdata_shift_reg;
+
+logic                               ctrl_up;
+logic                               keylen_up;
+logic                               ctr_up;
+logic                               key_up;
+logic                               data_in_up;
+
+logic                               cmd_up;
+logic [3:0]                         cmd;
+logic [3:0]                         cmd_reg;
+logic                               go_bit;
+logic                               done_bit;
+logic                               err_bit;
+logic                               cmd_drop;
+logic                               busy;
+logic [31:0]                        counter;
+
+logic                               key256;
+logic [3:0]                         nr;
+logic [7:0][31:0]                   key;
+logic [3:0][31:0]                   ctr;
+logic [3:0][31:0]                   data_in;
+logic [3:0][31:0]                   data_out;
+
+// Key expansion
+logic [59:0][31:0]                  rk;
+logic [3:0][31:0]                   rk_cur;
+logic [3:0]                         rk_idx;
+logic                               kx_start;
+logic                               kx_active;
+logic                               kx_last;
+logic                               kx_done;
+logic [5:0]                         kx_i;
+logic [2:0]                         kx_pos;
+logic [7:0]                         kx_rcon;
+logic [31:0]                        kx_prev;
+logic [31:0]                        kx_temp;
+
+// Block
+logic                               blk_start;
+logic                               blk_active;
+logic                               blk_last;
+logic                               blk_dec;
+logic                               blk_ctr;
+logic [3:0]                         blk_round;
+logic [3:0][31:0]                   blk_in;
+logic [15:0][7:0]                   blk_state;
+logic [15:0][7:0]                   enc_sr;
+logic [15:0][7:0]                   enc_out;
+logic [15:0][7:0]                   dec_ark;
+logic [15:0][7:0]                   dec_out;
+logic [15:0][7:0]                   round_out;
+
+//-------------------------------------------------------------------------------
+// Core interface
+//-------------------------------------------------------------------------------
+always_ff @(posedge clk, negedge rst_n) begin
+    if (~rst_n) begin
+        dmem_resp   <= SCR1_MEM_RESP_NOTRDY;
+    end else begin
+        dmem_resp   <= dmem_req ? SCR1_MEM_RESP_RDY_OK : SCR1_MEM_RESP_NOTRDY;
+    end
+end
+
+assign dmem_req_ack = 1'b1;
+//-------------------------------------------------------------------------------
+// Memory data composing
+//-------------------------------------------------------------------------------
+assign dmem_rd  = dmem_req & (dmem_cmd == SCR1_MEM_CMD_RD);
+assign dmem_wr  = dmem_req & (dmem_cmd == SCR1_MEM_CMD_WR);
+
+always_comb begin
+    dmem_writedata = dmem_wdata;
+    case ( dmem_width )
+        SCR1_MEM_WIDTH_BYTE : begin
+            dmem_writedata  = {(`SCR1_DMEM_DWIDTH /  8){dmem_wdata[7:0]}};
+        end
+        SCR1_MEM_WIDTH_HWORD : begin
+            dmem_writedata  = {(`SCR1_DMEM_DWIDTH / 16){dmem_wdata[15:0]}};
+        end
+        default : begin
+        end
+    endcase
+end
+
+always_comb begin
+    ctrl_up     = 1'b0;
+    keylen_up   = 1'b0;
+    ctr_up      = 1'b0;
+    key_up      = 1'b0;
+    data_in_up  = 1'b0;
+    if (dmem_wr) begin
+        case (dmem_addr[SCR1_AES_ADDR_WIDTH-1:2])
+            SCR1_AES_CTRL[SCR1_AES_ADDR_WIDTH-1:2]      : ctrl_up   = 1'b1;
+            SCR1_AES_KEYLEN[SCR1_AES_ADDR_WIDTH-1:2]    : keylen_up = 1'b1;
+            default                                     : begin
+                ctr_up      = (dmem_addr[SCR1_AES_ADDR_WIDTH-1:4] == SCR1_AES_CTR[SCR1_AES_ADDR_WIDTH-1:4]);
+                key_up      = (dmem_addr[SCR1_AES_ADDR_WIDTH-1:5] == SCR1_AES_KEY[SCR1_AES_ADDR_WIDTH-1:5]);
+                data_in_up  = (dmem_addr[SCR1_AES_ADDR_WIDTH-1:4] == SCR1_AES_DATA_IN[SCR1_AES_ADDR_WIDTH-1:4]);
+            end
+        endcase
+    end
+end
+
+always_comb begin
+    dmem_rdata_local = '0;
+    case (dmem_addr[SCR1_AES_ADDR_WIDTH-1:2])
+        SCR1_AES_CTRL[SCR1_AES_ADDR_WIDTH-1:2]      : begin
+            dmem_rdata_local[SCR1_AES_CTRL_GO_OFFSET]   = go_bit;
+            dmem_rdata_local[SCR1_AES_CTRL_BUSY_OFFSET] = busy;
+            dmem_rdata_local[SCR1_AES_CTRL_ERR_OFFSET]  = err_bit;
+            dmem_rdata_local[SCR1_AES_CTRL_DONE_OFFSET] = done_bit;
+        end
+        SCR1_AES_COUNTER[SCR1_AES_ADDR_WIDTH-1:2]   : dmem_rdata_local = counter;
+        SCR1_AES_KEYLEN[SCR1_AES_ADDR_WIDTH-1:2]    : dmem_rdata_local = `SCR1_DMEM_DWIDTH'(key256);
+        default                                     : begin
+            if (dmem_addr[SCR1_AES_ADDR_WIDTH-1:4] == SCR1_AES_CTR[SCR1_AES_ADDR_WIDTH-1:4]) begin
+                dmem_rdata_local = ctr[dmem_addr[3:2]];
+            end else if (dmem_addr[SCR1_AES_ADDR_WIDTH-1:4] == SCR1_AES_DATA_IN[SCR1_AES_ADDR_WIDTH-1:4]) begin
+                dmem_rdata_local = data_in[dmem_addr[3:2]];
+            end else if (dmem_addr[SCR1_AES_ADDR_WIDTH-1:4] == SCR1_AES_DATA_OUT[SCR1_AES_ADDR_WIDTH-1:4]) begin
+                dmem_rdata_local = data_out[dmem_addr[3:2]];
+            end
+        end
+    endcase
+end
+
+//-------------------------------------------------------------------------------
+// Control and status
+//-------------------------------------------------------------------------------
+// The command is taken from the bus when idle and kept in cmd_reg for the block that
+// follows a key expansion
+assign cmd_up       = ctrl_up & ~busy;
+assign cmd          = cmd_up ? dmem_writedata[3:0] : cmd_reg;
+assign busy         = kx_active | kx_done | blk_active;
+assign cmd_drop     = ctrl_up & busy & (dmem_writedata[SCR1_AES_CTRL_GO_OFFSET] | dmem_writedata[SCR1_AES_CTRL_KEY_OFFSET]);
+
+always_ff @(posedge clk, negedge rst_n) begin
+    if (~rst_n) begin
+        cmd_reg     <= '0;
+        go_bit      <= 1'b0;
+        done_bit    <= 1'b0;
+        err_bit     <= 1'b0;
+    end else begin
+        if (cmd_up) begin
+            cmd_reg <= cmd;
+        end
+        go_bit      <= cmd_up & cmd[SCR1_AES_CTRL_GO_OFFSET];
+        if (cmd_up & (cmd[SCR1_AES_CTRL_GO_OFFSET] | cmd[SCR1_AES_CTRL_KEY_OFFSET])) begin
+            done_bit    <= 1'b0;
+            err_bit     <= 1'b0;
+        end else begin
+            if (blk_last | (kx_done & ~cmd[SCR1_AES_CTRL_GO_OFFSET])) begin
+                done_bit    <= 1'b1;
+            end
+            if (cmd_drop) begin
+                err_bit     <= 1'b1;
+            end
+        end
+    end
+end
+
+always_ff @(posedge clk, negedge rst_n) begin
+    if (~rst_n) begin
+        counter <= '0;
+    end else begin
+        if (cmd_up & (cmd[SCR1_AES_CTRL_GO_OFFSET] | cmd[SCR1_AES_CTRL_KEY_OFFSET])) begin
+            counter <= '0;
+        end else if (busy) begin
+            counter <= counter + 1'b1;
+        end
+    end
+end
+
+always_ff @(posedge clk, negedge rst_n) begin
+    if (~rst_n) begin
+        key256      <= SCR1_AES_KEYLEN_128;
+        key         <= '0;
+        ctr         <= '0;
+        data_in     <= '0;
+    end else begin
+        if (keylen_up & ~busy) begin
+            key256  <= dmem_writedata[0];
+        end
+        if (key_up) begin
+            key[dmem_addr[4:2]] <= dmem_writedata;
+        end
+        if (blk_last & blk_ctr) begin
+            ctr     <= aes_ctr_inc(ctr);
+        end else if (ctr_up & ~busy) begin
+            ctr[dmem_addr[3:2]] <= dmem_writedata;
+        end
+        if (data_in_up) begin
+            data_in[dmem_addr[3:2]] <= dmem_writedata;
+        end
+    end
+end
+
+assign nr   = key256 ? 4'd14 : 4'd10;
+
+//-------------------------------------------------------------------------------
+// Key expansion
+//-------------------------------------------------------------------------------
+// One word of the key schedule per clock (FIPS-197 KeyExpansion): words 0..Nk-1 are the
+// key, word i is word i-Nk XOR a function of word i-1. Round key r is words 4r..4r+3
+assign kx_start = cmd_up & cmd[SCR1_AES_CTRL_KEY_OFFSET];
+assign kx_last  = kx_active & (kx_i == (key256 ? 6'd59 : 6'd43));
+assign kx_prev  = rk[kx_i - 1'b1];
+
+always_comb begin
+    if (kx_pos == '0) begin
+        // SubWord(RotWord(w)) ^ Rcon, with byte 0 in the low bits
+        kx_temp = aes_sub_word({kx_prev[7:0], kx_prev[31:8]}) ^ {24'd0, kx_rcon};
+    end else if (key256 & (kx_pos == 3'd4)) begin
+        kx_temp = aes_sub_word(kx_prev);
+    end else begin
+        kx_temp = kx_prev;
+    end
+end
+
+always_ff @(posedge clk, negedge rst_n) begin
+    if (~rst_n) begin
+        kx_active   <= 1'b0;
+        kx_done     <= 1'b0;
+        kx_i        <= '0;
+        kx_pos      <= '0;
+        kx_rcon     <= '0;
+    end else begin
+        kx_done     <= kx_last;
+        if (kx_start) begin
+            kx_active   <= 1'b1;
+            kx_i        <= key256 ? 6'd8 : 6'd4;
+            kx_pos      <= '0;
+            kx_rcon     <= 8'h01;
+        end else if (kx_active) begin
+            kx_active   <= ~kx_last;
+            kx_i        <= kx_i + 1'b1;
+            kx_pos      <= (kx_pos == (key256 ? 3'd7 : 3'd3)) ? 3'd0 : kx_pos + 1'b1;
+            if (kx_pos == '0) begin
+                kx_rcon <= aes_xtime(kx_rcon);
+            end
+        end
+    end
+end
+
+always_ff @(posedge clk) begin
+    if (kx_start) begin
+        rk[7:0]     <= key;
+    end else if (kx_active) begin
+        rk[kx_i]    <= rk[kx_i - (key256 ? 6'd8 : 6'd4)] ^ kx_temp;
+    end
+end
+
+//-------------------------------------------------------------------------------
+// Cipher
+//-------------------------------------------------------------------------------
+// The initial AddRoundKey is done when the block starts, then one round per clock
+assign blk_start    = (cmd_up & cmd[SCR1_AES_CTRL_GO_OFFSET] & ~cmd[SCR1_AES_CTRL_KEY_OFFSET])
+                    | (kx_done & cmd[SCR1_AES_CTRL_GO_OFFSET]);
+assign blk_ctr      = cmd[SCR1_AES_CTRL_CTR_OFFSET];
+assign blk_dec      = cmd[SCR1_AES_CTRL_DEC_OFFSET] & ~blk_ctr;
+assign blk_last     = blk_active & (blk_round == nr);
+
+// Round keys are used in reverse order for decryption (FIPS-197 InvCipher)
+assign rk_idx       = blk_active ? (blk_dec ? nr - blk_round : blk_round)
+                                 : (blk_dec ? nr : 4'd0);
+assign rk_cur       = rk[4*rk_idx +: 4];
+
+assign enc_sr       = aes_shift_rows(aes_sub_bytes(blk_state));
+assign enc_out      = (blk_last ? enc_sr : aes_mix_columns(enc_sr)) ^ rk_cur;
+assign dec_ark      = aes_inv_sub_bytes(aes_inv_shift_rows(blk_state)) ^ rk_cur;
+assign dec_out      = blk_last ? dec_ark : aes_inv_mix_columns(dec_ark);
+assign round_out    = blk_dec ? dec_out : enc_out;
+
+always_ff @(posedge clk, negedge rst_n) begin
+    if (~rst_n) begin
+        blk_active  <= 1'b0;
+        blk_round   <= '0;
+        blk_in      <= '0;
+        blk_state   <= '0;
+        data_out    <= '0;
+    end else begin
+        if (blk_start) begin
+            blk_active  <= 1'b1;
+            blk_round   <= 4'd1;
+            blk_in      <= data_in;
+            blk_state   <= (blk_ctr ? ctr : data_in) ^ rk_cur;
+        end else if (blk_active) begin
+            blk_active  <= ~blk_last;
+            blk_round   <= blk_round + 1'b1;
+            blk_state   <= round_out;
+            if (blk_last) begin
+                data_out    <= blk_ctr ? (round_out ^ blk_in) : round_out;
+            end
+        end
+    end
+end
+
+//-------------------------------------------------------------------------------
+// Data memory output generation
+//-------------------------------------------------------------------------------
+always_ff @(posedge clk) begin
+    if (dmem_rd) begin
+        dmem_rdata_reg          <= dmem_rdata_local;
+        dmem_rdata_shift_reg    <= dmem_addr[1:0];
+    end
+end
+
+assign dmem_rdata = dmem_rdata_reg >> ( 8 * dmem_rdata_shift_reg );
+
+endmodule : scr1_aes
@@ -13,7 +13,11 @@ module scr1_dmem_router
     parameter SCR1_PORT2_ADDR_PATTERN   = `SCR1_DMEM_AWIDTH'h00020000,
 	 
 	 parameter SCR1_PORT3_ADDR_MASK      = `SCR1_DMEM_AWIDTH'hFFFF0000,
-    parameter SCR1_PORT3_ADDR_PATTERN   = `SCR1_DMEM_AWIDTH'hF0030000 //F003FFFF
+    parameter SCR1_PORT3_ADDR_PATTERN   = `SCR1_DMEM_AWIDTH'hF0030000, //F003FFFF
+    parameter SCR1_PORT4_ADDR_MASK      = `SCR1_DMEM_AWIDTH'hFFFF0000,
+    parameter SCR1_PORT4_ADDR_PATTERN   = `SCR1_DMEM_AWIDTH'hF0050000,
+    parameter SCR1_PORT5_ADDR_MASK      = `SCR1_DMEM_AWIDTH'hFFFF0000,
+    parameter SCR1_PORT5_ADDR_PATTERN   = `SCR1_DMEM_AWIDTH'hF0060000
 
 )
 (
@@ -72,7 +76,27 @@ module scr1_dmem_router
     output  logic [`SCR1_DMEM_AWIDTH-1:0]   port3_addr,
     output  logic [`SCR1_DMEM_DWIDTH-1:0]   port3_wdata,
     input   logic [`SCR1_DMEM_DWIDTH-1:0]   port3_rdata,
-    input   type_scr1_mem_resp_e            port3_resp
+    input   type_scr1_mem_resp_e            port3_resp,
+
+    // PORT4 interface
+    input   logic                           port4_req_ack,
+    output  logic                           port4_req,
+    output  type_scr1_mem_cmd_e             port4_cmd,
+    output  type_scr1_mem_width_e           port4_width,
+    output  logic [`SCR1_DMEM_AWIDTH-1:0]   port4_addr,
+    output  logic [`SCR1_DMEM_DWIDTH-1:0]   port4_wdata,
+    input   logic [`SCR1_DMEM_DWIDTH-1:0]   port4_rdata,
+    input   type_scr1_mem_resp_e            port4_resp,
+
+    // PORT5 interface
+    input   logic                           port5_req_ack,
+    output  logic                           port5_req,
+    output  type_scr1_mem_cmd_e             port5_cmd,
+    output  type_scr1_mem_width_e           port5_width,
+    output  logic [`SCR1_DMEM_AWIDTH-1:0]   port5_addr,
+    output  logic [`SCR1_DMEM_DWIDTH-1:0]   port5_wdata,
+    input   logic [`SCR1_DMEM_DWIDTH-1:0]   port5_rdata,
+    input   type_scr1_mem_resp_e            port5_resp
 	//**************************************************//
 	//**************************************************//
 	
@@ -86,11 +110,13 @@ typedef enum logic {
     SCR1_FSM_DATA
 } type_scr1_fsm_e;
 
-typedef enum logic [1:0] {
+typedef enum logic [2:0] {
     SCR1_SEL_PORT0,
     SCR1_SEL_PORT1,
     SCR1_SEL_PORT2,
-	 SCR1_SEL_PORT3 	//**************************************************//
+	 SCR1_SEL_PORT3, 	//**************************************************//
+    SCR1_SEL_PORT4,
+    SCR1_SEL_PORT5
 } type_scr1_sel_e;
 
 //-------------------------------------------------------------------------------
@@ -114,6 +140,10 @@ always_comb begin
         port_sel    = SCR1_SEL_PORT2;
     end else if ((dmem_addr & SCR1_PORT3_ADDR_MASK) == SCR1_PORT3_ADDR_PATTERN) begin
         port_sel    = SCR1_SEL_PORT3;
+    end else if ((dmem_addr & SCR1_PORT4_ADDR_MASK) == SCR1_PORT4_ADDR_PATTERN) begin
+        port_sel    = SCR1_SEL_PORT4;
+    end else if ((dmem_addr & SCR1_PORT5_ADDR_MASK) == SCR1_PORT5_ADDR_PATTERN) begin
+        port_sel    = SCR1_SEL_PORT5;
     end 
 end
 
@@ -159,6 +189,8 @@ always_comb begin
             SCR1_SEL_PORT1  : sel_req_ack   = port1_req_ack;
             SCR1_SEL_PORT2  : sel_req_ack   = port2_req_ack;
 			SCR1_SEL_PORT3  : sel_req_ack   = port3_req_ack; //**********//
+            SCR1_SEL_PORT4  : sel_req_ack   = port4_req_ack;
+            SCR1_SEL_PORT5  : sel_req_ack   = port5_req_ack;
             default         : sel_req_ack   = 1'b0;
         endcase
     end else begin
@@ -184,6 +216,14 @@ always_comb begin
             sel_rdata   = port3_rdata;
             sel_resp    = port3_resp;
         end
+        SCR1_SEL_PORT4  : begin
+            sel_rdata   = port4_rdata;
+            sel_resp    = port4_resp;
+        end
+        SCR1_SEL_PORT5  : begin
+            sel_rdata   = port5_rdata;
+            sel_resp    = port5_resp;
+        end
 		  
         default         : begin
             sel_rdata   = '0;
@@ -324,6 +364,68 @@ assign port3_addr   = dmem_addr ;
 assign port3_wdata  = dmem_wdata;
 `endif // SCR1_XPROP_EN
 
+//-------------------------------------------------------------------------------
+// Interface to PORT4
+//-------------------------------------------------------------------------------
+always_comb begin
+    port4_req = 1'b0;
+    case (fsm)
+        SCR1_FSM_ADDR : begin
+            port4_req = dmem_req & (port_sel == SCR1_SEL_PORT4);
+        end
+        SCR1_FSM_DATA : begin
+            if (sel_resp == SCR1_MEM_RESP_RDY_OK) begin
+                port4_req = dmem_req & (port_sel == SCR1_SEL_PORT4);
+            end
+        end
+        default : begin
+        end
+    endcase
+end
+
+`ifdef SCR1_XPROP_EN
+assign port4_cmd    = (port_sel == SCR1_SEL_PORT4) ? dmem_cmd   : SCR1_MEM_CMD_ERROR;
+assign port4_width  = (port_sel == SCR1_SEL_PORT4) ? dmem_width : SCR1_MEM_WIDTH_ERROR;
+assign port4_addr   = (port_sel == SCR1_SEL_PORT4) ? dmem_addr  : 'x;
+assign port4_wdata  = (port_sel == SCR1_SEL_PORT4) ? dmem_wdata : 'x;
+`else // SCR1_XPROP_EN
+assign port4_cmd    = dmem_cmd  ;
+assign port4_width  = dmem_width;
+assign port4_addr   = dmem_addr ;
+assign port4_wdata  = dmem_wdata;
+`endif // SCR1_XPROP_EN
+
+//-------------------------------------------------------------------------------
+// Interface to PORT5
+//-------------------------------------------------------------------------------
+always_comb begin
+    port5_req = 1'b0;
+    case (fsm)
+        SCR1_FSM_ADDR : begin
+            port5_req = dmem_req & (port_sel == SCR1_SEL_PORT5);
+        end
+        SCR1_FSM_DATA : begin
+            if (sel_resp == SCR1_MEM_RESP_RDY_OK) begin
+                port5_req = dmem_req & (port_sel == SCR1_SEL_PORT5);
+            end
+        end
+        default : begin
+        end
+    endcase
+end
+
+`ifdef SCR1_XPROP_EN
+assign port5_cmd    = (port_sel == SCR1_SEL_PORT5) ? dmem_cmd   : SCR1_MEM_CMD_ERROR;
+assign port5_width  = (port_sel == SCR1_SEL_PORT5) ? dmem_width : SCR1_MEM_WIDTH_ERROR;
+assign port5_addr   = (port_sel == SCR1_SEL_PORT5) ? dmem_addr  : 'x;
+assign port5_wdata  = (port_sel == SCR1_SEL_PORT5) ? dmem_wdata : 'x;
+`else // SCR1_XPROP_EN
+assign port5_cmd    = dmem_cmd  ;
+assign port5_width  = dmem_width;
+assign port5_addr   = dmem_addr ;
+assign port5_wdata  = dmem_wdata;
+`endif // SCR1_XPROP_EN
+
 
 `ifdef SCR1_TRGT_SIMULATION
 //-------------------------------------------------------------------------------
@@ -0,0 +1,512 @@
+/// Copyright by Syntacore LLC © 2016-2021. See LICENSE for details
+/// @file       <scr1_mont.sv>
+/// @brief      Memory-mapped Montgomery modular multiplier
+///
+/// Register map (word registers, offsets from the multiplier base):
+///   0x000       CTRL     W: [0] GO (R = A * B * 2^(-32 * NWORDS) mod N),
+///                           [1] SQR (A is used as both operands, B is not read),
+///                           [2] TO_A (the result is also written into A)
+///                        R: [0] go, [1] busy, [31] done (cleared by the next GO)
+///                        Writes while busy are ignored: poll CTRL.done before the next GO
+///   0x004       COUNTER  cycles spent on the last multiplication: (NWORDS + 1) * (NWORDS + 2),
+///                        plus NWORDS + 1 when the final subtraction is not needed
+///   0x008       NWORDS   operand length in 32-bit words, 2..64 (64- to 2048-bit operands),
+///                        written when idle
+///   0x00C       NINV     -N^(-1) mod 2^32, written when idle
+///   0x100-0x1FC A        operand RAMs, least significant word first; A and B must be below N
+///   0x200-0x2FC B
+///   0x300-0x3FC N        odd modulus
+///   0x400-0x4FC R        result (read-only)
+///
+/// The operand RAMs have one read and one write port each, shared with the bus while idle:
+/// RAM writes are ignored and RAM reads return undefined data while busy.
+///
+/// The product is computed word-serially (finely integrated operand scanning): for each word
+/// a[i], m = (t[0] + a[i] * b[0]) * NINV mod 2^32 and then t = (t + a[i] * B + m * N) / 2^32
+/// in one pass of NWORDS cycles with two 32x32 multipliers, followed by a pass that subtracts
+/// N when t >= N. With TO_A, modular exponentiation keeps the accumulator in A: squaring is
+/// SQR|TO_A|GO and multiplication by the base held in B is TO_A|GO, with no copies over the bus.
+///
+
+`include "scr1_memif.svh"
+`include "scr1_arch_description.svh"
+`include "scr1_mont.svh"
+
+module scr1_mont
+(
+    // Control signals
+    input   logic                           clk,
+    input   logic                           rst_n,
+
+    // Core data interface
+    output  logic                           dmem_req_ack,
+    input   logic                           dmem_req,
+    input   type_scr1_mem_cmd_e             dmem_cmd,
+    input   type_scr1_mem_width_e           dmem_width,
+    input   logic [`SCR1_DMEM_AWIDTH-1:0]   dmem_addr,
+    input   logic [`SCR1_DMEM_DWIDTH-1:0]   dmem_wdata,
+    output  logic [`SCR1_DMEM_DWIDTH-1:0]   dmem_rdata,
+    output  type_scr1_mem_resp_e            dmem_resp
+);
+
+//-------------------------------------------------------------------------------
+// Local types declaration
+//-------------------------------------------------------------------------------
+typedef enum logic [2:0] {
+    SCR1_MONT_FSM_IDLE,
+    SCR1_MONT_FSM_INIT,                     // read b[0]
+    SCR1_MONT_FSM_MLOAD,                    // read a[i] and t[0]
+    SCR1_MONT_FSM_MCALC,                    // m = (t[0] + a[i] * b[0]) * NINV
+    SCR1_MONT_FSM_LOOP,                     // t = (t + a[i] * B + m * N) / 2^32
+    SCR1_MONT_FSM_SUB,                      // R = t - N
+    SCR1_MONT_FSM_COPY                      // R = t, when t < N
+} type_scr1_mont_fsm_e;
+
+//-------------------------------------------------------------------------------
+// Local signal declaration
+//-------------------------------------------------------------------------------
+logic                               dmem_rd;
+logic                               dmem_wr;
+logic [`SCR1_DMEM_DWIDTH-1:0]       dmem_writedata;
+logic [`SCR1_DMEM_DWIDTH-1:0]       dmem_rdata_local;
+logic [`SCR1_DMEM_DWIDTH-1:0]       dmem_rdata_reg;
+logic [1:0]                         dmem_rdata_shift_reg;
+logic [2:0]                         dmem_ram;
+logic [2:0]                         dmem_ram_reg;
+logic [SCR1_MONT_IDX_WIDTH-1:0]     dmem_idx;
+
+logic                               ctrl_up;
+logic                               nwords_up;
+logic                               ninv_up;
+
+logic                               cmd_up;
+logic                               go_bit_in;
+logic                               go_bit;
+logic                               done_bit;
+logic                               done_bit_in;
+logic                               busy;
+logic [31:0]                        counter;
+logic                               cmd_sqr;
+logic                               cmd_to_a;
+
+logic [SCR1_MONT_IDX_WIDTH:0]       nwords;
+logic [31:0]                        ninv;
+
+// Engine
+type_scr1_mont_fsm_e                fsm;
+logic [SCR1_MONT_IDX_WIDTH:0]       i;
+logic [SCR1_MONT_IDX_WIDTH:0]       j;
+logic                               i_last;
+logic                               j_last;
+logic [SCR1_MONT_IDX_WIDTH-1:0]     op_idx;
+logic [31:0]                        a_i;
+logic [31:0]                        b0;
+logic [31:0]                        m;
+logic [31:0]                        m_sum;
+logic [31:0]                        b_j;
+logic [63:0]                        ab;
+logic [63:0]                        mn;
+logic [31:0]                        t_j;
+logic [65:0]                        sum;
+logic [33:0]                        carry;
+logic [34:0]                        top_sum;
+logic [2:0]                         t_top;
+logic                               top_we;
+logic [32:0]                        diff;
+logic                               borrow;
+logic                               t_lt_n;
+logic                               res_we;
+logic [31:0]                        res;
+
+// Operand RAMs
+logic [31:0]                        a_ram [SCR1_MONT_MAX_WORDS];
+logic [31:0]                        b_ram [SCR1_MONT_MAX_WORDS];
+logic [31:0]                        n_ram [SCR1_MONT_MAX_WORDS];
+logic [31:0]                        t_ram [SCR1_MONT_MAX_WORDS];
+logic [31:0]                        r_ram [SCR1_MONT_MAX_WORDS];
+
+logic                               a_re;
+logic [SCR1_MONT_IDX_WIDTH-1:0]     a_raddr;
+logic [31:0]                        a_q;
+logic                               a_we;
+logic [SCR1_MONT_IDX_WIDTH-1:0]     a_waddr;
+logic [31:0]                        a_wdata;
+logic                               b_re;
+logic [SCR1_MONT_IDX_WIDTH-1:0]     b_raddr;
+logic [31:0]                        b_q;
+logic                               n_re;
+logic [SCR1_MONT_IDX_WIDTH-1:0]     n_raddr;
+logic [31:0]                        n_q;
+logic                               t_re;
+logic [SCR1_MONT_IDX_WIDTH-1:0]     t_raddr;
+logic [31:0]                        t_q;
+logic                               t_we;
+logic [SCR1_MONT_IDX_WIDTH-1:0]     t_waddr;
+logic [31:0]                        t_wdata;
+logic                               r_re;
+logic [31:0]                        r_q;
+
+//-------------------------------------------------------------------------------
+// Core interface
+//-------------------------------------------------------------------------------
+always_ff @(posedge clk, negedge rst_n) begin
+    if (~rst_n) begin
+        dmem_resp   <= SCR1_MEM_RESP_NOTRDY;
+    end else begin
+        dmem_resp   <= dmem_req ? SCR1_MEM_RESP_RDY_OK : SCR1_MEM_RESP_NOTRDY;
+    end
+end
+
+assign dmem_req_ack = 1'b1;
+//-------------------------------------------------------------------------------
+// Memory data composing
+//-------------------------------------------------------------------------------
+assign dmem_rd  = dmem_req & (dmem_cmd == SCR1_MEM_CMD_RD);
+assign dmem_wr  = dmem_req & (dmem_cmd == SCR1_MEM_CMD_WR);
+
+always_comb begin
+    dmem_writedata = dmem_wdata;
+    case ( dmem_width )
+        SCR1_MEM_WIDTH_BYTE : begin
+            dmem_writedata  = {(`SCR1_DMEM_DWIDTH /  8){dmem_wdata[7:0]}};
+        end
+        SCR1_MEM_WIDTH_HWORD : begin
+            dmem_writedata  = {(`SCR1_DMEM_DWIDTH / 16){dmem_wdata[15:0]}};
+        end
+        default : begin
+        end
+    endcase
+end
+
+// Operand RAM window and word index of the access (dmem_ram is 0 for the registers)
+assign dmem_ram = dmem_addr[SCR1_MONT_ADDR_WIDTH-1:8];
+assign dmem_idx = dmem_addr[SCR1_MONT_IDX_WIDTH+1:2];
+
+always_comb begin
+    ctrl_up     = 1'b0;
+    nwords_up   = 1'b0;
+    ninv_up     = 1'b0;
+    if (dmem_wr & (dmem_ram == '0)) begin
+        case (dmem_addr[7:2])
+            SCR1_MONT_CTRL[7:2]     : ctrl_up   = 1'b1;
+            SCR1_MONT_NWORDS[7:2]   : nwords_up = 1'b1;
+            SCR1_MONT_NINV[7:2]     : ninv_up   = 1'b1;
+            default                 : begin end
+        endcase
+    end
+end
+
+always_comb begin
+    dmem_rdata_local = '0;
+    case (dmem_addr[7:2])
+        SCR1_MONT_CTRL[7:2]     : begin
+            dmem_rdata_local[SCR1_MONT_CTRL_GO_OFFSET]      = go_bit;
+            dmem_rdata_local[SCR1_MONT_CTRL_BUSY_OFFSET]    = busy;
+            dmem_rdata_local[SCR1_MONT_CTRL_DONE_OFFSET]    = done_bit;
+        end
+        SCR1_MONT_COUNTER[7:2]  : dmem_rdata_local = counter;
+        SCR1_MONT_NWORDS[7:2]   : dmem_rdata_local = `SCR1_DMEM_DWIDTH'(nwords);
+        SCR1_MONT_NINV[7:2]     : dmem_rdata_local = ninv;
+        default                 : begin end
+    endcase
+end
+
+//-------------------------------------------------------------------------------
+// Control and status
+//-------------------------------------------------------------------------------
+assign busy         = (fsm != SCR1_MONT_FSM_IDLE);
+assign cmd_up       = ctrl_up & ~busy;
+assign go_bit_in    = cmd_up & dmem_writedata[SCR1_MONT_CTRL_GO_OFFSET];
+assign done_bit_in  = ((fsm == SCR1_MONT_FSM_SUB) & j_last & ~t_lt_n)
+                    |  ((fsm == SCR1_MONT_FSM_COPY) & j_last);
+
+always_ff @(posedge clk, negedge rst_n) begin
+    if (~rst_n) begin
+        go_bit      <= 1'b0;
+        done_bit    <= 1'b0;
+        cmd_sqr     <= 1'b0;
+        cmd_to_a    <= 1'b0;
+    end else begin
+        go_bit      <= go_bit_in;
+        if (go_bit_in) begin
+            done_bit    <= 1'b0;
+            cmd_sqr     <= dmem_writedata[SCR1_MONT_CTRL_SQR_OFFSET];
+            cmd_to_a    <= dmem_writedata[SCR1_MONT_CTRL_TO_A_OFFSET];
+        end else if (done_bit_in) begin
+            done_bit    <= 1'b1;
+        end
+    end
+end
+
+always_ff @(posedge clk, negedge rst_n) begin
+    if (~rst_n) begin
+        counter <= '0;
+    end else begin
+        if (go_bit_in) begin
+            counter <= '0;
+        end else if (busy) begin
+            counter <= counter + 1'b1;
+        end
+    end
+end
+
+always_ff @(posedge clk, negedge rst_n) begin
+    if (~rst_n) begin
+        nwords  <= (SCR1_MONT_IDX_WIDTH+1)'(SCR1_MONT_MAX_WORDS);
+        ninv    <= '0;
+    end else if (~busy) begin
+        if (nwords_up) begin
+            if (dmem_writedata < 2) begin
+                nwords  <= (SCR1_MONT_IDX_WIDTH+1)'(2);
+            end else if (dmem_writedata > SCR1_MONT_MAX_WORDS) begin
+                nwords  <= (SCR1_MONT_IDX_WIDTH+1)'(SCR1_MONT_MAX_WORDS);
+            end else begin
+                nwords  <= dmem_writedata[SCR1_MONT_IDX_WIDTH:0];
+            end
+        end
+        if (ninv_up) begin
+            ninv    <= dmem_writedata;
+        end
+    end
+end
+
+//-------------------------------------------------------------------------------
+// Engine control
+//-------------------------------------------------------------------------------
+// The RAMs have registered read data: the word of index j is read in the cycle before
+// it is used, so LOOP reads j + 1 while computing j, and SUB/COPY read j while writing
+// the result word j - 1
+assign i_last   = (i == nwords - 1'b1);
+assign j_last   = (fsm == SCR1_MONT_FSM_LOOP) ? (j == nwords - 1'b1) : (j == nwords);
+assign op_idx   = (fsm == SCR1_MONT_FSM_LOOP) ? SCR1_MONT_IDX_WIDTH'(j + 1'b1)
+                : ((fsm == SCR1_MONT_FSM_SUB) | (fsm == SCR1_MONT_FSM_COPY)) ? SCR1_MONT_IDX_WIDTH'(j)
+                : '0;
+
+always_ff @(posedge clk, negedge rst_n) begin
+    if (~rst_n) begin
+        fsm     <= SCR1_MONT_FSM_IDLE;
+        i       <= '0;
+        j       <= '0;
+    end else begin
+        case (fsm)
+            SCR1_MONT_FSM_IDLE  : begin
+                if (go_bit_in) begin
+                    fsm <= SCR1_MONT_FSM_INIT;
+                end
+                i   <= '0;
+                j   <= '0;
+            end
+            SCR1_MONT_FSM_INIT  : fsm <= SCR1_MONT_FSM_MLOAD;
+            SCR1_MONT_FSM_MLOAD : fsm <= SCR1_MONT_FSM_MCALC;
+            SCR1_MONT_FSM_MCALC : fsm <= SCR1_MONT_FSM_LOOP;
+            SCR1_MONT_FSM_LOOP  : begin
+                if (j_last) begin
+                    fsm <= i_last ? SCR1_MONT_FSM_SUB : SCR1_MONT_FSM_MLOAD;
+                    i   <= i + 1'b1;
+                    j   <= '0;
+                end else begin
+                    j   <= j + 1'b1;
+                end
+            end
+            SCR1_MONT_FSM_SUB   : begin
+                if (j_last) begin
+                    // t < N: the result is t itself
+                    fsm <= t_lt_n ? SCR1_MONT_FSM_COPY : SCR1_MONT_FSM_IDLE;
+                    j   <= '0;
+                end else begin
+                    j   <= j + 1'b1;
+                end
+            end
+            SCR1_MONT_FSM_COPY  : begin
+                if (j_last) begin
+                    fsm <= SCR1_MONT_FSM_IDLE;
+                end else begin
+                    j   <= j + 1'b1;
+                end
+            end
+            default             : fsm <= SCR1_MONT_FSM_IDLE;
+        endcase
+    end
+end
+
+//-------------------------------------------------------------------------------
+// Datapath
+//-------------------------------------------------------------------------------
+// t is zero before the first outer iteration, so its stale RAM contents are masked
+assign t_j      = (i == '0) ? '0 : t_q;
+assign b_j      = cmd_sqr ? a_q : b_q;
+assign m_sum    = t_j + a_q * b0;
+assign ab       = a_i * b_j;
+assign mn       = m * n_q;
+assign sum      = 66'(t_j) + 66'(ab) + 66'(mn) + 66'(carry);
+
+// The carry out of the last word of a pass goes into the top word of t while the next
+// pass starts reading
+assign top_we   = ((fsm == SCR1_MONT_FSM_MLOAD) & (i != '0)) | ((fsm == SCR1_MONT_FSM_SUB) & (j == '0));
+assign top_sum  = 35'(t_top) + 35'(carry);
+
+assign diff     = {1'b0, t_q} - {1'b0, n_q} - 33'(borrow);
+assign t_lt_n   = diff[32] & (t_top == '0);     // final borrow, valid in the last SUB cycle
+assign res_we   = ((fsm == SCR1_MONT_FSM_SUB) | (fsm == SCR1_MONT_FSM_COPY)) & (j != '0);
+assign res      = (fsm == SCR1_MONT_FSM_SUB) ? diff[31:0] : t_q;
+
+always_ff @(posedge clk, negedge rst_n) begin
+    if (~rst_n) begin
+        a_i     <= '0;
+        b0      <= '0;
+        m       <= '0;
+        carry   <= '0;
+        t_top   <= '0;
+        borrow  <= 1'b0;
+    end else begin
+        case (fsm)
+            SCR1_MONT_FSM_IDLE  : begin
+                t_top   <= '0;
+            end
+            SCR1_MONT_FSM_MLOAD : begin
+                if (i == '0) begin
+                    b0  <= b_j;
+                end
+            end
+            SCR1_MONT_FSM_MCALC : begin
+                a_i     <= a_q;
+                m       <= m_sum * ninv;
+                carry   <= '0;
+            end
+            SCR1_MONT_FSM_LOOP  : begin
+                carry   <= sum[65:32];
+                borrow  <= 1'b0;
+            end
+            SCR1_MONT_FSM_SUB   : begin
+                if (j != '0) begin
+                    borrow  <= diff[32];
+                end
+            end
+            default             : begin end
+        endcase
+        if (top_we) begin
+            t_top   <= top_sum[34:32];
+        end
+    end
+end
+
+//-------------------------------------------------------------------------------
+// Operand RAMs
+//-------------------------------------------------------------------------------
+always_comb begin
+    a_re    = 1'b0;
+    b_re    = 1'b0;
+    n_re    = 1'b0;
+    t_re    = 1'b0;
+    r_re    = 1'b0;
+    a_raddr = op_idx;
+    case (fsm)
+        SCR1_MONT_FSM_IDLE  : begin
+            a_re    = dmem_rd & (dmem_ram == SCR1_MONT_RAM_A);
+            b_re    = dmem_rd & (dmem_ram == SCR1_MONT_RAM_B);
+            n_re    = dmem_rd & (dmem_ram == SCR1_MONT_RAM_N);
+            r_re    = dmem_rd & (dmem_ram == SCR1_MONT_RAM_R);
+            a_raddr = dmem_idx;
+        end
+        SCR1_MONT_FSM_INIT,
+        SCR1_MONT_FSM_MCALC,
+        SCR1_MONT_FSM_LOOP  : begin
+            a_re    = cmd_sqr;
+            b_re    = ~cmd_sqr;
+            n_re    = 1'b1;
+            t_re    = (fsm != SCR1_MONT_FSM_INIT);
+        end
+        SCR1_MONT_FSM_MLOAD : begin
+            a_re    = 1'b1;
+            t_re    = 1'b1;
+            a_raddr = SCR1_MONT_IDX_WIDTH'(i);
+        end
+        SCR1_MONT_FSM_SUB,
+        SCR1_MONT_FSM_COPY  : begin
+            n_re    = 1'b1;
+            t_re    = 1'b1;
+        end
+        default             : begin end
+    endcase
+end
+
+assign b_raddr  = busy ? op_idx : dmem_idx;
+assign n_raddr  = busy ? op_idx : dmem_idx;
+assign t_raddr  = op_idx;
+
+// A is written by the bus when idle and by TO_A with the result
+assign a_we     = busy ? (res_we & cmd_to_a) : (dmem_wr & (dmem_ram == SCR1_MONT_RAM_A));
+assign a_waddr  = busy ? SCR1_MONT_IDX_WIDTH'(j - 1'b1) : dmem_idx;
+assign a_wdata  = busy ? res : dmem_writedata;
+
+assign t_we     = top_we | ((fsm == SCR1_MONT_FSM_LOOP) & (j != '0));
+assign t_waddr  = top_we ? SCR1_MONT_IDX_WIDTH'(nwords - 1'b1) : SCR1_MONT_IDX_WIDTH'(j - 1'b1);
+assign t_wdata  = top_we ? top_sum[31:0] : sum[31:0];
+
+always_ff @(posedge clk) begin
+    if (a_we) begin
+        a_ram[a_waddr]  <= a_wdata;
+    end
+    if (a_re) begin
+        a_q <= a_ram[a_raddr];
+    end
+end
+
+always_ff @(posedge clk) begin
+    if (~busy & dmem_wr & (dmem_ram == SCR1_MONT_RAM_B)) begin
+        b_ram[dmem_idx] <= dmem_writedata;
+    end
+    if (b_re) begin
+        b_q <= b_ram[b_raddr];
+    end
+end
+
+always_ff @(posedge clk) begin
+    if (~busy & dmem_wr & (dmem_ram == SCR1_MONT_RAM_N)) begin
+        n_ram[dmem_idx] <= dmem_writedata;
+    end
+    if (n_re) begin
+        n_q <= n_ram[n_raddr];
+    end
+end
+
+always_ff @(posedge clk) begin
+    if (t_we) begin
+        t_ram[t_waddr]  <= t_wdata;
+    end
+    if (t_re) begin
+        t_q <= t_ram[t_raddr];
+    end
+end
+
+always_ff @(posedge clk) begin
+    if (res_we) begin
+        r_ram[SCR1_MONT_IDX_WIDTH'(j - 1'b1)]   <= res;
+    end
+    if (r_re) begin
+        r_q <= r_ram[dmem_idx];
+    end
+end
+
+//-------------------------------------------------------------------------------
+// Data memory output generation
+//-------------------------------------------------------------------------------
+always_ff @(posedge clk) begin
+    if (dmem_rd) begin
+        dmem_rdata_reg          <= dmem_rdata_local;
+        dmem_rdata_shift_reg    <= dmem_addr[1:0];
+        dmem_ram_reg            <= dmem_ram;
+    end
+end
+
+always_comb begin
+    case (dmem_ram_reg)
+        SCR1_MONT_RAM_A : dmem_rdata = a_q >> ( 8 * dmem_rdata_shift_reg );
+        SCR1_MONT_RAM_B : dmem_rdata = b_q >> ( 8 * dmem_rdata_shift_reg );
+        SCR1_MONT_RAM_N : dmem_rdata = n_q >> ( 8 * dmem_rdata_shift_reg );
+        SCR1_MONT_RAM_R : dmem_rdata = r_q >> ( 8 * dmem_rdata_shift_reg );
+        default         : dmem_rdata = dmem_rdata_reg >> ( 8 * dmem_rdata_shift_reg );
+    endcase
+end
+
+endmodule : scr1_mont
@@ -31,7 +31,16 @@ module scr1_tcm
     input   logic [`SCR1_DMEM_AWIDTH-1:0]   dmem_addr,
     input   logic [`SCR1_DMEM_DWIDTH-1:0]   dmem_wdata,
     output  logic [`SCR1_DMEM_DWIDTH-1:0]   dmem_rdata,
-    output  type_scr1_mem_resp_e            dmem_resp
+    output  type_scr1_mem_resp_e            dmem_resp,
+
+    // DMA interface (shares the data port, core data requests have priority)
+    output  logic                           dma_req_ack,
+    input   logic                           dma_req,
+    input   type_scr1_mem_cmd_e             dma_cmd,
+    input   logic [`SCR1_DMEM_AWIDTH-1:0]   dma_addr,
+    input   logic [`SCR1_DMEM_DWIDTH-1:0]   dma_wdata,
+    output  logic [`SCR1_DMEM_DWIDTH-1:0]   dma_rdata,
+    output  type_scr1_mem_resp_e            dma_resp
 );
 
 //-------------------------------------------------------------------------------
@@ -46,6 +55,15 @@ logic [`SCR1_DMEM_DWIDTH-1:0]       dmem_writedata;
 logic [`SCR1_DMEM_DWIDTH-1:0]       dmem_rdata_local;
 logic [3:0]                         dmem_byteen;
 logic [1:0]                         dmem_rdata_shift_reg;
+logic                               dma_grant;
+logic                               dma_hit;
+logic                               dma_rd;
+logic                               dma_wr;
+logic                               portb_rd;
+logic                               portb_wr;
+logic [3:0]                         portb_byteen;
+logic [`SCR1_DMEM_AWIDTH-1:0]       portb_addr;
+logic [`SCR1_DMEM_DWIDTH-1:0]       portb_writedata;
 //-------------------------------------------------------------------------------
 // Core interface
 //-------------------------------------------------------------------------------
@@ -68,8 +86,19 @@ always_ff @(posedge clk, negedge rst_n) begin
     end
 end
 
+always_ff @(posedge clk, negedge rst_n) begin
+    if (~rst_n) begin
+        dma_resp <= SCR1_MEM_RESP_NOTRDY;
+    end else begin
+        dma_resp <= ~dma_grant ? SCR1_MEM_RESP_NOTRDY
+                  : dma_hit    ? SCR1_MEM_RESP_RDY_OK
+                               : SCR1_MEM_RESP_RDY_ER;
+    end
+end
+
 assign imem_req_ack = 1'b1;
 assign dmem_req_ack = 1'b1;
+assign dma_req_ack  = ~dmem_req;
 //-------------------------------------------------------------------------------
 // Memory data composing
 //-------------------------------------------------------------------------------
@@ -77,6 +106,14 @@ assign imem_rd  = imem_req;
 assign dmem_rd  = dmem_req & (dmem_cmd == SCR1_MEM_CMD_RD);
 assign dmem_wr  = dmem_req & (dmem_cmd == SCR1_MEM_CMD_WR);
 
+// DMA requests are granted in the cycles the core leaves the data port idle.
+// The DMA port is not behind the router, so its address is matched here: an
+// address outside the TCM is answered with RDY_ER and does not touch the memory
+assign dma_grant    = dma_req & ~dmem_req;
+assign dma_hit      = ((dma_addr & SCR1_TCM_ADDR_MASK) == SCR1_TCM_ADDR_PATTERN);
+assign dma_rd       = dma_grant & dma_hit & (dma_cmd == SCR1_MEM_CMD_RD);
+assign dma_wr       = dma_grant & dma_hit & (dma_cmd == SCR1_MEM_CMD_WR);
+
 always_comb begin
     dmem_writedata = dmem_wdata;
     dmem_byteen    = 4'b1111;
@@ -93,6 +130,12 @@ always_comb begin
         end
     endcase
 end
+
+assign portb_rd         = dmem_rd | dma_rd;
+assign portb_wr         = dmem_wr | dma_wr;
+assign portb_byteen     = dmem_req ? dmem_byteen    : 4'b1111;
+assign portb_addr       = dmem_req ? dmem_addr      : dma_addr;
+assign portb_writedata  = dmem_req ? dmem_writedata : dma_wdata;
 //-------------------------------------------------------------------------------
 // Memory instantiation
 //-------------------------------------------------------------------------------
@@ -106,14 +149,14 @@ scr1_dp_memory #(
     .rena   ( imem_rd                               ),
     .addra  ( imem_addr[$clog2(SCR1_TCM_SIZE)-1:2]  ),
     .qa     ( imem_rdata                            ),
-    // Data port
+    // Data and DMA port
     // Port B
-    .renb   ( dmem_rd                               ),
-    .wenb   ( dmem_wr                               ),
-    .webb   ( dmem_byteen                           ),
-    .addrb  ( dmem_addr[$clog2(SCR1_TCM_SIZE)-1:2]  ),
+    .renb   ( portb_rd                              ),
+    .wenb   ( portb_wr                              ),
+    .webb   ( portb_byteen                          ),
+    .addrb  ( portb_addr[$clog2(SCR1_TCM_SIZE)-1:2] ),
     .qb     ( dmem_rdata_local                      ),
-    .datab  ( dmem_writedata                        )
+    .datab  ( portb_writedata                       )
 );
 //-------------------------------------------------------------------------------
 // Data memory output generation
@@ -125,6 +168,7 @@ always_ff @(posedge clk) begin
 end
 
 assign dmem_rdata = dmem_rdata_local >> ( 8 * dmem_rdata_shift_reg );
+assign dma_rdata  = dmem_rdata_local;
 
 endmodule : scr1_tcm
 
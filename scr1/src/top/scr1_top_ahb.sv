@@ -166,6 +166,58 @@ logic [`SCR1_DMEM_DWIDTH-1:0]                       accel_dmem_wdata;
 logic [`SCR1_DMEM_DWIDTH-1:0]                       accel_dmem_rdata;
 type_scr1_mem_resp_e                                accel_dmem_resp;
 
+`ifdef SCR1_ACCEL_EXT_BUS
+// AHB-Lite interface from the ACCEL bridge to the ACCEL slave
+logic [3:0]                                         accel_hprot;
+logic [2:0]                                         accel_hburst;
+logic [2:0]                                         accel_hsize;
+logic [1:0]                                         accel_htrans;
+logic                                               accel_hmastlock;
+logic [SCR1_AHB_WIDTH-1:0]                          accel_haddr;
+logic                                               accel_hwrite;
+logic [SCR1_AHB_WIDTH-1:0]                          accel_hwdata;
+logic                                               accel_hready;
+logic [SCR1_AHB_WIDTH-1:0]                          accel_hrdata;
+logic                                               accel_hresp;
+`endif // SCR1_ACCEL_EXT_BUS
+
+// DMA interface from ACCEL to TCM
+logic                                               accel_dma_req_ack;
+logic                                               accel_dma_req;
+type_scr1_mem_cmd_e                                 accel_dma_cmd;
+logic [`SCR1_DMEM_AWIDTH-1:0]                       accel_dma_addr;
+logic [`SCR1_DMEM_DWIDTH-1:0]                       accel_dma_wdata;
+logic [`SCR1_DMEM_DWIDTH-1:0]                       accel_dma_rdata;
+type_scr1_mem_resp_e                                accel_dma_resp;
+
+// Data memory interface from router to AES
+logic                                               aes_dmem_req_ack;
+logic                                               aes_dmem_req;
+type_scr1_mem_cmd_e                                 aes_dmem_cmd;
+type_scr1_mem_width_e                               aes_dmem_width;
+logic [`SCR1_DMEM_AWIDTH-1:0]                       aes_dmem_addr;
+logic [`SCR1_DMEM_DWIDTH-1:0]                       aes_dmem_wdata;
+logic [`SCR1_DMEM_DWIDTH-1:0]                       aes_dmem_rdata;
+type_scr1_mem_resp_e                                aes_dmem_resp;
+
+// Data memory interface from router to the Montgomery multiplier
+logic                                               mont_dmem_req_ack;
+logic                                               mont_dmem_req;
+type_scr1_mem_cmd_e                                 mont_dmem_cmd;
+type_scr1_mem_width_e                               mont_dmem_width;
+logic [`SCR1_DMEM_AWIDTH-1:0]                       mont_dmem_addr;
+logic [`SCR1_DMEM_DWIDTH-1:0]                       mont_dmem_wdata;
+logic [`SCR1_DMEM_DWIDTH-1:0]                       mont_dmem_rdata;
+type_scr1_mem_resp_e                                mont_dmem_resp;
+
+// ACCEL completion interrupt merged into the core IRQ inputs
+logic                                               accel_irq;
+`ifdef SCR1_IPIC_EN
+logic [SCR1_IRQ_LINES_NUM-1:0]                      core_irq_lines;
+`else // SCR1_IPIC_EN
+logic                                               core_ext_irq;
+`endif // SCR1_IPIC_EN
+
 
 
 
@@ -232,6 +284,15 @@ scr1_reset_and2_cell i_tapc_rstn_and2_cell (
 );
 `endif // SCR1_DBG_EN
 
+//-------------------------------------------------------------------------------
+// IRQ
+//-------------------------------------------------------------------------------
+`ifdef SCR1_IPIC_EN
+assign core_irq_lines   = irq_lines | (SCR1_IRQ_LINES_NUM'(accel_irq) << `SCR1_ACCEL_IRQ_LINE);
+`else // SCR1_IPIC_EN
+assign core_ext_irq     = ext_irq | accel_irq;
+`endif // SCR1_IPIC_EN
+
 //-------------------------------------------------------------------------------
 // SCR1 core instance
 //-------------------------------------------------------------------------------
@@ -258,9 +319,9 @@ scr1_core_top i_core_top (
 
     // IRQ
 `ifdef SCR1_IPIC_EN
-    .core_irq_lines_i           (irq_lines        ),
+    .core_irq_lines_i           (core_irq_lines   ),
 `else // SCR1_IPIC_EN
-    .core_irq_ext_i             (ext_irq          ),
+    .core_irq_ext_i             (core_ext_irq     ),
 `endif // SCR1_IPIC_EN
     .core_irq_soft_i            (soft_irq         ),
     .core_irq_mtimer_i          (timer_irq        ),
@@ -323,15 +384,114 @@ scr1_tcm #(
     .dmem_addr      (tcm_dmem_addr   ),
     .dmem_wdata     (tcm_dmem_wdata  ),
     .dmem_rdata     (tcm_dmem_rdata  ),
-    .dmem_resp      (tcm_dmem_resp   )
+    .dmem_resp      (tcm_dmem_resp   ),
+
+    // DMA interface from ACCEL
+    .dma_req_ack    (accel_dma_req_ack),
+    .dma_req        (accel_dma_req    ),
+    .dma_cmd        (accel_dma_cmd    ),
+    .dma_addr       (accel_dma_addr   ),
+    .dma_wdata      (accel_dma_wdata  ),
+    .dma_rdata      (accel_dma_rdata  ),
+    .dma_resp       (accel_dma_resp   )
 );
+`else // SCR1_TCM_EN
+// No TCM to fetch from: DMA requests are completed with an error
+assign accel_dma_req_ack    = 1'b1;
+assign accel_dma_rdata      = '0;
+always_ff @(posedge clk, negedge core_rst_n_local) begin
+    if (~core_rst_n_local) begin
+        accel_dma_resp  <= SCR1_MEM_RESP_NOTRDY;
+    end else begin
+        accel_dma_resp  <= accel_dma_req ? SCR1_MEM_RESP_RDY_ER : SCR1_MEM_RESP_NOTRDY;
+    end
+end
 `endif // SCR1_TCM_EN
 
 //`ifdef SCR1_ACCEL_EN
+`ifdef SCR1_ACCEL_EXT_BUS
+//-------------------------------------------------------------------------------
+// ACCEL AHB bridge
+//-------------------------------------------------------------------------------
+scr1_dmem_ahb i_accel_dmem_ahb (
+    .rst_n          (core_rst_n_local  ),
+    .clk            (clk               ),
+    // Interface to dmem router
+    .dmem_req_ack   (accel_dmem_req_ack),
+    .dmem_req       (accel_dmem_req    ),
+    .dmem_cmd       (accel_dmem_cmd    ),
+    .dmem_width     (accel_dmem_width  ),
+    .dmem_addr      (accel_dmem_addr   ),
+    .dmem_wdata     (accel_dmem_wdata  ),
+    .dmem_rdata     (accel_dmem_rdata  ),
+    .dmem_resp      (accel_dmem_resp   ),
+    // AHB interface
+    .hprot          (accel_hprot       ),
+    .hburst         (accel_hburst      ),
+    .hsize          (accel_hsize       ),
+    .htrans         (accel_htrans      ),
+    .hmastlock      (accel_hmastlock   ),
+    .haddr          (accel_haddr       ),
+    .hwrite         (accel_hwrite      ),
+    .hwdata         (accel_hwdata      ),
+    .hready         (accel_hready      ),
+    .hrdata         (accel_hrdata      ),
+    .hresp          (accel_hresp       )
+);
+
 //-------------------------------------------------------------------------------
 // ACCEL instance
 //-------------------------------------------------------------------------------
-scr1_accel (
+scr1_accel_ahb #(
+    .SCR1_ACCEL_SHA256_RPC    (`SCR1_ACCEL_SHA256_RPC),
+    .SCR1_ACCEL_SHA256_LANES  (`SCR1_ACCEL_SHA256_LANES),
+`ifdef SCR1_TCM_EN
+    .SCR1_ACCEL_TCM_EN        (1'b1)
+`else // SCR1_TCM_EN
+    .SCR1_ACCEL_TCM_EN        (1'b0)
+`endif // SCR1_TCM_EN
+) i_accel (
+    .rst_n          (core_rst_n_local),
+    .clk            (clk             ),
+
+    // AHB-Lite interface to ACCEL (single slave: HREADY is its own HREADYOUT)
+    .hsel           (1'b1              ),
+    .haddr          (accel_haddr       ),
+    .htrans         (accel_htrans      ),
+    .hsize          (accel_hsize       ),
+    .hburst         (accel_hburst      ),
+    .hwrite         (accel_hwrite      ),
+    .hwdata         (accel_hwdata      ),
+    .hready         (accel_hready      ),
+    .hreadyout      (accel_hready      ),
+    .hrdata         (accel_hrdata      ),
+    .hresp          (accel_hresp       ),
+
+    // DMA interface to TCM
+    .dma_req_ack    (accel_dma_req_ack ),
+    .dma_req        (accel_dma_req     ),
+    .dma_cmd        (accel_dma_cmd     ),
+    .dma_addr       (accel_dma_addr    ),
+    .dma_wdata      (accel_dma_wdata   ),
+    .dma_rdata      (accel_dma_rdata   ),
+    .dma_resp       (accel_dma_resp    ),
+
+    // Completion interrupt
+    .irq            (accel_irq         )
+);
+`else // SCR1_ACCEL_EXT_BUS
+//-------------------------------------------------------------------------------
+// ACCEL instance
+//-------------------------------------------------------------------------------
+scr1_accel #(
+    .SCR1_ACCEL_SHA256_RPC    (`SCR1_ACCEL_SHA256_RPC),
+    .SCR1_ACCEL_SHA256_LANES  (`SCR1_ACCEL_SHA256_LANES),
+`ifdef SCR1_TCM_EN
+    .SCR1_ACCEL_TCM_EN        (1'b1)
+`else // SCR1_TCM_EN
+    .SCR1_ACCEL_TCM_EN        (1'b0)
+`endif // SCR1_TCM_EN
+) i_accel (
     .clk            (clk             ),
     .rst_n          (core_rst_n_local),
 
@@ -343,7 +503,56 @@ scr1_accel (
     .dmem_addr      (accel_dmem_addr   ),
     .dmem_wdata     (accel_dmem_wdata  ),
     .dmem_rdata     (accel_dmem_rdata  ),
-    .dmem_resp      (accel_dmem_resp   )
+    .dmem_resp      (accel_dmem_resp   ),
+
+    // DMA interface to TCM
+    .dma_req_ack    (accel_dma_req_ack ),
+    .dma_req        (accel_dma_req     ),
+    .dma_cmd        (accel_dma_cmd     ),
+    .dma_addr       (accel_dma_addr    ),
+    .dma_wdata      (accel_dma_wdata   ),
+    .dma_rdata      (accel_dma_rdata   ),
+    .dma_resp       (accel_dma_resp    ),
+
+    // Completion interrupt
+    .irq            (accel_irq         )
+);
+`endif // SCR1_ACCEL_EXT_BUS
+
+//-------------------------------------------------------------------------------
+// AES instance
+//-------------------------------------------------------------------------------
+scr1_aes i_aes (
+    .clk            (clk             ),
+    .rst_n          (core_rst_n_local),
+
+    // Data interface to AES
+    .dmem_req_ack   (aes_dmem_req_ack),
+    .dmem_req       (aes_dmem_req    ),
+    .dmem_cmd       (aes_dmem_cmd    ),
+    .dmem_width     (aes_dmem_width  ),
+    .dmem_addr      (aes_dmem_addr   ),
+    .dmem_wdata     (aes_dmem_wdata  ),
+    .dmem_rdata     (aes_dmem_rdata  ),
+    .dmem_resp      (aes_dmem_resp   )
+);
+
+//-------------------------------------------------------------------------------
+// Montgomery multiplier instance
+//-------------------------------------------------------------------------------
+scr1_mont i_mont (
+    .clk            (clk              ),
+    .rst_n          (core_rst_n_local ),
+
+    // Data interface to the Montgomery multiplier
+    .dmem_req_ack   (mont_dmem_req_ack),
+    .dmem_req       (mont_dmem_req    ),
+    .dmem_cmd       (mont_dmem_cmd    ),
+    .dmem_width     (mont_dmem_width  ),
+    .dmem_addr      (mont_dmem_addr   ),
+    .dmem_wdata     (mont_dmem_wdata  ),
+    .dmem_rdata     (mont_dmem_rdata  ),
+    .dmem_resp      (mont_dmem_resp   )
 );
 //`endif // SCR1_ACCEL_EN
 
@@ -434,12 +643,17 @@ scr1_dmem_router #(
 `endif // SCR1_TCM_EN
 
 //`ifdef SCR1_ACCEL_EN
-	.SCR1_PORT3_ADDR_MASK       (SCR1_PORT3_ADDR_MASK),
-	.SCR1_PORT3_ADDR_PATTERN    (SCR1_PORT3_ADDR_PATTERN),
+	.SCR1_PORT3_ADDR_MASK       (SCR1_ACCEL_ADDR_MASK),
+	.SCR1_PORT3_ADDR_PATTERN    (SCR1_ACCEL_ADDR_PATTERN),
 //`endif // SCR1_ACCEL_EN
 
     .SCR1_PORT2_ADDR_MASK       (SCR1_TIMER_ADDR_MASK),
-    .SCR1_PORT2_ADDR_PATTERN    (SCR1_TIMER_ADDR_PATTERN)
+    .SCR1_PORT2_ADDR_PATTERN    (SCR1_TIMER_ADDR_PATTERN),
+
+    .SCR1_PORT4_ADDR_MASK       (SCR1_AES_ADDR_MASK),
+    .SCR1_PORT4_ADDR_PATTERN    (SCR1_AES_ADDR_PATTERN),
+    .SCR1_PORT5_ADDR_MASK       (SCR1_MONT_ADDR_MASK),
+    .SCR1_PORT5_ADDR_PATTERN    (SCR1_MONT_ADDR_PATTERN)
 	
 
 
@@ -495,6 +709,26 @@ scr1_dmem_router #(
     .port3_wdata    (accel_dmem_wdata    ),
     .port3_rdata    (accel_dmem_rdata    ),
     .port3_resp     (accel_dmem_resp     ),
+
+    // Interface to memory-mapped AES
+    .port4_req_ack  (aes_dmem_req_ack    ),
+    .port4_req      (aes_dmem_req        ),
+    .port4_cmd      (aes_dmem_cmd        ),
+    .port4_width    (aes_dmem_width      ),
+    .port4_addr     (aes_dmem_addr       ),
+    .port4_wdata    (aes_dmem_wdata      ),
+    .port4_rdata    (aes_dmem_rdata      ),
+    .port4_resp     (aes_dmem_resp       ),
+
+    // Interface to the memory-mapped Montgomery multiplier
+    .port5_req_ack  (mont_dmem_req_ack   ),
+    .port5_req      (mont_dmem_req       ),
+    .port5_cmd      (mont_dmem_cmd       ),
+    .port5_width    (mont_dmem_width     ),
+    .port5_addr     (mont_dmem_addr      ),
+    .port5_wdata    (mont_dmem_wdata     ),
+    .port5_rdata    (mont_dmem_rdata     ),
+    .port5_resp     (mont_dmem_resp      ),
 	
 	
 	
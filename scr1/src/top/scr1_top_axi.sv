@@ -221,6 +221,74 @@ logic [`SCR1_DMEM_DWIDTH-1:0]                       tcm_dmem_rdata;
 type_scr1_mem_resp_e                                tcm_dmem_resp;
 `endif // SCR1_TCM_EN
 
+// Data memory interface from router to ACCEL
+logic                                               accel_dmem_req_ack;
+logic                                               accel_dmem_req;
+type_scr1_mem_cmd_e                                 accel_dmem_cmd;
+type_scr1_mem_width_e                               accel_dmem_width;
+logic [`SCR1_DMEM_AWIDTH-1:0]                       accel_dmem_addr;
+logic [`SCR1_DMEM_DWIDTH-1:0]                       accel_dmem_wdata;
+logic [`SCR1_DMEM_DWIDTH-1:0]                       accel_dmem_rdata;
+type_scr1_mem_resp_e                                accel_dmem_resp;
+
+// AXI interface from the ACCEL bridge to the ACCEL slave
+logic [31:0]                                        accel_awaddr;
+logic [ 2:0]                                        accel_awprot;
+logic                                               accel_awvalid;
+logic                                               accel_awready;
+logic [31:0]                                        accel_wdata;
+logic [3:0]                                         accel_wstrb;
+logic                                               accel_wvalid;
+logic                                               accel_wready;
+logic [ 1:0]                                        accel_bresp;
+logic                                               accel_bvalid;
+logic                                               accel_bready;
+logic [31:0]                                        accel_araddr;
+logic [ 2:0]                                        accel_arprot;
+logic                                               accel_arvalid;
+logic                                               accel_arready;
+logic [31:0]                                        accel_rdata;
+logic [ 1:0]                                        accel_rresp;
+logic                                               accel_rvalid;
+logic                                               accel_rready;
+
+// DMA interface from ACCEL to TCM
+logic                                               accel_dma_req_ack;
+logic                                               accel_dma_req;
+type_scr1_mem_cmd_e                                 accel_dma_cmd;
+logic [`SCR1_DMEM_AWIDTH-1:0]                       accel_dma_addr;
+logic [`SCR1_DMEM_DWIDTH-1:0]                       accel_dma_wdata;
+logic [`SCR1_DMEM_DWIDTH-1:0]                       accel_dma_rdata;
+type_scr1_mem_resp_e                                accel_dma_resp;
+
+// Data memory interface from router to AES
+logic                                               aes_dmem_req_ack;
+logic                                               aes_dmem_req;
+type_scr1_mem_cmd_e                                 aes_dmem_cmd;
+type_scr1_mem_width_e                               aes_dmem_width;
+logic [`SCR1_DMEM_AWIDTH-1:0]                       aes_dmem_addr;
+logic [`SCR1_DMEM_DWIDTH-1:0]                       aes_dmem_wdata;
+logic [`SCR1_DMEM_DWIDTH-1:0]                       aes_dmem_rdata;
+type_scr1_mem_resp_e                                aes_dmem_resp;
+
+// Data memory interface from router to the Montgomery multiplier
+logic                                               mont_dmem_req_ack;
+logic                                               mont_dmem_req;
+type_scr1_mem_cmd_e                                 mont_dmem_cmd;
+type_scr1_mem_width_e                               mont_dmem_width;
+logic [`SCR1_DMEM_AWIDTH-1:0]                       mont_dmem_addr;
+logic [`SCR1_DMEM_DWIDTH-1:0]                       mont_dmem_wdata;
+logic [`SCR1_DMEM_DWIDTH-1:0]                       mont_dmem_rdata;
+type_scr1_mem_resp_e                                mont_dmem_resp;
+
+// ACCEL completion interrupt merged into the core IRQ inputs
+logic                                               accel_irq;
+`ifdef SCR1_IPIC_EN
+logic [SCR1_IRQ_LINES_NUM-1:0]                      core_irq_lines;
+`else // SCR1_IPIC_EN
+logic                                               core_ext_irq;
+`endif // SCR1_IPIC_EN
+
 // Data memory interface from router to memory-mapped timer
 logic                                               timer_dmem_req_ack;
 logic                                               timer_dmem_req;
@@ -293,6 +361,15 @@ assign axi_rst_n = sys_rst_n_o;
 assign axi_rst_n = rst_n_sync;
 `endif // SCR1_DBG_EN
 
+//-------------------------------------------------------------------------------
+// IRQ
+//-------------------------------------------------------------------------------
+`ifdef SCR1_IPIC_EN
+assign core_irq_lines   = irq_lines | (SCR1_IRQ_LINES_NUM'(accel_irq) << `SCR1_ACCEL_IRQ_LINE);
+`else // SCR1_IPIC_EN
+assign core_ext_irq     = ext_irq | accel_irq;
+`endif // SCR1_IPIC_EN
+
 //-------------------------------------------------------------------------------
 // SCR1 core instance
 //-------------------------------------------------------------------------------
@@ -319,9 +396,9 @@ scr1_core_top i_core_top (
 
     // IRQ
 `ifdef SCR1_IPIC_EN
-    .core_irq_lines_i           (irq_lines        ),
+    .core_irq_lines_i           (core_irq_lines   ),
 `else // SCR1_IPIC_EN
-    .core_irq_ext_i             (ext_irq          ),
+    .core_irq_ext_i             (core_ext_irq     ),
 `endif // SCR1_IPIC_EN
     .core_irq_soft_i            (soft_irq         ),
     .core_irq_mtimer_i          (timer_irq        ),
@@ -384,10 +461,193 @@ scr1_tcm #(
     .dmem_addr      (tcm_dmem_addr   ),
     .dmem_wdata     (tcm_dmem_wdata  ),
     .dmem_rdata     (tcm_dmem_rdata  ),
-    .dmem_resp      (tcm_dmem_resp   )
+    .dmem_resp      (tcm_dmem_resp   ),
+
+    // DMA interface from ACCEL
+    .dma_req_ack    (accel_dma_req_ack),
+    .dma_req        (accel_dma_req    ),
+    .dma_cmd        (accel_dma_cmd    ),
+    .dma_addr       (accel_dma_addr   ),
+    .dma_wdata      (accel_dma_wdata  ),
+    .dma_rdata      (accel_dma_rdata  ),
+    .dma_resp       (accel_dma_resp   )
 );
+`else // SCR1_TCM_EN
+// No TCM to fetch from: DMA requests are completed with an error
+assign accel_dma_req_ack    = 1'b1;
+assign accel_dma_rdata      = '0;
+always_ff @(posedge clk, negedge core_rst_n_local) begin
+    if (~core_rst_n_local) begin
+        accel_dma_resp  <= SCR1_MEM_RESP_NOTRDY;
+    end else begin
+        accel_dma_resp  <= accel_dma_req ? SCR1_MEM_RESP_RDY_ER : SCR1_MEM_RESP_NOTRDY;
+    end
+end
 `endif // SCR1_TCM_EN
 
+//-------------------------------------------------------------------------------
+// ACCEL AXI bridge
+//-------------------------------------------------------------------------------
+// Single-beat AXI4 requests with fixed IDs, so the AXI4-Lite slave below is enough
+scr1_mem_axi #(
+`ifdef SCR1_DMEM_AXI_REQ_BP
+    .SCR1_AXI_REQ_BP    (1),
+`else // SCR1_DMEM_AXI_REQ_BP
+    .SCR1_AXI_REQ_BP    (0),
+`endif // SCR1_DMEM_AXI_REQ_BP
+`ifdef SCR1_DMEM_AXI_RESP_BP
+    .SCR1_AXI_RESP_BP   (1)
+`else // SCR1_DMEM_AXI_RESP_BP
+    .SCR1_AXI_RESP_BP   (0)
+`endif // SCR1_DMEM_AXI_RESP_BP
+) i_accel_mem_axi (
+    .clk            (clk                    ),
+    .rst_n          (core_rst_n_local       ),
+    .axi_reinit     (1'b0                   ),
+
+    // Interface to dmem router
+    .core_idle      (                       ),
+    .core_req_ack   (accel_dmem_req_ack     ),
+    .core_req       (accel_dmem_req         ),
+    .core_cmd       (accel_dmem_cmd         ),
+    .core_width     (accel_dmem_width       ),
+    .core_addr      (accel_dmem_addr        ),
+    .core_wdata     (accel_dmem_wdata       ),
+    .core_rdata     (accel_dmem_rdata       ),
+    .core_resp      (accel_dmem_resp        ),
+
+    // AXI I/O
+    .awid           (                       ),
+    .awaddr         (accel_awaddr           ),
+    .awlen          (                       ),
+    .awsize         (                       ),
+    .awburst        (                       ),
+    .awlock         (                       ),
+    .awcache        (                       ),
+    .awprot         (accel_awprot           ),
+    .awregion       (                       ),
+    .awuser         (                       ),
+    .awqos          (                       ),
+    .awvalid        (accel_awvalid          ),
+    .awready        (accel_awready          ),
+    .wdata          (accel_wdata            ),
+    .wstrb          (accel_wstrb            ),
+    .wlast          (                       ),
+    .wuser          (                       ),
+    .wvalid         (accel_wvalid           ),
+    .wready         (accel_wready           ),
+    .bid            ('0                     ),
+    .bresp          (accel_bresp            ),
+    .bvalid         (accel_bvalid           ),
+    .buser          ('0                     ),
+    .bready         (accel_bready           ),
+    .arid           (                       ),
+    .araddr         (accel_araddr           ),
+    .arlen          (                       ),
+    .arsize         (                       ),
+    .arburst        (                       ),
+    .arlock         (                       ),
+    .arcache        (                       ),
+    .arprot         (accel_arprot           ),
+    .arregion       (                       ),
+    .aruser         (                       ),
+    .arqos          (                       ),
+    .arvalid        (accel_arvalid          ),
+    .arready        (accel_arready          ),
+    .rid            ('0                     ),
+    .rdata          (accel_rdata            ),
+    .rresp          (accel_rresp            ),
+    .rlast          (1'b1                   ),
+    .ruser          ('0                     ),
+    .rvalid         (accel_rvalid           ),
+    .rready         (accel_rready           )
+);
+
+//-------------------------------------------------------------------------------
+// ACCEL instance
+//-------------------------------------------------------------------------------
+scr1_accel_axi #(
+    .SCR1_ACCEL_SHA256_RPC    (`SCR1_ACCEL_SHA256_RPC),
+    .SCR1_ACCEL_SHA256_LANES  (`SCR1_ACCEL_SHA256_LANES),
+`ifdef SCR1_TCM_EN
+    .SCR1_ACCEL_TCM_EN        (1'b1)
+`else // SCR1_TCM_EN
+    .SCR1_ACCEL_TCM_EN        (1'b0)
+`endif // SCR1_TCM_EN
+) i_accel (
+    .clk            (clk             ),
+    .rst_n          (core_rst_n_local),
+
+    // AXI4-Lite interface to ACCEL
+    .awaddr         (accel_awaddr      ),
+    .awprot         (accel_awprot      ),
+    .awvalid        (accel_awvalid     ),
+    .awready        (accel_awready     ),
+    .wdata          (accel_wdata       ),
+    .wstrb          (accel_wstrb       ),
+    .wvalid         (accel_wvalid      ),
+    .wready         (accel_wready      ),
+    .bresp          (accel_bresp       ),
+    .bvalid         (accel_bvalid      ),
+    .bready         (accel_bready      ),
+    .araddr         (accel_araddr      ),
+    .arprot         (accel_arprot      ),
+    .arvalid        (accel_arvalid     ),
+    .arready        (accel_arready     ),
+    .rdata          (accel_rdata       ),
+    .rresp          (accel_rresp       ),
+    .rvalid         (accel_rvalid      ),
+    .rready         (accel_rready      ),
+
+    // DMA interface to TCM
+    .dma_req_ack    (accel_dma_req_ack ),
+    .dma_req        (accel_dma_req     ),
+    .dma_cmd        (accel_dma_cmd     ),
+    .dma_addr       (accel_dma_addr    ),
+    .dma_wdata      (accel_dma_wdata   ),
+    .dma_rdata      (accel_dma_rdata   ),
+    .dma_resp       (accel_dma_resp    ),
+
+    // Completion interrupt
+    .irq            (accel_irq         )
+);
+
+//-------------------------------------------------------------------------------
+// AES instance
+//-------------------------------------------------------------------------------
+scr1_aes i_aes (
+    .clk            (clk             ),
+    .rst_n          (core_rst_n_local),
+
+    // Data interface to AES
+    .dmem_req_ack   (aes_dmem_req_ack),
+    .dmem_req       (aes_dmem_req    ),
+    .dmem_cmd       (aes_dmem_cmd    ),
+    .dmem_width     (aes_dmem_width  ),
+    .dmem_addr      (aes_dmem_addr   ),
+    .dmem_wdata     (aes_dmem_wdata  ),
+    .dmem_rdata     (aes_dmem_rdata  ),
+    .dmem_resp      (aes_dmem_resp   )
+);
+
+//-------------------------------------------------------------------------------
+// Montgomery multiplier instance
+//-------------------------------------------------------------------------------
+scr1_mont i_mont (
+    .clk            (clk              ),
+    .rst_n          (core_rst_n_local ),
+
+    // Data interface to the Montgomery multiplier
+    .dmem_req_ack   (mont_dmem_req_ack),
+    .dmem_req       (mont_dmem_req    ),
+    .dmem_cmd       (mont_dmem_cmd    ),
+    .dmem_width     (mont_dmem_width  ),
+    .dmem_addr      (mont_dmem_addr   ),
+    .dmem_wdata     (mont_dmem_wdata  ),
+    .dmem_rdata     (mont_dmem_rdata  ),
+    .dmem_resp      (mont_dmem_resp   )
+);
+
 
 //-------------------------------------------------------------------------------
 // Memory-mapped timer instance
@@ -476,7 +736,15 @@ scr1_dmem_router #(
 `endif // SCR1_TCM_EN
 
     .SCR1_PORT2_ADDR_MASK       (SCR1_TIMER_ADDR_MASK),
-    .SCR1_PORT2_ADDR_PATTERN    (SCR1_TIMER_ADDR_PATTERN)
+    .SCR1_PORT2_ADDR_PATTERN    (SCR1_TIMER_ADDR_PATTERN),
+
+    .SCR1_PORT3_ADDR_MASK       (SCR1_ACCEL_ADDR_MASK),
+    .SCR1_PORT3_ADDR_PATTERN    (SCR1_ACCEL_ADDR_PATTERN),
+
+    .SCR1_PORT4_ADDR_MASK       (SCR1_AES_ADDR_MASK),
+    .SCR1_PORT4_ADDR_PATTERN    (SCR1_AES_ADDR_PATTERN),
+    .SCR1_PORT5_ADDR_MASK       (SCR1_MONT_ADDR_MASK),
+    .SCR1_PORT5_ADDR_PATTERN    (SCR1_MONT_ADDR_PATTERN)
 
 ) i_dmem_router (
     .rst_n          (core_rst_n_local    ),
@@ -523,6 +791,36 @@ scr1_dmem_router #(
     .port2_rdata    (timer_dmem_rdata    ),
     .port2_resp     (timer_dmem_resp     ),
 
+    // Interface to memory-mapped ACCEL
+    .port3_req_ack  (accel_dmem_req_ack  ),
+    .port3_req      (accel_dmem_req      ),
+    .port3_cmd      (accel_dmem_cmd      ),
+    .port3_width    (accel_dmem_width    ),
+    .port3_addr     (accel_dmem_addr     ),
+    .port3_wdata    (accel_dmem_wdata    ),
+    .port3_rdata    (accel_dmem_rdata    ),
+    .port3_resp     (accel_dmem_resp     ),
+
+    // Interface to memory-mapped AES
+    .port4_req_ack  (aes_dmem_req_ack    ),
+    .port4_req      (aes_dmem_req        ),
+    .port4_cmd      (aes_dmem_cmd        ),
+    .port4_width    (aes_dmem_width      ),
+    .port4_addr     (aes_dmem_addr       ),
+    .port4_wdata    (aes_dmem_wdata      ),
+    .port4_rdata    (aes_dmem_rdata      ),
+    .port4_resp     (aes_dmem_resp       ),
+
+    // Interface to the memory-mapped Montgomery multiplier
+    .port5_req_ack  (mont_dmem_req_ack   ),
+    .port5_req      (mont_dmem_req       ),
+    .port5_cmd      (mont_dmem_cmd       ),
+    .port5_width    (mont_dmem_width     ),
+    .port5_addr     (mont_dmem_addr      ),
+    .port5_wdata    (mont_dmem_wdata     ),
+    .port5_rdata    (mont_dmem_rdata     ),
+    .port5_resp     (mont_dmem_resp      ),
+
     // Interface to AXI bridge
     .port0_req_ack  (axi_dmem_req_ack    ),
     .port0_req      (axi_dmem_req        ),
@@ -0,0 +1,461 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "csr.h"
+
+#define uchar unsigned char
+#define uint unsigned int
+
+// AES-128 by default, KEYLEN=256 in the Makefile selects AES-256
+#ifndef AES_KEYLEN
+#define AES_KEYLEN 128
+#endif
+
+#define AES_NK (AES_KEYLEN / 32)
+#define AES_NR (AES_NK + 6)
+
+#define XTIME(x) ((uchar)(((x) << 1) ^ (((x) >> 7) * 0x1b)))
+
+#ifdef AES_ACCEL
+// Memory-mapped AES accelerator (scr1_aes)
+#define AES_BASE		0xF0050000
+#define AES_REG(off)		(*(volatile uint *)(AES_BASE + (off)))
+#define AES_CTRL		0x00
+#define AES_COUNTER		0x04
+#define AES_KEYLEN_REG		0x08
+#define AES_CTR(i)		(0x10 + 4 * (i))
+#define AES_KEY(i)		(0x20 + 4 * (i))
+#define AES_DATA_IN(i)		(0x40 + 4 * (i))
+#define AES_DATA_OUT(i)		(0x50 + 4 * (i))
+
+#define AES_CTRL_GO		(1u << 0)
+#define AES_CTRL_KEY		(1u << 1)
+#define AES_CTRL_DEC		(1u << 2)
+#define AES_CTRL_CTR		(1u << 3)
+#define AES_CTRL_DONE		(1u << 31)
+
+// CTRL writes are ignored while the accelerator is busy, so every GO and KEY is
+// followed by a wait for done
+#define AES_WAIT()		while (!(AES_REG(AES_CTRL) & AES_CTRL_DONE))
+#endif
+
+typedef struct {
+	uchar rk[16 * (AES_NR + 1)];
+} AES_CTX;
+
+static const uchar sbox[256] = {
+	0x63, 0x7c, 0x77, 0x7b, 0xf2, 0x6b, 0x6f, 0xc5, 0x30, 0x01, 0x67, 0x2b, 0xfe, 0xd7, 0xab, 0x76,
+	0xca, 0x82, 0xc9, 0x7d, 0xfa, 0x59, 0x47, 0xf0, 0xad, 0xd4, 0xa2, 0xaf, 0x9c, 0xa4, 0x72, 0xc0,
+	0xb7, 0xfd, 0x93, 0x26, 0x36, 0x3f, 0xf7, 0xcc, 0x34, 0xa5, 0xe5, 0xf1, 0x71, 0xd8, 0x31, 0x15,
+	0x04, 0xc7, 0x23, 0xc3, 0x18, 0x96, 0x05, 0x9a, 0x07, 0x12, 0x80, 0xe2, 0xeb, 0x27, 0xb2, 0x75,
+	0x09, 0x83, 0x2c, 0x1a, 0x1b, 0x6e, 0x5a, 0xa0, 0x52, 0x3b, 0xd6, 0xb3, 0x29, 0xe3, 0x2f, 0x84,
+	0x53, 0xd1, 0x00, 0xed, 0x20, 0xfc, 0xb1, 0x5b, 0x6a, 0xcb, 0xbe, 0x39, 0x4a, 0x4c, 0x58, 0xcf,
+	0xd0, 0xef, 0xaa, 0xfb, 0x43, 0x4d, 0x33, 0x85, 0x45, 0xf9, 0x02, 0x7f, 0x50, 0x3c, 0x9f, 0xa8,
+	0x51, 0xa3, 0x40, 0x8f, 0x92, 0x9d, 0x38, 0xf5, 0xbc, 0xb6, 0xda, 0x21, 0x10, 0xff, 0xf3, 0xd2,
+	0xcd, 0x0c, 0x13, 0xec, 0x5f, 0x97, 0x44, 0x17, 0xc4, 0xa7, 0x7e, 0x3d, 0x64, 0x5d, 0x19, 0x73,
+	0x60, 0x81, 0x4f, 0xdc, 0x22, 0x2a, 0x90, 0x88, 0x46, 0xee, 0xb8, 0x14, 0xde, 0x5e, 0x0b, 0xdb,
+	0xe0, 0x32, 0x3a, 0x0a, 0x49, 0x06, 0x24, 0x5c, 0xc2, 0xd3, 0xac, 0x62, 0x91, 0x95, 0xe4, 0x79,
+	0xe7, 0xc8, 0x37, 0x6d, 0x8d, 0xd5, 0x4e, 0xa9, 0x6c, 0x56, 0xf4, 0xea, 0x65, 0x7a, 0xae, 0x08,
+	0xba, 0x78, 0x25, 0x2e, 0x1c, 0xa6, 0xb4, 0xc6, 0xe8, 0xdd, 0x74, 0x1f, 0x4b, 0xbd, 0x8b, 0x8a,
+	0x70, 0x3e, 0xb5, 0x66, 0x48, 0x03, 0xf6, 0x0e, 0x61, 0x35, 0x57, 0xb9, 0x86, 0xc1, 0x1d, 0x9e,
+	0xe1, 0xf8, 0x98, 0x11, 0x69, 0xd9, 0x8e, 0x94, 0x9b, 0x1e, 0x87, 0xe9, 0xce, 0x55, 0x28, 0xdf,
+	0x8c, 0xa1, 0x89, 0x0d, 0xbf, 0xe6, 0x42, 0x68, 0x41, 0x99, 0x2d, 0x0f, 0xb0, 0x54, 0xbb, 0x16
+};
+
+static const uchar rsbox[256] = {
+	0x52, 0x09, 0x6a, 0xd5, 0x30, 0x36, 0xa5, 0x38, 0xbf, 0x40, 0xa3, 0x9e, 0x81, 0xf3, 0xd7, 0xfb,
+	0x7c, 0xe3, 0x39, 0x82, 0x9b, 0x2f, 0xff, 0x87, 0x34, 0x8e, 0x43, 0x44, 0xc4, 0xde, 0xe9, 0xcb,
+	0x54, 0x7b, 0x94, 0x32, 0xa6, 0xc2, 0x23, 0x3d, 0xee, 0x4c, 0x95, 0x0b, 0x42, 0xfa, 0xc3, 0x4e,
+	0x08, 0x2e, 0xa1, 0x66, 0x28, 0xd9, 0x24, 0xb2, 0x76, 0x5b, 0xa2, 0x49, 0x6d, 0x8b, 0xd1, 0x25,
+	0x72, 0xf8, 0xf6, 0x64, 0x86, 0x68, 0x98, 0x16, 0xd4, 0xa4, 0x5c, 0xcc, 0x5d, 0x65, 0xb6, 0x92,
+	0x6c, 0x70, 0x48, 0x50, 0xfd, 0xed, 0xb9, 0xda, 0x5e, 0x15, 0x46, 0x57, 0xa7, 0x8d, 0x9d, 0x84,
+	0x90, 0xd8, 0xab, 0x00, 0x8c, 0xbc, 0xd3, 0x0a, 0xf7, 0xe4, 0x58, 0x05, 0xb8, 0xb3, 0x45, 0x06,
+	0xd0, 0x2c, 0x1e, 0x8f, 0xca, 0x3f, 0x0f, 0x02, 0xc1, 0xaf, 0xbd, 0x03, 0x01, 0x13, 0x8a, 0x6b,
+	0x3a, 0x91, 0x11, 0x41, 0x4f, 0x67, 0xdc, 0xea, 0x97, 0xf2, 0xcf, 0xce, 0xf0, 0xb4, 0xe6, 0x73,
+	0x96, 0xac, 0x74, 0x22, 0xe7, 0xad, 0x35, 0x85, 0xe2, 0xf9, 0x37, 0xe8, 0x1c, 0x75, 0xdf, 0x6e,
+	0x47, 0xf1, 0x1a, 0x71, 0x1d, 0x29, 0xc5, 0x89, 0x6f, 0xb7, 0x62, 0x0e, 0xaa, 0x18, 0xbe, 0x1b,
+	0xfc, 0x56, 0x3e, 0x4b, 0xc6, 0xd2, 0x79, 0x20, 0x9a, 0xdb, 0xc0, 0xfe, 0x78, 0xcd, 0x5a, 0xf4,
+	0x1f, 0xdd, 0xa8, 0x33, 0x88, 0x07, 0xc7, 0x31, 0xb1, 0x12, 0x10, 0x59, 0x27, 0x80, 0xec, 0x5f,
+	0x60, 0x51, 0x7f, 0xa9, 0x19, 0xb5, 0x4a, 0x0d, 0x2d, 0xe5, 0x7a, 0x9f, 0x93, 0xc9, 0x9c, 0xef,
+	0xa0, 0xe0, 0x3b, 0x4d, 0xae, 0x2a, 0xf5, 0xb0, 0xc8, 0xeb, 0xbb, 0x3c, 0x83, 0x53, 0x99, 0x61,
+	0x17, 0x2b, 0x04, 0x7e, 0xba, 0x77, 0xd6, 0x26, 0xe1, 0x69, 0x14, 0x63, 0x55, 0x21, 0x0c, 0x7d
+};
+
+int total_num_of_aes_blocks = 0;
+
+/*********************** FUNCTION DEFINITIONS ***********************/
+// Blocks are 16 bytes in FIPS-197 order: column c is bytes 4c..4c+3
+
+static void AddRoundKey(uchar s[], const uchar rk[])
+{
+	int i;
+
+	for (i = 0; i < 16; ++i)
+		s[i] ^= rk[i];
+}
+
+// SubBytes and ShiftRows in one pass: row r is rotated left by r columns
+static void SubShiftRows(uchar s[])
+{
+	uchar t;
+
+	s[0] = sbox[s[0]]; s[4] = sbox[s[4]]; s[8] = sbox[s[8]]; s[12] = sbox[s[12]];
+	t = s[1]; s[1] = sbox[s[5]]; s[5] = sbox[s[9]]; s[9] = sbox[s[13]]; s[13] = sbox[t];
+	t = s[2]; s[2] = sbox[s[10]]; s[10] = sbox[t];
+	t = s[6]; s[6] = sbox[s[14]]; s[14] = sbox[t];
+	t = s[3]; s[3] = sbox[s[15]]; s[15] = sbox[s[11]]; s[11] = sbox[s[7]]; s[7] = sbox[t];
+}
+
+static void InvSubShiftRows(uchar s[])
+{
+	uchar t;
+
+	s[0] = rsbox[s[0]]; s[4] = rsbox[s[4]]; s[8] = rsbox[s[8]]; s[12] = rsbox[s[12]];
+	t = s[13]; s[13] = rsbox[s[9]]; s[9] = rsbox[s[5]]; s[5] = rsbox[s[1]]; s[1] = rsbox[t];
+	t = s[2]; s[2] = rsbox[s[10]]; s[10] = rsbox[t];
+	t = s[6]; s[6] = rsbox[s[14]]; s[14] = rsbox[t];
+	t = s[3]; s[3] = rsbox[s[7]]; s[7] = rsbox[s[11]]; s[11] = rsbox[s[15]]; s[15] = rsbox[t];
+}
+
+static void MixColumns(uchar s[])
+{
+	uchar a0, a1, a2, a3, all;
+	int c;
+
+	for (c = 0; c < 16; c += 4) {
+		a0 = s[c]; a1 = s[c + 1]; a2 = s[c + 2]; a3 = s[c + 3];
+		all = a0 ^ a1 ^ a2 ^ a3;
+		s[c] = a0 ^ all ^ XTIME(a0 ^ a1);
+		s[c + 1] = a1 ^ all ^ XTIME(a1 ^ a2);
+		s[c + 2] = a2 ^ all ^ XTIME(a2 ^ a3);
+		s[c + 3] = a3 ^ all ^ XTIME(a3 ^ a0);
+	}
+}
+
+// InvMixColumns is MixColumns after multiplying each column by {04}x^2 + {05}
+static void InvMixColumns(uchar s[])
+{
+	uchar u, v;
+	int c;
+
+	for (c = 0; c < 16; c += 4) {
+		u = XTIME(XTIME(s[c] ^ s[c + 2]));
+		v = XTIME(XTIME(s[c + 1] ^ s[c + 3]));
+		s[c] ^= u; s[c + 1] ^= v; s[c + 2] ^= u; s[c + 3] ^= v;
+	}
+	MixColumns(s);
+}
+
+void AESSetKey(AES_CTX *ctx, const uchar key[])
+{
+#ifdef AES_ACCEL
+	uint w[8];
+	int i;
+
+	// The accelerator expands the key itself and keeps the round keys until the next KEY
+	memcpy(w, key, AES_KEYLEN / 8);
+	for (i = 0; i < AES_NK; ++i)
+		AES_REG(AES_KEY(i)) = w[i];
+	AES_REG(AES_KEYLEN_REG) = (AES_KEYLEN == 256);
+	AES_REG(AES_CTRL) = AES_CTRL_KEY;
+	AES_WAIT();
+#else
+	uchar t[4], u, rcon = 1;
+	int i, j;
+
+	memcpy(ctx->rk, key, 4 * AES_NK);
+	for (i = AES_NK; i < 4 * (AES_NR + 1); ++i) {
+		memcpy(t, &ctx->rk[4 * (i - 1)], 4);
+		if (i % AES_NK == 0) {
+			u = t[0];
+			t[0] = sbox[t[1]] ^ rcon;
+			t[1] = sbox[t[2]];
+			t[2] = sbox[t[3]];
+			t[3] = sbox[u];
+			rcon = XTIME(rcon);
+		} else if (AES_NK == 8 && i % AES_NK == 4) {
+			for (j = 0; j < 4; ++j)
+				t[j] = sbox[t[j]];
+		}
+		for (j = 0; j < 4; ++j)
+			ctx->rk[4 * i + j] = ctx->rk[4 * (i - AES_NK) + j] ^ t[j];
+	}
+#endif
+}
+
+#ifdef AES_ACCEL
+static void AESAccelBlock(const uchar in[], uchar out[], uint cmd)
+{
+	uint w[4];
+	int i;
+
+	memcpy(w, in, 16);
+	for (i = 0; i < 4; ++i)
+		AES_REG(AES_DATA_IN(i)) = w[i];
+	AES_REG(AES_CTRL) = cmd | AES_CTRL_GO;
+	AES_WAIT();
+	for (i = 0; i < 4; ++i)
+		w[i] = AES_REG(AES_DATA_OUT(i));
+	memcpy(out, w, 16);
+	total_num_of_aes_blocks++;
+}
+#endif
+
+void AESEncrypt(AES_CTX *ctx, const uchar in[], uchar out[])
+{
+#ifdef AES_ACCEL
+	AESAccelBlock(in, out, 0);
+#else
+	uchar s[16];
+	int r;
+
+	memcpy(s, in, 16);
+	AddRoundKey(s, ctx->rk);
+	for (r = 1; r < AES_NR; ++r) {
+		SubShiftRows(s);
+		MixColumns(s);
+		AddRoundKey(s, &ctx->rk[16 * r]);
+	}
+	SubShiftRows(s);
+	AddRoundKey(s, &ctx->rk[16 * AES_NR]);
+	memcpy(out, s, 16);
+	total_num_of_aes_blocks++;
+#endif
+}
+
+void AESDecrypt(AES_CTX *ctx, const uchar in[], uchar out[])
+{
+#ifdef AES_ACCEL
+	AESAccelBlock(in, out, AES_CTRL_DEC);
+#else
+	uchar s[16];
+	int r;
+
+	memcpy(s, in, 16);
+	AddRoundKey(s, &ctx->rk[16 * AES_NR]);
+	for (r = AES_NR - 1; r > 0; --r) {
+		InvSubShiftRows(s);
+		AddRoundKey(s, &ctx->rk[16 * r]);
+		InvMixColumns(s);
+	}
+	InvSubShiftRows(s);
+	AddRoundKey(s, ctx->rk);
+	memcpy(out, s, 16);
+	total_num_of_aes_blocks++;
+#endif
+}
+
+// CTR mode (NIST SP 800-38A): the counter block is incremented as a big-endian 128-bit
+// number per block and returned advanced past the last block, so a stream may be
+// processed in several calls; only the last one may end inside a block, whose unused
+// key stream bytes are dropped. With AES_ACCEL, in and out must be word aligned.
+void AESCtr(AES_CTX *ctx, uchar ctr[], const uchar in[], uchar out[], uint len)
+{
+	uint nblk = len / 16;
+	uint tail = len % 16;
+#ifdef AES_ACCEL
+	const uint *src = (const uint *)in;
+	uint *dst = (uint *)out;
+	uint w[4];
+	uint n;
+	int i;
+
+	memcpy(w, ctr, 16);
+	for (i = 0; i < 4; ++i)
+		AES_REG(AES_CTR(i)) = w[i];
+
+	// DATA_IN is latched when a block starts: block n is written while block n - 1 is
+	// encrypted, then block n - 1 is read back and block n started
+	if (nblk) {
+		for (i = 0; i < 4; ++i)
+			AES_REG(AES_DATA_IN(i)) = src[i];
+		AES_REG(AES_CTRL) = AES_CTRL_CTR | AES_CTRL_GO;
+		for (n = 1; n < nblk; ++n) {
+			for (i = 0; i < 4; ++i)
+				AES_REG(AES_DATA_IN(i)) = src[4 * n + i];
+			AES_WAIT();
+			for (i = 0; i < 4; ++i)
+				dst[4 * (n - 1) + i] = AES_REG(AES_DATA_OUT(i));
+			AES_REG(AES_CTRL) = AES_CTRL_CTR | AES_CTRL_GO;
+			total_num_of_aes_blocks++;
+		}
+		AES_WAIT();
+		for (i = 0; i < 4; ++i)
+			dst[4 * (nblk - 1) + i] = AES_REG(AES_DATA_OUT(i));
+		total_num_of_aes_blocks++;
+	}
+	if (tail) {
+		memset(w, 0, 16);
+		memcpy(w, &in[16 * nblk], tail);
+		AESAccelBlock((uchar *)w, (uchar *)w, AES_CTRL_CTR);
+		memcpy(&out[16 * nblk], w, tail);
+	}
+
+	for (i = 0; i < 4; ++i)
+		w[i] = AES_REG(AES_CTR(i));
+	memcpy(ctr, w, 16);
+#else
+	uchar ks[16];
+	uint n, m, j;
+	int i;
+
+	for (n = 0; n < nblk + (tail != 0); ++n) {
+		AESEncrypt(ctx, ctr, ks);
+		m = (n < nblk) ? 16 : tail;
+		for (j = 0; j < m; ++j)
+			out[16 * n + j] = in[16 * n + j] ^ ks[j];
+		for (i = 15; i >= 0; --i)
+			if (++ctr[i])
+				break;
+	}
+#endif
+}
+
+/*********************** SELF TEST ***********************/
+// FIPS-197 appendix C and NIST SP 800-38A F.5 vectors
+static const uchar ecb_pt[16] = {
+	0x00, 0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x77, 0x88, 0x99, 0xaa, 0xbb, 0xcc, 0xdd, 0xee, 0xff
+};
+
+static const uchar ctr_iv[16] = {
+	0xf0, 0xf1, 0xf2, 0xf3, 0xf4, 0xf5, 0xf6, 0xf7, 0xf8, 0xf9, 0xfa, 0xfb, 0xfc, 0xfd, 0xfe, 0xff
+};
+
+static const uchar ctr_pt[64] = {
+	0x6b, 0xc1, 0xbe, 0xe2, 0x2e, 0x40, 0x9f, 0x96, 0xe9, 0x3d, 0x7e, 0x11, 0x73, 0x93, 0x17, 0x2a,
+	0xae, 0x2d, 0x8a, 0x57, 0x1e, 0x03, 0xac, 0x9c, 0x9e, 0xb7, 0x6f, 0xac, 0x45, 0xaf, 0x8e, 0x51,
+	0x30, 0xc8, 0x1c, 0x46, 0xa3, 0x5c, 0xe4, 0x11, 0xe5, 0xfb, 0xc1, 0x19, 0x1a, 0x0a, 0x52, 0xef,
+	0xf6, 0x9f, 0x24, 0x45, 0xdf, 0x4f, 0x9b, 0x17, 0xad, 0x2b, 0x41, 0x7b, 0xe6, 0x6c, 0x37, 0x10
+};
+
+#if AES_KEYLEN == 256
+static const uchar ecb_key[32] = {
+	0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f,
+	0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18, 0x19, 0x1a, 0x1b, 0x1c, 0x1d, 0x1e, 0x1f
+};
+
+static const uchar ecb_ct[16] = {
+	0x8e, 0xa2, 0xb7, 0xca, 0x51, 0x67, 0x45, 0xbf, 0xea, 0xfc, 0x49, 0x90, 0x4b, 0x49, 0x60, 0x89
+};
+
+static const uchar ctr_key[32] = {
+	0x60, 0x3d, 0xeb, 0x10, 0x15, 0xca, 0x71, 0xbe, 0x2b, 0x73, 0xae, 0xf0, 0x85, 0x7d, 0x77, 0x81,
+	0x1f, 0x35, 0x2c, 0x07, 0x3b, 0x61, 0x08, 0xd7, 0x2d, 0x98, 0x10, 0xa3, 0x09, 0x14, 0xdf, 0xf4
+};
+
+static const uchar ctr_ct[64] = {
+	0x60, 0x1e, 0xc3, 0x13, 0x77, 0x57, 0x89, 0xa5, 0xb7, 0xa7, 0xf5, 0x04, 0xbb, 0xf3, 0xd2, 0x28,
+	0xf4, 0x43, 0xe3, 0xca, 0x4d, 0x62, 0xb5, 0x9a, 0xca, 0x84, 0xe9, 0x90, 0xca, 0xca, 0xf5, 0xc5,
+	0x2b, 0x09, 0x30, 0xda, 0xa2, 0x3d, 0xe9, 0x4c, 0xe8, 0x70, 0x17, 0xba, 0x2d, 0x84, 0x98, 0x8d,
+	0xdf, 0xc9, 0xc5, 0x8d, 0xb6, 0x7a, 0xad, 0xa6, 0x13, 0xc2, 0xdd, 0x08, 0x45, 0x79, 0x41, 0xa6
+};
+#else
+static const uchar ecb_key[16] = {
+	0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f
+};
+
+static const uchar ecb_ct[16] = {
+	0x69, 0xc4, 0xe0, 0xd8, 0x6a, 0x7b, 0x04, 0x30, 0xd8, 0xcd, 0xb7, 0x80, 0x70, 0xb4, 0xc5, 0x5a
+};
+
+static const uchar ctr_key[16] = {
+	0x2b, 0x7e, 0x15, 0x16, 0x28, 0xae, 0xd2, 0xa6, 0xab, 0xf7, 0x15, 0x88, 0x09, 0xcf, 0x4f, 0x3c
+};
+
+static const uchar ctr_ct[64] = {
+	0x87, 0x4d, 0x61, 0x91, 0xb6, 0x20, 0xe3, 0x26, 0x1b, 0xef, 0x68, 0x64, 0x99, 0x0d, 0xb6, 0xce,
+	0x98, 0x06, 0xf6, 0x6b, 0x79, 0x70, 0xfd, 0xff, 0x86, 0x17, 0x18, 0x7b, 0xb9, 0xff, 0xfd, 0xff,
+	0x5a, 0xe4, 0xdf, 0x3e, 0xdb, 0xd5, 0xd3, 0x5e, 0x5b, 0x4f, 0x09, 0x02, 0x0d, 0xb0, 0x3e, 0xab,
+	0x1e, 0x03, 0x1d, 0xda, 0x2f, 0xbe, 0x03, 0xd1, 0x79, 0x21, 0x70, 0xa0, 0xf3, 0x00, 0x9c, 0xee
+};
+#endif
+
+static int AESCheck(const char *name, const uchar out[], const uchar ref[], uint len)
+{
+	int err = memcmp(out, ref, len) != 0;
+
+	printf("%s: %s\n", name, err ? "FAIL" : "PASS");
+	return err;
+}
+
+static int AESSelfTest(AES_CTX *ctx)
+{
+	uint buf[16];
+	uchar ctr[16];
+	int err = 0;
+
+	AESSetKey(ctx, ecb_key);
+	AESEncrypt(ctx, ecb_pt, (uchar *)buf);
+	err |= AESCheck("ECB encrypt", (uchar *)buf, ecb_ct, 16);
+	AESDecrypt(ctx, ecb_ct, (uchar *)buf);
+	err |= AESCheck("ECB decrypt", (uchar *)buf, ecb_pt, 16);
+
+	// Two calls check the counter hand-over, the second one ends with a partial block
+	AESSetKey(ctx, ctr_key);
+	memcpy(ctr, ctr_iv, 16);
+	memcpy(buf, ctr_pt, 64);
+	AESCtr(ctx, ctr, (uchar *)buf, (uchar *)buf, 32);
+	AESCtr(ctx, ctr, (uchar *)buf + 32, (uchar *)buf + 32, 20);
+	err |= AESCheck("CTR", (uchar *)buf, ctr_ct, 52);
+	return err;
+}
+
+/*********************** BENCHMARK ***********************/
+#define BENCH_BYTES	1024
+#define BENCH_RUNS	16
+
+static uint bench_buf[BENCH_BYTES / 4];
+
+int main(void)
+{		
+
+    unsigned int mcycle_l_start, mcycle_h_start;
+    unsigned int mcycle_l_end, mcycle_h_end;
+    unsigned int total_time_l, total_time_h;
+
+    AES_CTX ctx;
+    uchar ctr[16];
+    int err, i;
+
+    printf("AES-%d CTR is RUNNING!! \n", AES_KEYLEN);
+
+    err = AESSelfTest(&ctx);
+
+    for (i = 0; i < BENCH_BYTES / 4; i++) bench_buf[i] = i * 0x01010101u;
+    AESSetKey(&ctx, ctr_key);
+    memcpy(ctr, ctr_iv, 16);
+    total_num_of_aes_blocks = 0;
+
+    //****** Do not remove this/modify code ******
+    mcycle_l_start = csr_read(0xc00);
+    mcycle_h_start = csr_read(0xc80);
+    //****** End of do not remove/modify this code ******
+
+    for (i = 0; i < BENCH_RUNS; i++) AESCtr(&ctx, ctr, (uchar *)bench_buf, (uchar *)bench_buf, BENCH_BYTES);
+
+    //****** Do not remove this/modify code ******
+    mcycle_l_end = csr_read(0xc00);
+    mcycle_h_end = csr_read(0xc80);
+    printf("***************** Performance Summary: ******************\n");
+    printf("Start time (hex): \t\t %08x%08x\n", mcycle_h_start, mcycle_l_start);
+    printf("End time (hex): \t\t %08x%08x\n", mcycle_h_end, mcycle_l_end);
+
+    if(mcycle_l_end >= mcycle_l_start){
+	    total_time_l = mcycle_l_end - mcycle_l_start;
+	    total_time_h = mcycle_h_end - mcycle_h_start;
+    }
+    else{
+	    total_time_l = ((unsigned int)0xffffffff - mcycle_l_start) + 1 + mcycle_l_end;
+	    total_time_h = mcycle_h_end - mcycle_h_start-1;
+    }
+    printf("Total time (hex): \t\t %08x%08x\n", total_time_h, total_time_l);
+    printf("For Throughput calculation divide %d by total time (hex) %08x%08x\n", total_num_of_aes_blocks, total_time_h, total_time_l);
+    //****** End of do not remove/modify this code ******
+
+    // The same for the software and accelerator builds
+    printf("Last block: ");
+    for (i = BENCH_BYTES - 16; i < BENCH_BYTES; i++) printf("%02x", ((uchar *)bench_buf)[i]);
+    printf("\n");
+
+    return err;
+}
@@ -0,0 +1,6 @@
+# platform specific part of makefile
+
+PLF_SYS_CLK ?= 25000000
+
+MARCH ?= rv32im
+MABI  ?= ilp32
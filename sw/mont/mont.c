@@ -0,0 +1,265 @@
+#include <string.h>
+#include "mont.h"
+
+#ifdef MONT_ACCEL
+// Memory-mapped Montgomery multiplier (scr1_mont)
+#define MONT_BASE		0xF0060000
+#define MONT_REG(off)		(*(volatile uint *)(MONT_BASE + (off)))
+#define MONT_CTRL		0x000
+#define MONT_COUNTER		0x004
+#define MONT_NWORDS		0x008
+#define MONT_NINV		0x00C
+#define MONT_A(i)		(0x100 + 4 * (i))
+#define MONT_B(i)		(0x200 + 4 * (i))
+#define MONT_N(i)		(0x300 + 4 * (i))
+#define MONT_R(i)		(0x400 + 4 * (i))
+
+#define MONT_CTRL_GO		(1u << 0)
+#define MONT_CTRL_SQR		(1u << 1)
+#define MONT_CTRL_TO_A		(1u << 2)
+#define MONT_CTRL_DONE		(1u << 31)
+
+// CTRL writes and operand RAM writes are ignored while the multiplier is busy, so every
+// GO is followed by a wait for done
+#define MONT_WAIT()		while (!(MONT_REG(MONT_CTRL) & MONT_CTRL_DONE))
+
+// The context whose modulus is held by the multiplier
+static const MONT_CTX *mont_loaded;
+#endif
+
+int total_num_of_mont_muls = 0;
+
+static MONT_CTX p256_ctx;
+static MONT_CTX x25519_ctx;
+
+static const uint p256_p[8] = {
+	0xffffffff, 0xffffffff, 0xffffffff, 0x00000000, 0x00000000, 0x00000000, 0x00000001, 0xffffffff
+};
+
+static const uint x25519_p[8] = {
+	0xffffffed, 0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff, 0x7fffffff
+};
+
+/*********************** FUNCTION DEFINITIONS ***********************/
+// v = v - n when the carry word hi is set or v >= n, for v < 2n
+static void MontReduce(const MONT_CTX *ctx, uint v[], uint hi)
+{
+	uint d[MONT_MAX_WORDS];
+	uint i, borrow = 0;
+	unsigned long long x;
+
+	for (i = 0; i < ctx->nwords; ++i) {
+		x = (unsigned long long)v[i] - ctx->n[i] - borrow;
+		d[i] = (uint)x;
+		borrow = (uint)(x >> 32) & 1;
+	}
+	if (hi || !borrow)
+		memcpy(v, d, 4 * ctx->nwords);
+}
+
+void MontSetup(MONT_CTX *ctx, const uint n[], uint nwords)
+{
+	uint x, c, t, i, k;
+
+	memcpy(ctx->n, n, 4 * nwords);
+	ctx->nwords = nwords;
+
+	// Newton iteration for n^(-1) mod 2^32: n * n = 1 mod 8 for odd n, and every step
+	// doubles the number of correct low bits
+	x = n[0];
+	for (k = 0; k < 4; ++k)
+		x *= 2 - n[0] * x;
+	ctx->ninv = -x;
+
+	// 2^(64 * nwords) mod n by modular doubling of 1
+	memset(ctx->rr, 0, 4 * nwords);
+	ctx->rr[0] = 1;
+	for (k = 0; k < 64 * nwords; ++k) {
+		c = 0;
+		for (i = 0; i < nwords; ++i) {
+			t = ctx->rr[i];
+			ctx->rr[i] = (t << 1) | c;
+			c = t >> 31;
+		}
+		MontReduce(ctx, ctx->rr, c);
+	}
+
+#ifdef MONT_ACCEL
+	if (mont_loaded == ctx)
+		mont_loaded = 0;
+#endif
+}
+
+#ifdef MONT_ACCEL
+static void MontLoad(const MONT_CTX *ctx)
+{
+	uint i;
+
+	if (mont_loaded == ctx)
+		return;
+	MONT_REG(MONT_NWORDS) = ctx->nwords;
+	MONT_REG(MONT_NINV) = ctx->ninv;
+	for (i = 0; i < ctx->nwords; ++i)
+		MONT_REG(MONT_N(i)) = ctx->n[i];
+	mont_loaded = ctx;
+}
+
+static void MontRun(uint cmd)
+{
+	MONT_REG(MONT_CTRL) = cmd | MONT_CTRL_GO;
+	MONT_WAIT();
+	total_num_of_mont_muls++;
+}
+#else
+// Coarsely integrated operand scanning: t = (t + a[i] * b + m * n) / 2^32 per word of a,
+// with m chosen so that the division is exact
+static void MontMulSoft(const MONT_CTX *ctx, const uint a[], const uint b[], uint r[])
+{
+	uint t[MONT_MAX_WORDS + 2];
+	uint s = ctx->nwords;
+	uint i, j, m, c;
+	unsigned long long p;
+
+	memset(t, 0, 4 * (s + 2));
+	for (i = 0; i < s; ++i) {
+		c = 0;
+		for (j = 0; j < s; ++j) {
+			p = (unsigned long long)a[i] * b[j] + t[j] + c;
+			t[j] = (uint)p;
+			c = (uint)(p >> 32);
+		}
+		p = (unsigned long long)t[s] + c;
+		t[s] = (uint)p;
+		t[s + 1] = (uint)(p >> 32);
+
+		m = t[0] * ctx->ninv;
+		p = (unsigned long long)m * ctx->n[0] + t[0];
+		c = (uint)(p >> 32);
+		for (j = 1; j < s; ++j) {
+			p = (unsigned long long)m * ctx->n[j] + t[j] + c;
+			t[j - 1] = (uint)p;
+			c = (uint)(p >> 32);
+		}
+		p = (unsigned long long)t[s] + c;
+		t[s - 1] = (uint)p;
+		t[s] = t[s + 1] + (uint)(p >> 32);
+	}
+	MontReduce(ctx, t, t[s]);
+	memcpy(r, t, 4 * s);
+	total_num_of_mont_muls++;
+}
+#endif
+
+void MontMul(MONT_CTX *ctx, const uint a[], const uint b[], uint r[])
+{
+#ifdef MONT_ACCEL
+	uint i;
+
+	MontLoad(ctx);
+	for (i = 0; i < ctx->nwords; ++i) {
+		MONT_REG(MONT_A(i)) = a[i];
+		MONT_REG(MONT_B(i)) = b[i];
+	}
+	MontRun(0);
+	for (i = 0; i < ctx->nwords; ++i)
+		r[i] = MONT_REG(MONT_R(i));
+#else
+	MontMulSoft(ctx, a, b, r);
+#endif
+}
+
+// Left-to-right binary exponentiation in the Montgomery domain. With MONT_ACCEL the
+// accumulator never leaves the multiplier: it stays in A (SQR|TO_A squares it, TO_A
+// multiplies it by the base held in B), so only the operands and the result cross the bus.
+void MontModExp(MONT_CTX *ctx, const uint base[], const uint exp[], uint expwords, uint r[])
+{
+	uint s = ctx->nwords;
+	int bit = 32 * expwords - 1;
+#ifdef MONT_ACCEL
+	uint i;
+#else
+	uint x[MONT_MAX_WORDS];
+	uint xb[MONT_MAX_WORDS];
+#endif
+
+	while (bit >= 0 && !((exp[bit / 32] >> (bit % 32)) & 1))
+		--bit;
+	if (bit < 0) {
+		memset(r, 0, 4 * s);
+		r[0] = 1;
+		return;
+	}
+
+#ifdef MONT_ACCEL
+	MontLoad(ctx);
+	for (i = 0; i < s; ++i) {
+		MONT_REG(MONT_A(i)) = base[i];
+		MONT_REG(MONT_B(i)) = ctx->rr[i];
+	}
+	MontRun(MONT_CTRL_TO_A);
+	for (i = 0; i < s; ++i)
+		MONT_REG(MONT_B(i)) = MONT_REG(MONT_R(i));
+	while (--bit >= 0) {
+		MontRun(MONT_CTRL_SQR | MONT_CTRL_TO_A);
+		if ((exp[bit / 32] >> (bit % 32)) & 1)
+			MontRun(MONT_CTRL_TO_A);
+	}
+	// Multiplying by 1 leaves the Montgomery domain
+	for (i = 0; i < s; ++i)
+		MONT_REG(MONT_B(i)) = (i == 0);
+	MontRun(0);
+	for (i = 0; i < s; ++i)
+		r[i] = MONT_REG(MONT_R(i));
+#else
+	MontMulSoft(ctx, base, ctx->rr, xb);
+	memcpy(x, xb, 4 * s);
+	while (--bit >= 0) {
+		MontMulSoft(ctx, x, x, x);
+		if ((exp[bit / 32] >> (bit % 32)) & 1)
+			MontMulSoft(ctx, x, xb, x);
+	}
+	memset(xb, 0, 4 * s);
+	xb[0] = 1;
+	MontMulSoft(ctx, x, xb, r);
+#endif
+}
+
+// a * b / 2^256 followed by a multiplication by 2^512 mod p gives a * b mod p; the
+// context of each field is set up on first use
+static void FieldMul(MONT_CTX *ctx, const uint p[], const uint a[], const uint b[], uint r[])
+{
+#ifdef MONT_ACCEL
+	uint i;
+#else
+	uint t[8];
+#endif
+
+	if (ctx->nwords == 0)
+		MontSetup(ctx, p, 8);
+#ifdef MONT_ACCEL
+	MontLoad(ctx);
+	for (i = 0; i < 8; ++i) {
+		MONT_REG(MONT_A(i)) = a[i];
+		MONT_REG(MONT_B(i)) = b[i];
+	}
+	MontRun(MONT_CTRL_TO_A);
+	for (i = 0; i < 8; ++i)
+		MONT_REG(MONT_B(i)) = ctx->rr[i];
+	MontRun(0);
+	for (i = 0; i < 8; ++i)
+		r[i] = MONT_REG(MONT_R(i));
+#else
+	MontMulSoft(ctx, a, b, t);
+	MontMulSoft(ctx, t, ctx->rr, r);
+#endif
+}
+
+void P256Mul(const uint a[], const uint b[], uint r[])
+{
+	FieldMul(&p256_ctx, p256_p, a, b, r);
+}
+
+void X25519Mul(const uint a[], const uint b[], uint r[])
+{
+	FieldMul(&x25519_ctx, x25519_p, a, b, r);
+}
@@ -0,0 +1,27 @@
+#ifndef MONT_H
+#define MONT_H
+
+#define uint unsigned int
+
+// Operands of up to 2048 bits, as little-endian arrays of 32-bit words
+#define MONT_MAX_WORDS 64
+
+typedef struct {
+	uint n[MONT_MAX_WORDS];		// odd modulus
+	uint rr[MONT_MAX_WORDS];	// 2^(64 * nwords) mod n, maps into the Montgomery domain
+	uint ninv;			// -n^(-1) mod 2^32
+	uint nwords;			// 2..MONT_MAX_WORDS
+} MONT_CTX;
+
+extern int total_num_of_mont_muls;
+
+// All operands except exponents must be below n; r may alias a or b
+void MontSetup(MONT_CTX *ctx, const uint n[], uint nwords);
+void MontMul(MONT_CTX *ctx, const uint a[], const uint b[], uint r[]);	// a * b / 2^(32 * nwords) mod n
+void MontModExp(MONT_CTX *ctx, const uint base[], const uint exp[], uint expwords, uint r[]);
+
+// a * b mod p for the P-256 and Curve25519 field primes, 8 words each
+void P256Mul(const uint a[], const uint b[], uint r[]);
+void X25519Mul(const uint a[], const uint b[], uint r[]);
+
+#endif
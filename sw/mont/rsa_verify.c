@@ -0,0 +1,143 @@
+#include <stdio.h>
+#include <string.h>
+#include "csr.h"
+#include "mont.h"
+
+// RSA-2048 signature verification: rsa_sig^65537 mod rsa_n == rsa_msg
+static const uint rsa_n[64] = {
+	0xb4c3d89b, 0xa6288fdb, 0x7c3c9872, 0xf4f8bedb, 0x9a542da7, 0xc95f2782, 0x90ed6954, 0xed5b2dae,
+	0x6ae098e3, 0x312287ae, 0x130aaee9, 0xe313b24e, 0xeb85c2ae, 0x301e0a68, 0x24637ef4, 0x7ab1f2d5,
+	0xb00ebf3e, 0xf3db1791, 0xcdc68d70, 0xbfbfea1b, 0xe294e546, 0x193c9369, 0x2010ec9a, 0x98a23cf3,
+	0xa92b2f18, 0x9c502929, 0x0b02b49f, 0x05636edc, 0xe546efff, 0x7815fa22, 0xa05a8661, 0xe400194d,
+	0xf4d610b9, 0x3498f13f, 0x5ac6a4f8, 0x1b75be0e, 0xc4761617, 0x73e444c3, 0xfe4157aa, 0xc02a03e1,
+	0xf1d81878, 0xe3b80dc1, 0xe2e20629, 0xa2240eef, 0x106dce69, 0x2a2e49c7, 0xd8bd9e80, 0x93ed2121,
+	0xb8b4f2ec, 0x2649e1e2, 0xc6c0381d, 0xef310591, 0xdeae51e8, 0x524a1398, 0xc31cb224, 0xa9e306a4,
+	0xda6f1587, 0x00120ec6, 0xeab616bf, 0xc5da56d9, 0xd23e4716, 0x024dbae7, 0x80a36ca8, 0xb9f54d90
+};
+
+static const uint rsa_sig[64] = {
+	0x0405c93d, 0x02030193, 0x80a471e7, 0xc3b33d5b, 0x363db011, 0x48144152, 0xa19612e0, 0xccfff064,
+	0x83c5cc36, 0x6588d44c, 0x531d7e51, 0xfd97a2f6, 0x6ec3e50b, 0x2a212a35, 0x1d737239, 0x70902e66,
+	0x812a584b, 0x0c3a7698, 0x15dc9d77, 0x6a367035, 0x31d6e346, 0x165c8312, 0xd8e9ac3a, 0x7a0e707a,
+	0x4c231a17, 0xe85751dc, 0xde1e1655, 0x7cb11f23, 0xb2454ab7, 0x84023174, 0x7266dd9b, 0x9f7242ae,
+	0xcea9e76c, 0xc8be4223, 0x3d6424b8, 0xa26dcf2b, 0xfdc2b6c4, 0x080d7043, 0xca11ef35, 0x61079b4d,
+	0x7cfda87c, 0x8639b741, 0xa4ca99ca, 0x5aeeb96f, 0x74e2ce6d, 0x1a15338f, 0xe9a2d6fd, 0xe2d7acb1,
+	0x21a6df96, 0x2feced8b, 0xefeada53, 0x400d19db, 0xed164bb3, 0xb00f9435, 0x56918e2a, 0x90efbb64,
+	0xfe3cca1f, 0x0246bfa5, 0xf499741e, 0xb1d0a616, 0x04edd9b9, 0xc730f430, 0xc5157db3, 0x4649efb3
+};
+
+static const uint rsa_msg[64] = {
+	0x5e956e1b, 0xf12398d4, 0x35ec4e00, 0xcca6588e, 0x8fda6447, 0xb6791abd, 0x29a79296, 0xa32c979a,
+	0x78016016, 0xf231d6ff, 0x93202963, 0x2400afe6, 0x690f12e9, 0x6c81af7f, 0xcb8454b8, 0xa403d918,
+	0x587230f2, 0xd0bc76c4, 0x3d1d184a, 0x80f4a4c2, 0xe9adbce7, 0xcfcb6a4f, 0x90026c78, 0xffec06a2,
+	0xe4ea7dbf, 0x8bed2382, 0x4b573145, 0x4f17d8b7, 0x41a9f394, 0xe4539fc2, 0xa936681d, 0x8b292786,
+	0x4eb74561, 0xc8465380, 0x99e2dc3f, 0xfd6989e4, 0x8d52230c, 0xff11946d, 0x07ac6aec, 0x5546e6f2,
+	0xef03f4ed, 0x642eea15, 0xd3dff84d, 0x2f7aa519, 0xbb847c50, 0x616a1c1c, 0xa53f67df, 0xf7150fc5,
+	0xb494e63c, 0x31fa462f, 0xe3480329, 0xb582a9ec, 0x09d28a51, 0x58477b08, 0xc857cea9, 0x23e469fb,
+	0x7a1b5f87, 0x4ef22ed7, 0x7b06cf7c, 0xf706f5f8, 0x51e01a05, 0xd8d9f3bd, 0xc4c9e724, 0x83d024fc
+};
+
+static const uint rsa_e[1] = {
+	0x00010001
+};
+
+// Field multiplications: *_ab = *_a * *_b mod p
+static const uint p256_a[8] = {
+	0xe1707359, 0x487b505c, 0x69d5ae13, 0xa40633e1, 0x3eb42b6b, 0xf41d6c7d, 0xfa7f140c, 0x0005d63f
+};
+
+static const uint p256_b[8] = {
+	0x83637cdd, 0xe715c0c9, 0xd7b8e1a2, 0xcf3562fa, 0xcfa6e802, 0x1127178d, 0x5832cc6a, 0x02e74386
+};
+
+static const uint p256_ab[8] = {
+	0x9f8b492a, 0xe1c66e14, 0x885b616e, 0x8275851f, 0xf5fb879c, 0xe863f775, 0xab13e97e, 0x08dcb82b
+};
+
+static const uint x25519_a[8] = {
+	0x692746f1, 0x6af50311, 0x26b87e5d, 0x09a0a214, 0xdf18640d, 0x0a13bb30, 0xcd197bbe, 0x052bf4c2
+};
+
+static const uint x25519_b[8] = {
+	0xdc02ada7, 0x5a9778c8, 0x5246fa85, 0x9578cea1, 0x501adc3b, 0xbae4712d, 0xb3452a44, 0x3e92b861
+};
+
+static const uint x25519_ab[8] = {
+	0x4f93c64e, 0x16959b0d, 0xd88bdd18, 0x817460c2, 0x434fc03b, 0x3f3793b2, 0xe477bb08, 0x049462bc
+};
+
+static int MontCheck(const char *name, const uint out[], const uint ref[], uint nwords)
+{
+	int err = memcmp(out, ref, 4 * nwords) != 0;
+
+	printf("%s: %s\n", name, err ? "FAIL" : "PASS");
+	return err;
+}
+
+static int MontSelfTest(MONT_CTX *ctx)
+{
+	uint buf[MONT_MAX_WORDS];
+	int err = 0;
+
+	P256Mul(p256_a, p256_b, buf);
+	err |= MontCheck("P-256 mul", buf, p256_ab, 8);
+	X25519Mul(x25519_a, x25519_b, buf);
+	err |= MontCheck("X25519 mul", buf, x25519_ab, 8);
+	MontModExp(ctx, rsa_sig, rsa_e, 1, buf);
+	err |= MontCheck("RSA-2048 verify", buf, rsa_msg, 64);
+	return err;
+}
+
+/*********************** BENCHMARK ***********************/
+#define BENCH_RUNS	4
+
+int main(void)
+{		
+
+    unsigned int mcycle_l_start, mcycle_h_start;
+    unsigned int mcycle_l_end, mcycle_h_end;
+    unsigned int total_time_l, total_time_h;
+
+    MONT_CTX ctx;
+    uint buf[MONT_MAX_WORDS];
+    int err, i;
+
+    printf("RSA-2048 verify is RUNNING!! \n");
+
+    // Once per key: NINV and 2^4096 mod n are computed in software
+    MontSetup(&ctx, rsa_n, 64);
+    err = MontSelfTest(&ctx);
+
+    total_num_of_mont_muls = 0;
+
+    //****** Do not remove this/modify code ******
+    mcycle_l_start = csr_read(0xc00);
+    mcycle_h_start = csr_read(0xc80);
+    //****** End of do not remove/modify this code ******
+
+    for (i = 0; i < BENCH_RUNS; i++) MontModExp(&ctx, rsa_sig, rsa_e, 1, buf);
+
+    //****** Do not remove this/modify code ******
+    mcycle_l_end = csr_read(0xc00);
+    mcycle_h_end = csr_read(0xc80);
+    printf("***************** Performance Summary: ******************\n");
+    printf("Start time (hex): \t\t %08x%08x\n", mcycle_h_start, mcycle_l_start);
+    printf("End time (hex): \t\t %08x%08x\n", mcycle_h_end, mcycle_l_end);
+
+    if(mcycle_l_end >= mcycle_l_start){
+	    total_time_l = mcycle_l_end - mcycle_l_start;
+	    total_time_h = mcycle_h_end - mcycle_h_start;
+    }
+    else{
+	    total_time_l = ((unsigned int)0xffffffff - mcycle_l_start) + 1 + mcycle_l_end;
+	    total_time_h = mcycle_h_end - mcycle_h_start-1;
+    }
+    printf("Total time (hex): \t\t %08x%08x\n", total_time_h, total_time_l);
+    printf("For Throughput calculation divide %d by total time (hex) %08x%08x\n", total_num_of_mont_muls, total_time_h, total_time_l);
+    //****** End of do not remove/modify this code ******
+
+    // The same for the software and accelerator builds
+    err |= MontCheck("Last verify", buf, rsa_msg, 64);
+
+    return err;
+}
@@ -2,9 +2,10 @@
 #include <stdlib.h>
 #include <string.h>
 #include "csr.h"
-
-#define uchar unsigned char
-#define uint unsigned int
+#include "sha256.h"
+#ifdef SHA256_DRV
+#include "sha256_drv.h"
+#endif
 
 #define DBL_INT_ADD(a,b,c) if (a > 0xffffffff - (c)) ++b; a += c;
 #define ROTLEFT(a,b) (((a) << (b)) | ((a) >> (32-(b))))
@@ -18,12 +19,51 @@
 #define SIG0(x) (ROTRIGHT(x,7) ^ ROTRIGHT(x,18) ^ ((x) >> 3))
 #define SIG1(x) (ROTRIGHT(x,17) ^ ROTRIGHT(x,19) ^ ((x) >> 10))
 
-typedef struct {
-	uchar data[64];
-	uint datalen;
-	uint bitlen[2];
-	uint state[8];
-} SHA256_CTX;
+#define BSWAP32(x) (((x) << 24) | (((x) & 0xff00) << 8) | (((x) >> 8) & 0xff00) | ((x) >> 24))
+
+// The 16 big-endian words of a block: one word load each when the block is 4-byte aligned
+static inline void SHA256LoadBlock(uint m[16], const uchar data[])
+{
+	uint i, j, w;
+
+	if (!((uint)data & 3)) {
+		for (i = 0; i < 16; ++i) {
+			w = ((const uint *)data)[i];
+			m[i] = BSWAP32(w);
+		}
+	} else {
+		for (i = 0, j = 0; i < 16; ++i, j += 4)
+			m[i] = (data[j] << 24) | (data[j + 1] << 16) | (data[j + 2] << 8) | (data[j + 3]);
+	}
+}
+
+// The digest: the eight state words big-endian, one word store each when hash is aligned
+static inline void SHA256StoreState(uchar hash[], const uint state[8])
+{
+	uint i, w;
+
+	if (!((uint)hash & 3)) {
+		for (i = 0; i < 8; ++i) {
+			w = state[i];
+			((uint *)hash)[i] = BSWAP32(w);
+		}
+	} else {
+		for (i = 0; i < 8; ++i) {
+			hash[4 * i]     = state[i] >> 24;
+			hash[4 * i + 1] = state[i] >> 16;
+			hash[4 * i + 2] = state[i] >> 8;
+			hash[4 * i + 3] = state[i];
+		}
+	}
+}
+
+#ifdef SHA256_ACCEL
+// The accelerator keeps the chaining state and bit length of one stream between calls.
+// DATALEN, BITLEN and STATE (0x34-0x5C) follow the datalen, bitlen and state members of
+// SHA256_CTX, so switching streams saves the owner's context and restores the next one;
+// consecutive calls on the same stream reload nothing
+static SHA256_CTX *accel_ctx;
+#endif
 
 uint k[64] = {
 	0x428a2f98,0x71374491,0xb5c0fbcf,0xe9b5dba5,0x3956c25b,0x59f111f1,0x923f82a4,0xab1c5ed5,
@@ -52,27 +92,99 @@ void SHA256Init(SHA256_CTX *ctx)
 	ctx->state[5] = 0x9b05688c;
 	ctx->state[6] = 0x1f83d9ab;
 	ctx->state[7] = 0x5be0cd19;
+#ifdef SHA256_ACCEL
+	// A context reused for a new message no longer owns the accelerator, which is left idle
+	// so that the next restore is not ignored
+	if (accel_ctx == ctx) {
+		while (!(ACCEL_REG(ACCEL_CTRL) & ACCEL_CTRL_DONE))
+			;
+		accel_ctx = 0;
+	}
+#endif
 }
 
-void SHA256Transform(SHA256_CTX *ctx, uchar data[])
+#if defined(SHA256_ASM) || defined(SHA256_BENCH)
+// Compression function in sha256_compress.S
+void SHA256Compress(uint state[8], const uchar data[]);
+#endif
+
+#if defined(SHA256_UNROLLED) || defined(SHA256_BENCH)
+// Fully unrolled: each round renames the eight working variables instead of moving them
+// (the caller passes them rotated by one), the message schedule is expanded in place in
+// a 16-word window and the round constants are immediates
+#define UR_CH(x,y,z) ((z) ^ ((x) & ((y) ^ (z))))
+#define UR_MAJ(x,y,z) (((x) & (y)) | ((z) & ((x) | (y))))
+
+#define UR_EXPAND(i) (m[(i) & 15] += SIG1(m[((i) - 2) & 15]) + m[((i) - 7) & 15] + SIG0(m[((i) - 15) & 15]))
+#define UR_W(i) ((i) < 16 ? m[(i) & 15] : UR_EXPAND(i))
+
+#define UR_ROUND(a,b,c,d,e,f,g,h,i,kc) \
+	t1 = h + EP1(e) + UR_CH(e, f, g) + (kc) + UR_W(i); \
+	d += t1; \
+	h = t1 + EP0(a) + UR_MAJ(a, b, c)
+
+#define UR_ROUND8(i,k0,k1,k2,k3,k4,k5,k6,k7) \
+	UR_ROUND(a, b, c, d, e, f, g, h, (i) + 0, k0); \
+	UR_ROUND(h, a, b, c, d, e, f, g, (i) + 1, k1); \
+	UR_ROUND(g, h, a, b, c, d, e, f, (i) + 2, k2); \
+	UR_ROUND(f, g, h, a, b, c, d, e, (i) + 3, k3); \
+	UR_ROUND(e, f, g, h, a, b, c, d, (i) + 4, k4); \
+	UR_ROUND(d, e, f, g, h, a, b, c, (i) + 5, k5); \
+	UR_ROUND(c, d, e, f, g, h, a, b, (i) + 6, k6); \
+	UR_ROUND(b, c, d, e, f, g, h, a, (i) + 7, k7)
+
+static void SHA256CompressUnrolled(uint state[8], const uchar data[])
 {
-	uint a, b, c, d, e, f, g, h, i, j, t1, t2, m[64];
+	uint a, b, c, d, e, f, g, h, t1, m[16];
+
+	SHA256LoadBlock(m, data);
+	a = state[0];
+	b = state[1];
+	c = state[2];
+	d = state[3];
+	e = state[4];
+	f = state[5];
+	g = state[6];
+	h = state[7];
 
-	for (i = 0, j = 0; i < 16; ++i, j += 4){
-		m[i] = (data[j] << 24) | (data[j + 1] << 16) | (data[j + 2] << 8) | (data[j + 3]);
+	UR_ROUND8( 0, 0x428a2f98,0x71374491,0xb5c0fbcf,0xe9b5dba5,0x3956c25b,0x59f111f1,0x923f82a4,0xab1c5ed5);
+	UR_ROUND8( 8, 0xd807aa98,0x12835b01,0x243185be,0x550c7dc3,0x72be5d74,0x80deb1fe,0x9bdc06a7,0xc19bf174);
+	UR_ROUND8(16, 0xe49b69c1,0xefbe4786,0x0fc19dc6,0x240ca1cc,0x2de92c6f,0x4a7484aa,0x5cb0a9dc,0x76f988da);
+	UR_ROUND8(24, 0x983e5152,0xa831c66d,0xb00327c8,0xbf597fc7,0xc6e00bf3,0xd5a79147,0x06ca6351,0x14292967);
+	UR_ROUND8(32, 0x27b70a85,0x2e1b2138,0x4d2c6dfc,0x53380d13,0x650a7354,0x766a0abb,0x81c2c92e,0x92722c85);
+	UR_ROUND8(40, 0xa2bfe8a1,0xa81a664b,0xc24b8b70,0xc76c51a3,0xd192e819,0xd6990624,0xf40e3585,0x106aa070);
+	UR_ROUND8(48, 0x19a4c116,0x1e376c08,0x2748774c,0x34b0bcb5,0x391c0cb3,0x4ed8aa4a,0x5b9cca4f,0x682e6ff3);
+	UR_ROUND8(56, 0x748f82ee,0x78a5636f,0x84c87814,0x8cc70208,0x90befffa,0xa4506ceb,0xbef9a3f7,0xc67178f2);
+
+	state[0] += a;
+	state[1] += b;
+	state[2] += c;
+	state[3] += d;
+	state[4] += e;
+	state[5] += f;
+	state[6] += g;
+	state[7] += h;
 }
-	for (; i < 64; ++i){
+#endif
+
+#if !(defined(SHA256_ACCEL) || defined(SHA256_ASM) || defined(SHA256_UNROLLED)) || defined(SHA256_BENCH)
+static void SHA256CompressRolled(uint state[8], const uchar data[])
+{
+	uint a, b, c, d, e, f, g, h, i, t1, t2, m[64];
+
+	SHA256LoadBlock(m, data);
+	for (i = 16; i < 64; ++i){
 		m[i] = SIG1(m[i - 2]) + m[i - 7] + SIG0(m[i - 15]) + m[i - 16];
 	}
 
-	a = ctx->state[0];
-	b = ctx->state[1];
-	c = ctx->state[2];
-	d = ctx->state[3];
-	e = ctx->state[4];
-	f = ctx->state[5];
-	g = ctx->state[6];
-	h = ctx->state[7];
+	a = state[0];
+	b = state[1];
+	c = state[2];
+	d = state[3];
+	e = state[4];
+	f = state[5];
+	g = state[6];
+	h = state[7];
 
 	for (i = 0; i < 64; ++i) {
 		if (e == 0){
@@ -98,39 +210,286 @@ void SHA256Transform(SHA256_CTX *ctx, uchar data[])
 		a = t1 + t2;
 	}
 
-	ctx->state[0] += a;
-	ctx->state[1] += b;
-	ctx->state[2] += c;
-	ctx->state[3] += d;
-	ctx->state[4] += e;
-	ctx->state[5] += f;
-	ctx->state[6] += g;
-	ctx->state[7] += h;
+	state[0] += a;
+	state[1] += b;
+	state[2] += c;
+	state[3] += d;
+	state[4] += e;
+	state[5] += f;
+	state[6] += g;
+	state[7] += h;
+}
+#endif
+
+#ifdef SHA256_ACCEL
+// Write the chaining state and bit length held by the accelerator back to their context
+void SHA256AccelSave(void)
+{
+	uint i;
+
+	if (!accel_ctx)
+		return;
+	while (!(ACCEL_REG(ACCEL_CTRL) & ACCEL_CTRL_DONE))
+		;
+	accel_ctx->bitlen[0] = ACCEL_REG(ACCEL_BITLEN0);
+	accel_ctx->bitlen[1] = ACCEL_REG(ACCEL_BITLEN1);
+	for (i = 0; i < 8; ++i)
+		accel_ctx->state[i] = ACCEL_REG(ACCEL_STATE(i));
+	accel_ctx = 0;
+}
+
+// Make ctx the stream held by the accelerator
+void SHA256AccelRestore(SHA256_CTX *ctx)
+{
+	uint i;
+
+	if (accel_ctx == ctx)
+		return;
+	SHA256AccelSave();
+	ACCEL_REG(ACCEL_MODE) = ACCEL_MODE_SHA256;
+	ACCEL_REG(ACCEL_BITLEN0) = ctx->bitlen[0];
+	ACCEL_REG(ACCEL_BITLEN1) = ctx->bitlen[1];
+	for (i = 0; i < 8; ++i)
+		ACCEL_REG(ACCEL_STATE(i)) = ctx->state[i];
+	accel_ctx = ctx;
+}
+
+// Compress nblocks consecutive blocks: the next block is packed into the message
+// buffer while the previous one compresses and its GO is queued behind it. The last
+// block may still be compressing on return
+void SHA256TransformStream(SHA256_CTX *ctx, uchar data[], uint nblocks)
+{
+	uint i, b, m[16];
+
+	SHA256AccelRestore(ctx);
+	for (b = 0; b < nblocks; ++b, data += 64) {
+		SHA256LoadBlock(m, data);
+		while (ACCEL_REG(ACCEL_CTRL) & ACCEL_CTRL_PEND)
+			;
+		for (i = 0; i < 16; ++i)
+			ACCEL_REG(ACCEL_MSG(i)) = m[i];
+		ACCEL_REG(ACCEL_CTRL) = ACCEL_CTRL_GO;
+    //** Do not remove this/modify code **
+	total_num_of_sha256_ops++;
+    //** End of do not remove/modify this code **
+	}
+}
+
+void SHA256Transform(SHA256_CTX *ctx, uchar data[])
+{
+	SHA256TransformStream(ctx, data, 1);
+}
+
+#ifdef SHA256_ACCEL_DMA
+// Compress nblocks consecutive blocks; the accelerator fetches them from the TCM itself
+void SHA256TransformBlocks(SHA256_CTX *ctx, uchar data[], uint nblocks)
+{
+	uint i;
+
+	// A DMA GO is not queued, so a block of this stream still compressing must be finished.
+	// Any other stream was saved once done, and after reset DONE is clear with nothing to wait for
+	if (accel_ctx == ctx) {
+		while (!(ACCEL_REG(ACCEL_CTRL) & ACCEL_CTRL_DONE))
+			;
+	}
+	SHA256AccelRestore(ctx);
+	ACCEL_REG(ACCEL_DMA_SRC) = (uint)data;
+	ACCEL_REG(ACCEL_DMA_NBLK) = nblocks;
+	ACCEL_REG(ACCEL_CTRL) = ACCEL_CTRL_DMA | ACCEL_CTRL_GO;
+
+	for (i = 0; i < nblocks; ++i) {
+    //** Do not remove this/modify code **
+	total_num_of_sha256_ops++;
+    //** End of do not remove/modify this code **
+	}
+}
+#endif
+#elif defined(SHA256_ASM)
+void SHA256Transform(SHA256_CTX *ctx, uchar data[])
+{
+	SHA256Compress(ctx->state, data);
+    //** Do not remove this/modify code **
+	total_num_of_sha256_ops++;
+    //** End of do not remove/modify this code **
+}
+#elif defined(SHA256_UNROLLED)
+void SHA256Transform(SHA256_CTX *ctx, uchar data[])
+{
+	SHA256CompressUnrolled(ctx->state, data);
+    //** Do not remove this/modify code **
+	total_num_of_sha256_ops++;
+    //** End of do not remove/modify this code **
+}
+#else
+void SHA256Transform(SHA256_CTX *ctx, uchar data[])
+{
+	SHA256CompressRolled(ctx->state, data);
+    //** Do not remove this/modify code **
+	total_num_of_sha256_ops++;
+    //** End of do not remove/modify this code **
+}
+#endif
+
+#if !defined(SHA256_ACCEL) && !defined(SHA256_ASM)
+// Two independent compressions with their rounds interleaved: the core always has an
+// instruction of the other chain to issue while one waits for a load or a result
+#define SHA256_TRANSFORM2
+
+#define B2_W(m, i) (m[(i) & 15])
+#define B2_X(m, i) (m[(i) & 15] += SIG1(m[((i) - 2) & 15]) + m[((i) - 7) & 15] + SIG0(m[((i) - 15) & 15]))
+
+#define B2_ROUND(W, i, a,b,c,d,e,f,g,h, A,B,C,D,E,F,G,H) \
+	t1 = h + EP1(e) + CH(e, f, g) + k[i] + W(m0, i); \
+	u1 = H + EP1(E) + CH(E, F, G) + k[i] + W(m1, i); \
+	d += t1; \
+	D += u1; \
+	h = t1 + EP0(a) + MAJ(a, b, c); \
+	H = u1 + EP0(A) + MAJ(A, B, C)
+
+#define B2_ROUND8(W, i) \
+	B2_ROUND(W, (i) + 0, a, b, c, d, e, f, g, h, A, B, C, D, E, F, G, H); \
+	B2_ROUND(W, (i) + 1, h, a, b, c, d, e, f, g, H, A, B, C, D, E, F, G); \
+	B2_ROUND(W, (i) + 2, g, h, a, b, c, d, e, f, G, H, A, B, C, D, E, F); \
+	B2_ROUND(W, (i) + 3, f, g, h, a, b, c, d, e, F, G, H, A, B, C, D, E); \
+	B2_ROUND(W, (i) + 4, e, f, g, h, a, b, c, d, E, F, G, H, A, B, C, D); \
+	B2_ROUND(W, (i) + 5, d, e, f, g, h, a, b, c, D, E, F, G, H, A, B, C); \
+	B2_ROUND(W, (i) + 6, c, d, e, f, g, h, a, b, C, D, E, F, G, H, A, B); \
+	B2_ROUND(W, (i) + 7, b, c, d, e, f, g, h, a, B, C, D, E, F, G, H, A)
+
+void SHA256Transform2(SHA256_CTX *ctx0, const uchar data0[], SHA256_CTX *ctx1, const uchar data1[])
+{
+	uint a, b, c, d, e, f, g, h, t1, m0[16];
+	uint A, B, C, D, E, F, G, H, u1, m1[16];
+	uint i;
+
+	SHA256LoadBlock(m0, data0);
+	SHA256LoadBlock(m1, data1);
+	a = ctx0->state[0]; A = ctx1->state[0];
+	b = ctx0->state[1]; B = ctx1->state[1];
+	c = ctx0->state[2]; C = ctx1->state[2];
+	d = ctx0->state[3]; D = ctx1->state[3];
+	e = ctx0->state[4]; E = ctx1->state[4];
+	f = ctx0->state[5]; F = ctx1->state[5];
+	g = ctx0->state[6]; G = ctx1->state[6];
+	h = ctx0->state[7]; H = ctx1->state[7];
+
+	for (i = 0; i < 16; i += 8) {
+		B2_ROUND8(B2_W, i);
+	}
+	for (; i < 64; i += 8) {
+		B2_ROUND8(B2_X, i);
+	}
+
+	ctx0->state[0] += a; ctx1->state[0] += A;
+	ctx0->state[1] += b; ctx1->state[1] += B;
+	ctx0->state[2] += c; ctx1->state[2] += C;
+	ctx0->state[3] += d; ctx1->state[3] += D;
+	ctx0->state[4] += e; ctx1->state[4] += E;
+	ctx0->state[5] += f; ctx1->state[5] += F;
+	ctx0->state[6] += g; ctx1->state[6] += G;
+	ctx0->state[7] += h; ctx1->state[7] += H;
+	for (i = 0; i < 2; ++i) {
     //** Do not remove this/modify code **
 	total_num_of_sha256_ops++;
     //** End of do not remove/modify this code **
+	}
 }
+#endif
 
+// Streaming update: bytes left over from the previous call are topped up to a block, whole
+// blocks are compressed straight from data and only the tail is kept in ctx->data
 void SHA256Update(SHA256_CTX *ctx, uchar data[], uint len, int ilen)
 {
-	uint i = 63;
-	uchar *copy = data;
-	ctx->datalen = len%64 + 1;
-	
-	while (i<len){
-		SHA256Transform(ctx, copy);
-        copy+=64;
+	uint n;
+
+	if (ctx->datalen) {
+		n = 64 - ctx->datalen;
+		if (n > len)
+			n = len;
+		memcpy(ctx->data + ctx->datalen, data, n);
+		ctx->datalen += n;
+		data += n;
+		len -= n;
+		if (ctx->datalen < 64)
+			return;
+		SHA256Transform(ctx, ctx->data);
 		DBL_INT_ADD(ctx->bitlen[0], ctx->bitlen[1], 512);
-		i+=64;
+		ctx->datalen = 0;
 	}
-	
-	for (uint j = (len/64)*64 ; j< len; j++){
-	    ctx->data[j%64] = data[j];
-	    ctx->datalen = j%64+1;
+
+#ifdef SHA256_ACCEL_DMA
+	// Whole blocks of word-aligned data in the TCM are hashed in one DMA operation
+	if (len > 63 && !((uint)data & 3) && ACCEL_IN_TCM(data, len & ~63u)) {
+		n = len / 64;
+		SHA256TransformBlocks(ctx, data, n);
+		DBL_INT_ADD(ctx->bitlen[0], ctx->bitlen[1], n * 512);
+		data += n * 64;
+		len -= n * 64;
+	}
+#endif
+
+#ifdef SHA256_ACCEL
+	// The remaining whole blocks are streamed through the accelerator message buffer
+	if (len > 63) {
+		n = len / 64;
+		SHA256TransformStream(ctx, data, n);
+		DBL_INT_ADD(ctx->bitlen[0], ctx->bitlen[1], n * 512);
+		data += n * 64;
+		len -= n * 64;
 	}
+#endif
 
+	while (len > 63) {
+		SHA256Transform(ctx, data);
+		DBL_INT_ADD(ctx->bitlen[0], ctx->bitlen[1], 512);
+		data += 64;
+		len -= 64;
+	}
+
+	memcpy(ctx->data, data, len);
+	ctx->datalen = len;
 }
 
+#ifdef SHA256_ACCEL
+// Padding and the message length are appended by the accelerator
+void SHA256Final(SHA256_CTX *ctx, uchar hash[])
+{
+	uint i, j;
+
+#ifdef SHA256_ACCEL_DMA
+	// DATALEN is read-only while a DMA transfer of this stream runs
+	if (accel_ctx == ctx) {
+		while (!(ACCEL_REG(ACCEL_CTRL) & ACCEL_CTRL_DONE))
+			;
+	}
+#endif
+	SHA256AccelRestore(ctx);
+	while (ACCEL_REG(ACCEL_CTRL) & ACCEL_CTRL_PEND)
+		;
+	ACCEL_REG(ACCEL_DATALEN) = ctx->datalen;
+	for (i = 0, j = 0; j < ctx->datalen; ++i, j += 4)
+		ACCEL_REG(ACCEL_MSG(i)) = (ctx->data[j] << 24) | (ctx->data[j + 1] << 16) | (ctx->data[j + 2] << 8) | (ctx->data[j + 3]);
+
+	ACCEL_REG(ACCEL_CTRL) = ACCEL_CTRL_FINAL | ACCEL_CTRL_GO;
+	while (!(ACCEL_REG(ACCEL_CTRL) & ACCEL_CTRL_DONE))
+		;
+
+	for (i = 0; i < 8; ++i) {
+		ctx->state[i] = ACCEL_REG(ACCEL_STATE(i));
+		hash[4 * i]     = ctx->state[i] >> 24;
+		hash[4 * i + 1] = ctx->state[i] >> 16;
+		hash[4 * i + 2] = ctx->state[i] >> 8;
+		hash[4 * i + 3] = ctx->state[i];
+	}
+	accel_ctx = 0;
+	// The length needs a block of its own when it does not fit after the data
+	for (i = (ctx->datalen < 56) ? 1 : 2; i > 0; --i) {
+    //** Do not remove this/modify code **
+	total_num_of_sha256_ops++;
+    //** End of do not remove/modify this code **
+	}
+}
+#else
 void SHA256Final(SHA256_CTX *ctx, uchar hash[])
 {
 	uint i = ctx->datalen;
@@ -296,19 +655,67 @@ void SHA256Final(SHA256_CTX *ctx, uchar hash[])
 	
 	
 }
+#endif
 
+// One-shot hash of a message that fits in a single padded block (len < 56). The block is
+// built in a word buffer on the stack, zero filled, with the 0x80 marker after the message
+// and the bit length in the last word, and compressed once: no context to update and pad
+void SHA256Short(const uchar data[], uint len, uchar hash[])
+{
+	uint blk[16];
+	uint i;
+#ifdef SHA256_ACCEL
+	uint w;
 
+	// The accelerator pads the block itself; INIT loads the initial state
+	SHA256AccelSave();
+	for (i = 0; i < 14; ++i)
+		blk[i] = 0;
+	memcpy(blk, data, len);
+	ACCEL_REG(ACCEL_MODE) = ACCEL_MODE_SHA256;
+	for (i = 0; 4 * i < len; ++i) {
+		w = blk[i];
+		ACCEL_REG(ACCEL_MSG(i)) = BSWAP32(w);
+	}
+	ACCEL_REG(ACCEL_DATALEN) = len;
+	ACCEL_REG(ACCEL_CTRL) = ACCEL_CTRL_INIT | ACCEL_CTRL_FINAL | ACCEL_CTRL_GO;
+	while (!(ACCEL_REG(ACCEL_CTRL) & ACCEL_CTRL_DONE))
+		;
+	for (i = 0; i < 8; ++i)
+		blk[i] = ACCEL_REG(ACCEL_STATE(i));
+	SHA256StoreState(hash, blk);
+    //** Do not remove this/modify code **
+	total_num_of_sha256_ops++;
+    //** End of do not remove/modify this code **
+#else
+	SHA256_CTX ctx;
 
+	for (i = 0; i < 15; ++i)
+		blk[i] = 0;
+	memcpy(blk, data, len);
+	((uchar *)blk)[len] = 0x80;
+	i = len << 3;
+	blk[15] = BSWAP32(i);
+
+	SHA256Init(&ctx);
+	SHA256Transform(&ctx, (uchar *)blk);
+	SHA256StoreState(hash, ctx.state);
+#endif
+}
 
 void SHA256(char* data) {
 	int strLen = strlen(data);
 	SHA256_CTX ctx;
 	unsigned char hash[32];
 
-	SHA256Init(&ctx);
-	//printf("strlen is %d \n", strLen);`
-	SHA256Update(&ctx, data, strLen, strLen);
-    SHA256Final(&ctx, hash);
+	// A message that fits in one block with its padding needs a single compression
+	if (strLen < 56) {
+		SHA256Short((uchar *)data, strLen, hash);
+	} else {
+		SHA256Init(&ctx);
+		SHA256Update(&ctx, data, strLen, strLen);
+		SHA256Final(&ctx, hash);
+	}
 
 	//char s[3];
 	for (int i = 0; i < 32; i++) printf("%02x", hash[i]);
@@ -316,12 +723,553 @@ void SHA256(char* data) {
 
 }
 
+// The tail of a message with its padding and bit length, ready to compress; returns the
+// number of blocks (1, or 2 when the length does not fit after the tail)
+static uint SHA256PadTail(uchar pad[128], const uchar msg[], uint len)
+{
+	uint rem = len % 64;
+	uint n = (rem < 56) ? 64 : 128;
+
+	memcpy(pad, msg + len - rem, rem);
+	pad[rem] = 0x80;
+	memset(pad + rem + 1, 0, n - rem - 9);
+	pad[n - 8] = 0;
+	pad[n - 7] = 0;
+	pad[n - 6] = 0;
+	pad[n - 5] = len >> 29;
+	pad[n - 4] = len >> 21;
+	pad[n - 3] = len >> 13;
+	pad[n - 2] = len >> 5;
+	pad[n - 1] = len << 3;
+	return n / 64;
+}
+
+#define BATCH_BLOCK(j, b) ((b) < full[j] ? msgs[i + (j)] + 64 * (b) : pad[j] + 64 * ((b) - full[j]))
+
+// Hash n messages. The padded final blocks are built up front, so every message is a plain
+// run of blocks; in software builds the blocks of two messages are compressed together
+void SHA256_batch(const uchar **msgs, const uint *lens, uint n, uchar digests[][32])
+{
+	SHA256_CTX ctx[2];
+	uchar pad[2][128] __attribute__((aligned(4)));
+	uint full[2], nblocks[2];
+	uint i, j, b, w, ways;
+
+	for (i = 0; i < n; i += ways) {
+		ways = (n - i < 2) ? n - i : 2;
+		for (j = 0; j < ways; ++j) {
+			SHA256Init(&ctx[j]);
+			full[j] = lens[i + j] / 64;
+			nblocks[j] = full[j] + SHA256PadTail(pad[j], msgs[i + j], lens[i + j]);
+		}
+
+		b = 0;
+#ifdef SHA256_TRANSFORM2
+		if (ways == 2) {
+			for (; b < nblocks[0] && b < nblocks[1]; ++b)
+				SHA256Transform2(&ctx[0], BATCH_BLOCK(0, b), &ctx[1], BATCH_BLOCK(1, b));
+		}
+#endif
+		for (j = 0; j < ways; ++j) {
+			for (w = b; w < nblocks[j]; ++w)
+				SHA256Transform(&ctx[j], (uchar *)BATCH_BLOCK(j, w));
+		}
+#ifdef SHA256_ACCEL
+		// Bring the last state back from the accelerator; ctx goes out of scope
+		SHA256AccelSave();
+#endif
+
+		for (j = 0; j < ways; ++j)
+			SHA256StoreState(digests[i + j], ctx[j].state);
+	}
+}
+
+// The context after a prefix of whole blocks; returns -1 when the prefix leaves bytes in
+// ctx->data, which a midstate does not hold
+int SHA256Snapshot(SHA256_CTX *ctx, SHA256_MIDSTATE *mid)
+{
+	uint i;
+
+	if (ctx->datalen)
+		return -1;
+#ifdef SHA256_ACCEL
+	if (accel_ctx == ctx)
+		SHA256AccelSave();
+#endif
+	for (i = 0; i < 8; ++i)
+		mid->state[i] = ctx->state[i];
+	mid->bitlen[0] = ctx->bitlen[0];
+	mid->bitlen[1] = ctx->bitlen[1];
+	return 0;
+}
+
+// Start ctx from a midstate instead of SHA256Init: the suffix is then hashed as usual
+void SHA256Clone(SHA256_CTX *ctx, const SHA256_MIDSTATE *mid)
+{
+	uint i;
+
+	ctx->datalen = 0;
+	ctx->bitlen[0] = mid->bitlen[0];
+	ctx->bitlen[1] = mid->bitlen[1];
+	for (i = 0; i < 8; ++i)
+		ctx->state[i] = mid->state[i];
+#ifdef SHA256_ACCEL
+	// Leave the accelerator idle: BITLEN and STATE writes of the next restore are ignored while busy
+	if (accel_ctx == ctx) {
+		while (!(ACCEL_REG(ACCEL_CTRL) & ACCEL_CTRL_DONE))
+			;
+		accel_ctx = 0;
+	}
+#endif
+}
+
+// Midstates of recently used prefixes, looked up by the caller's key and the prefix length.
+// The table is static data, so it sits in the TCM with the rest of the image; a miss
+// compresses the prefix into the least recently used entry
+static struct {
+	uint key;
+	uint len;
+	uint used;
+	SHA256_MIDSTATE mid;
+} sha256_cache[SHA256_CACHE_SIZE];
+static uint sha256_cache_tick;
+
+const SHA256_MIDSTATE *SHA256CacheGet(uint key, const uchar prefix[], uint len)
+{
+	SHA256_CTX ctx;
+	uint i, lru = 0;
+
+	if (!len || len % 64)
+		return 0;
+	++sha256_cache_tick;
+	for (i = 0; i < SHA256_CACHE_SIZE; ++i) {
+		if (sha256_cache[i].len == len && sha256_cache[i].key == key) {
+			sha256_cache[i].used = sha256_cache_tick;
+			return &sha256_cache[i].mid;
+		}
+		if (sha256_cache[i].used < sha256_cache[lru].used)
+			lru = i;
+	}
+
+	SHA256Init(&ctx);
+	SHA256Update(&ctx, (uchar *)prefix, len, len);
+	SHA256Snapshot(&ctx, &sha256_cache[lru].mid);
+	sha256_cache[lru].key = key;
+	sha256_cache[lru].len = len;
+	sha256_cache[lru].used = sha256_cache_tick;
+	return &sha256_cache[lru].mid;
+}
+
+// Forget every cached midstate, e.g. when a key now names a different prefix
+void SHA256CacheFlush(void)
+{
+	uint i;
+
+	for (i = 0; i < SHA256_CACHE_SIZE; ++i) {
+		sha256_cache[i].len = 0;
+		sha256_cache[i].used = 0;
+	}
+}
+
+// HMAC-SHA256 (RFC 2104). The key blocks (key ^ ipad) and (key ^ opad) are compressed once
+// here; every MAC under the key then starts from the two midstates
+void SHA256HmacKey(SHA256_HMAC_KEY *hk, const uchar key[], uint keylen)
+{
+	SHA256_CTX ctx;
+	uint blk[16];
+	uint i;
+
+	for (i = 0; i < 16; ++i)
+		blk[i] = 0;
+	// A key longer than a block is replaced by its hash
+	if (keylen > 64) {
+		SHA256Init(&ctx);
+		SHA256Update(&ctx, (uchar *)key, keylen, keylen);
+		SHA256Final(&ctx, (uchar *)blk);
+	} else {
+		memcpy(blk, key, keylen);
+	}
+
+	for (i = 0; i < 16; ++i)
+		blk[i] ^= 0x36363636;
+	SHA256Init(&ctx);
+	SHA256Update(&ctx, (uchar *)blk, 64, 64);
+	SHA256Snapshot(&ctx, &hk->inner);
+
+	for (i = 0; i < 16; ++i)
+		blk[i] ^= 0x36363636 ^ 0x5c5c5c5c;
+	SHA256Init(&ctx);
+	SHA256Update(&ctx, (uchar *)blk, 64, 64);
+	SHA256Snapshot(&ctx, &hk->outer);
+}
+
+// Start the inner hash; the message is then added with SHA256Update
+void SHA256HmacInit(SHA256_CTX *ctx, const SHA256_HMAC_KEY *hk)
+{
+	SHA256Clone(ctx, &hk->inner);
+}
+
+// Finish the inner hash and compress it from the outer midstate: one block
+void SHA256HmacFinal(SHA256_CTX *ctx, const SHA256_HMAC_KEY *hk, uchar mac[])
+{
+	uchar ihash[32];
+
+	SHA256Final(ctx, ihash);
+	SHA256Clone(ctx, &hk->outer);
+	SHA256Update(ctx, ihash, 32, 32);
+	SHA256Final(ctx, mac);
+}
+
+void SHA256Hmac(const SHA256_HMAC_KEY *hk, const uchar msg[], uint len, uchar mac[])
+{
+	SHA256_CTX ctx;
+
+	SHA256HmacInit(&ctx, hk);
+	SHA256Update(&ctx, (uchar *)msg, len, len);
+	SHA256HmacFinal(&ctx, hk, mac);
+}
+
+// Compress blk, a 32-byte message already padded after a key block (768 bits), from a
+// midstate and write the digest into the first 32 bytes of out
+static void SHA256HmacBlock(const SHA256_MIDSTATE *mid, uint blk[16], uint out[16])
+{
+	SHA256_CTX ctx;
+
+	SHA256Clone(&ctx, mid);
+	SHA256Transform(&ctx, (uchar *)blk);
+#ifdef SHA256_ACCEL
+	SHA256AccelSave();
+#endif
+	SHA256StoreState((uchar *)out, ctx.state);
+}
+
+// PBKDF2-HMAC-SHA256 (RFC 8018): dklen bytes derived from the password and salt. The HMAC
+// midstates of the password are computed once, and from the second iteration on U is 32
+// bytes, so each iteration is one inner and one outer compression of a block padded in place
+void SHA256Pbkdf2(const uchar pass[], uint passlen, const uchar salt[], uint saltlen,
+		  uint iters, uchar dk[], uint dklen)
+{
+	SHA256_HMAC_KEY hk;
+	SHA256_CTX ctx;
+	uint ublk[16], oblk[16], t[8];
+	uchar cnt[4];
+	uint blkno, i, j, n;
+
+	SHA256HmacKey(&hk, pass, passlen);
+
+	// Padding and the 768-bit length of both blocks never change
+	for (i = 8; i < 16; ++i) {
+		ublk[i] = 0;
+		oblk[i] = 0;
+	}
+	((uchar *)ublk)[32] = 0x80;
+	((uchar *)oblk)[32] = 0x80;
+	i = 768;
+	ublk[15] = BSWAP32(i);
+	oblk[15] = ublk[15];
+
+	for (blkno = 1; dklen > 0; ++blkno) {
+		// U1 = HMAC(pass, salt || INT(blkno))
+		cnt[0] = blkno >> 24;
+		cnt[1] = blkno >> 16;
+		cnt[2] = blkno >> 8;
+		cnt[3] = blkno;
+		SHA256HmacInit(&ctx, &hk);
+		SHA256Update(&ctx, (uchar *)salt, saltlen, saltlen);
+		SHA256Update(&ctx, cnt, 4, 4);
+		SHA256HmacFinal(&ctx, &hk, (uchar *)ublk);
+		for (j = 0; j < 8; ++j)
+			t[j] = ublk[j];
+
+		for (i = 1; i < iters; ++i) {
+			SHA256HmacBlock(&hk.inner, ublk, oblk);
+			SHA256HmacBlock(&hk.outer, oblk, ublk);
+			for (j = 0; j < 8; ++j)
+				t[j] ^= ublk[j];
+		}
+
+		n = (dklen < 32) ? dklen : 32;
+		memcpy(dk, t, n);
+		dk += n;
+		dklen -= n;
+	}
+}
+
+#ifdef SHA256_BATCH
+// Hash all messages with SHA256_batch, then print the digests
+void SHA256Batch(char data[][256], int n)
+{
+	static const uchar *msgs[20];
+	static uint lens[20];
+	static uchar hash[20][32];
+	int i, j;
+
+	for (i = 0; i < n; ++i) {
+		msgs[i] = (const uchar *)data[i];
+		lens[i] = strlen(data[i]);
+	}
+	SHA256_batch(msgs, lens, n, hash);
+
+	for (i = 0; i < n; ++i) {
+		for (j = 0; j < 32; j++) printf("%02x", hash[i][j]);
+		printf("\n");
+	}
+}
+#endif
+
+#ifdef SHA256_PREFIX
+// Hash a fixed 64-byte header followed by each message: the header is compressed once and
+// every message starts from a clone of its cached midstate
+void SHA256Prefix(char data[][256], int n)
+{
+	static const uchar header[64] __attribute__((aligned(4))) =
+		"SCR1 SHA-256 demo header: the same 64-byte block for every msg.";
+	const SHA256_MIDSTATE *mid;
+	SHA256_CTX ctx;
+	uchar hash[32];
+	int i, j, len;
+
+	for (i = 0; i < n; ++i) {
+		mid = SHA256CacheGet(1, header, sizeof(header));
+		len = strlen(data[i]);
+		SHA256Clone(&ctx, mid);
+		SHA256Update(&ctx, (uchar *)data[i], len, len);
+		SHA256Final(&ctx, hash);
+		for (j = 0; j < 32; j++) printf("%02x", hash[j]);
+		printf("\n");
+	}
+}
+#endif
+
+#ifdef SHA256_HMAC
+#ifndef SHA256_PBKDF2_ITERS
+#define SHA256_PBKDF2_ITERS	16
+#endif
+
+// Derive a 32-byte key from each message with PBKDF2-HMAC-SHA256 and print it; returns the
+// number of PBKDF2 iterations
+int SHA256Kdf(char data[][256], int n)
+{
+	static const uchar salt[] = "scr1-sha256";
+	uchar dk[32];
+	int i, j;
+
+	for (i = 0; i < n; ++i) {
+		SHA256Pbkdf2((uchar *)data[i], strlen(data[i]), salt, sizeof(salt) - 1,
+			     SHA256_PBKDF2_ITERS, dk, sizeof(dk));
+		for (j = 0; j < 32; j++) printf("%02x", dk[j]);
+		printf("\n");
+	}
+	return n * SHA256_PBKDF2_ITERS;
+}
+#endif
+
+#ifdef SHA256_ACCEL_RING
+// Queue all messages on the accelerator descriptor ring and wait only for the last one.
+// The ring DMA reaches the TCM only, so a message outside it is hashed through MSG after
+void SHA256Ring(char data[][256], int n)
+{
+	static uchar hash[20][32] __attribute__((aligned(4)));
+	SHA256_CTX ctx;
+	uint tail, len;
+	int i, j;
+
+	SHA256AccelSave();
+	ACCEL_REG(ACCEL_MODE) = ACCEL_MODE_SHA256;
+	tail = ACCEL_REG(ACCEL_RING_TAIL);
+	for (i = 0; i < n; ++i) {
+		len = strlen(data[i]);
+		if (!ACCEL_IN_TCM(data[i], len) || !ACCEL_IN_TCM(hash[i], 32))
+			continue;
+		while (((tail - ACCEL_REG(ACCEL_RING_HEAD)) & (2 * ACCEL_RING_DEPTH - 1)) == ACCEL_RING_DEPTH)
+			;
+		ACCEL_REG(ACCEL_RING_ADDR(tail % ACCEL_RING_DEPTH)) = (uint)data[i];
+		ACCEL_REG(ACCEL_RING_LEN(tail % ACCEL_RING_DEPTH)) = len;
+		ACCEL_REG(ACCEL_RING_DST(tail % ACCEL_RING_DEPTH)) = (uint)hash[i];
+		tail = (tail + 1) & (2 * ACCEL_RING_DEPTH - 1);
+		ACCEL_REG(ACCEL_RING_TAIL) = tail;
+		// Whole blocks, the padded last block and the extra length block if needed
+		for (j = len / 64 + ((len % 64) < 56 ? 1 : 2); j > 0; --j) {
+    //** Do not remove this/modify code **
+	total_num_of_sha256_ops++;
+    //** End of do not remove/modify this code **
+		}
+	}
+	while (ACCEL_REG(ACCEL_RING_HEAD) != tail)
+		;
+	for (i = 0; i < n; ++i) {
+		len = strlen(data[i]);
+		if (ACCEL_IN_TCM(data[i], len) && ACCEL_IN_TCM(hash[i], 32))
+			continue;
+		SHA256Init(&ctx);
+		SHA256Update(&ctx, (uchar *)data[i], len, len);
+		SHA256Final(&ctx, hash[i]);
+	}
+
+	for (i = 0; i < n; ++i) {
+		for (j = 0; j < 32; j++) printf("%02x", hash[i][j]);
+		printf("\n");
+	}
+}
+#endif
+
+#ifdef SHA256_ACCEL_LANES
+// Hash SHA256_ACCEL_LANES messages at once, one per accelerator lane: block b of every
+// message is submitted before block b + 1 of any, so all lanes compress together
+void SHA256Lanes(char data[][256], int n)
+{
+	uint len[SHA256_ACCEL_LANES];
+	uint i, j, k, m, off, rem, ops, active;
+	uchar *block;
+	int base;
+
+	SHA256AccelSave();
+	ACCEL_REG(ACCEL_MODE) = ACCEL_MODE_SHA256;
+	for (base = 0; base < n; base += SHA256_ACCEL_LANES) {
+		m = (n - base < SHA256_ACCEL_LANES) ? n - base : SHA256_ACCEL_LANES;
+		for (k = 0; k < m; ++k)
+			len[k] = strlen(data[base + k]);
+		for (off = 0, active = 1; active; off += 64) {
+			active = 0;
+			for (k = 0; k < m; ++k) {
+				if (off > len[k])
+					continue;
+				active = 1;
+				rem = len[k] - off;
+				block = (uchar *)data[base + k] + off;
+				while (ACCEL_LANE(k, ACCEL_CTRL) & ACCEL_CTRL_PEND)
+					;
+				for (i = 0, j = 0; i < 16; ++i, j += 4)
+					ACCEL_LANE(k, ACCEL_MSG(i)) = (block[j] << 24) | (block[j + 1] << 16) | (block[j + 2] << 8) | (block[j + 3]);
+				if (rem < 64) {
+					ACCEL_LANE(k, ACCEL_DATALEN) = rem;
+					ACCEL_LANE(k, ACCEL_CTRL) = (off ? 0 : ACCEL_CTRL_INIT) | ACCEL_CTRL_FINAL | ACCEL_CTRL_GO;
+				} else {
+					ACCEL_LANE(k, ACCEL_CTRL) = (off ? 0 : ACCEL_CTRL_INIT) | ACCEL_CTRL_GO;
+				}
+				// The length needs a block of its own when it does not fit after the data
+				for (ops = (rem < 56 || rem >= 64) ? 1 : 2; ops > 0; --ops) {
+    //** Do not remove this/modify code **
+	total_num_of_sha256_ops++;
+    //** End of do not remove/modify this code **
+				}
+			}
+		}
+
+		for (k = 0; k < m; ++k) {
+			while (!(ACCEL_LANE(k, ACCEL_CTRL) & ACCEL_CTRL_DONE))
+				;
+			for (i = 0; i < 8; ++i) {
+				uint h = ACCEL_LANE(k, ACCEL_STATE(i));
+				printf("%02x%02x%02x%02x", h >> 24, (h >> 16) & 0xff, (h >> 8) & 0xff, h & 0xff);
+			}
+			printf("\n");
+		}
+	}
+}
+#endif
+
+#ifdef SHA256_DRV
+// Submit every message before waiting for the first, so the accelerator hashes while the
+// core queues the rest
+void SHA256Drv(char data[][256], int n)
+{
+	static SHA256_JOB job[20];
+	static uchar hash[20][32] __attribute__((aligned(4)));
+	int i, j;
+
+	for (i = 0; i < n; ++i) {
+		job[i].data = (uchar *)data[i];
+		job[i].len = strlen(data[i]);
+		job[i].digest = hash[i];
+		SHA256DrvSubmit(&job[i]);
+	}
+
+	for (i = 0; i < n; ++i) {
+		SHA256DrvWait(&job[i]);
+		for (j = 0; j < 32; j++) printf("%02x", hash[i][j]);
+		printf("\n");
+	}
+}
+#endif
+
+#ifdef SHA256_BENCH
+// Cycles per block of a compression function, averaged over 64 calls on one block
+static uint SHA256BenchCompress(void (*compress)(uint state[8], const uchar data[]), const uchar block[])
+{
+	uint state[8], i, start;
+
+	for (i = 0; i < 8; ++i)
+		state[i] = i;
+	compress(state, block);
+	start = csr_read(0xc00);
+	for (i = 0; i < 64; ++i)
+		compress(state, block);
+	return (csr_read(0xc00) - start) / 64;
+}
+
+#if defined(SHA256_ACCEL) || defined(SHA256_DRV)
+// Cycles per block on accelerator lane 0, streamed as SHA256TransformStream does:
+// each block is written while the previous one compresses and its GO is queued
+static uint SHA256BenchAccel(const uchar block[])
+{
+	uint i, b, start, m[16];
+
+#ifdef SHA256_ACCEL
+	SHA256AccelSave();
+#endif
+	SHA256LoadBlock(m, block);
+	ACCEL_REG(ACCEL_MODE) = ACCEL_MODE_SHA256;
+	ACCEL_REG(ACCEL_CTRL) = ACCEL_CTRL_INIT;
+	start = csr_read(0xc00);
+	for (b = 0; b < 64; ++b) {
+		while (ACCEL_REG(ACCEL_CTRL) & ACCEL_CTRL_PEND)
+			;
+		for (i = 0; i < 16; ++i)
+			ACCEL_REG(ACCEL_MSG(i)) = m[i];
+		ACCEL_REG(ACCEL_CTRL) = ACCEL_CTRL_GO;
+	}
+	while (!(ACCEL_REG(ACCEL_CTRL) & ACCEL_CTRL_DONE))
+		;
+	return (csr_read(0xc00) - start) / 64;
+}
+#endif
+
+// Every compression variant on the same block, side by side; the accelerator only
+// when this build drives it and, with ACCEL=auto, the probe finds it
+void SHA256Bench(void)
+{
+	static uchar block[64];
+	uint i;
+
+	for (i = 0; i < 64; ++i)
+		block[i] = i;
+	printf("Cycles per block:\n");
+	printf("  rolled      %d\n", SHA256BenchCompress(SHA256CompressRolled, block));
+	printf("  unrolled    %d\n", SHA256BenchCompress(SHA256CompressUnrolled, block));
+	printf("  asm         %d\n", SHA256BenchCompress(SHA256Compress, block));
+#if defined(SHA256_DRV)
+	if (SHA256DrvInit() != SHA256_DRV_SW)
+		printf("  accelerator %d\n", SHA256BenchAccel(block));
+	else
+		printf("  accelerator -\n");
+#elif defined(SHA256_ACCEL)
+	printf("  accelerator %d\n", SHA256BenchAccel(block));
+#else
+	printf("  accelerator -\n");
+#endif
+}
+#endif
+
 int main(void)
 {		
 
     unsigned int mcycle_l_start, mcycle_h_start;
     unsigned int mcycle_l_end, mcycle_h_end;
     unsigned int total_time_l, total_time_h;
+#ifdef SHA256_HMAC
+    int kdf_iters;
+#endif
 
     char secrets[20][256] = {
 	"I used to play piano by ear, but now I use my hands.",
@@ -347,13 +1295,30 @@ int main(void)
 };
 
     printf("SHA256 is RUNNING!! \n");
+#ifdef SHA256_DRV
+    printf("SHA256 backend: %s\n", SHA256DrvName(SHA256DrvInit()));
+#endif
 
     //****** Do not remove this/modify code ******
     mcycle_l_start = csr_read(0xc00);
     mcycle_h_start = csr_read(0xc80);
     //****** End of do not remove/modify this code ******
     
+#ifdef SHA256_ACCEL_RING
+    SHA256Ring(secrets, 20);
+#elif defined(SHA256_ACCEL_LANES)
+    SHA256Lanes(secrets, 20);
+#elif defined(SHA256_DRV)
+    SHA256Drv(secrets, 20);
+#elif defined(SHA256_BATCH)
+    SHA256Batch(secrets, 20);
+#elif defined(SHA256_PREFIX)
+    SHA256Prefix(secrets, 20);
+#elif defined(SHA256_HMAC)
+    kdf_iters = SHA256Kdf(secrets, 20);
+#else
     for(int i=0; i<20; i++) SHA256(secrets[i]);
+#endif
 	
     //****** Do not remove this/modify code ******
     mcycle_l_end = csr_read(0xc00);
@@ -374,5 +1339,11 @@ int main(void)
     printf("For Throughput calculation divide %d by total time (hex) %08x%08x\n", total_num_of_sha256_ops, total_time_h, total_time_l);
     //****** End of do not remove/modify this code ******
 
+#ifdef SHA256_HMAC
+    printf("For PBKDF2 iterations per second divide %d by total time (hex) %08x%08x\n", kdf_iters, total_time_h, total_time_l);
+#endif
+#ifdef SHA256_BENCH
+    SHA256Bench();
+#endif
     return 0;
 }
@@ -0,0 +1,107 @@
+#ifndef SHA256_H
+#define SHA256_H
+
+#define uchar unsigned char
+#define uint unsigned int
+
+// Memory-mapped accelerator (scr1_accel)
+#define ACCEL_BASE		0xF0030000
+#define ACCEL_REG(off)		(*(volatile uint *)(ACCEL_BASE + (off)))
+#define ACCEL_CTRL		0x00
+#define ACCEL_COUNTER		0x04
+#define ACCEL_MODE		0x14
+#define ACCEL_DMA_SRC		0x18
+#define ACCEL_DMA_NBLK		0x1C
+#define ACCEL_RING_HEAD		0x20
+#define ACCEL_RING_TAIL		0x24
+#define ACCEL_DATALEN		0x34
+#define ACCEL_BITLEN0		0x38
+#define ACCEL_BITLEN1		0x3C
+#define ACCEL_STATE(i)		(0x40 + 4 * (i))
+#define ACCEL_MSG(i)		(0x80 + 4 * (i))
+#define ACCEL_RING_ADDR(i)	(0xC0 + 16 * (i))
+#define ACCEL_RING_LEN(i)	(0xC4 + 16 * (i))
+#define ACCEL_RING_DST(i)	(0xC8 + 16 * (i))
+#define ACCEL_RING_DEPTH	4
+#define ACCEL_LANE(k, off)	ACCEL_REG(0x100 * (k) + (off))
+
+// Identification window, above every lane window
+#define ACCEL_ID		0xFF00
+#define ACCEL_CAPS		0xFF04
+#define ACCEL_ID_MAGIC		0x5C1A
+#define ACCEL_ID_MAJOR		1
+
+#define ACCEL_CTRL_GO		(1u << 0)
+#define ACCEL_CTRL_INIT		(1u << 1)
+#define ACCEL_CTRL_DMA		(1u << 2)	// write: fetch the blocks from DMA_SRC
+#define ACCEL_CTRL_FINAL	(1u << 3)
+#define ACCEL_CTRL_PEND		(1u << 2)	// read: a queued GO still needs MSG (bit 2 is DMA on write)
+#define ACCEL_CTRL_ERR		(1u << 30)
+#define ACCEL_CTRL_DONE		(1u << 31)	// read: the last operation completed
+#define ACCEL_CTRL_ACK		(1u << 31)	// write: clear done and ERR (bit 31 is done on read)
+#define ACCEL_MODE_SHA256	1
+
+// TCM window the accelerator DMA reaches (common/tcm.ld)
+#ifndef ACCEL_TCM_BASE
+#define ACCEL_TCM_BASE		0xF0000000
+#endif
+#ifndef ACCEL_TCM_SIZE
+#define ACCEL_TCM_SIZE		0x10000
+#endif
+// Nonzero if len bytes at p lie in that window; the TCM answers any other address with an error
+#define ACCEL_IN_TCM(p, len)	((uint)(p) - ACCEL_TCM_BASE < ACCEL_TCM_SIZE && \
+				 (uint)(len) <= ACCEL_TCM_SIZE - ((uint)(p) - ACCEL_TCM_BASE))
+
+#define ACCEL_CAPS_LANES	0x3F
+#define ACCEL_CAPS_RPC(caps)	(((caps) >> 8) & 0xF)
+#define ACCEL_CAPS_MUL		(1u << 16)
+#define ACCEL_CAPS_MAC		(1u << 17)
+#define ACCEL_CAPS_DMA		(1u << 18)
+#define ACCEL_CAPS_RING		(1u << 19)
+#define ACCEL_CAPS_HMAC		(1u << 20)
+#define ACCEL_CAPS_SEARCH	(1u << 21)
+
+typedef struct {
+	uchar data[64];
+	uint datalen;
+	uint bitlen[2];
+	uint state[8];
+} SHA256_CTX;
+
+// Chaining state and bit length after a prefix of whole blocks
+typedef struct {
+	uint state[8];
+	uint bitlen[2];
+} SHA256_MIDSTATE;
+
+// HMAC-SHA256 key: midstates after (key ^ ipad) and (key ^ opad)
+typedef struct {
+	SHA256_MIDSTATE inner;
+	SHA256_MIDSTATE outer;
+} SHA256_HMAC_KEY;
+
+// Entries of the midstate cache
+#ifndef SHA256_CACHE_SIZE
+#define SHA256_CACHE_SIZE	8
+#endif
+
+extern uint total_num_of_sha256_ops;
+
+void SHA256Init(SHA256_CTX *ctx);
+void SHA256Transform(SHA256_CTX *ctx, uchar data[]);
+void SHA256Update(SHA256_CTX *ctx, uchar data[], uint len, int ilen);
+void SHA256Final(SHA256_CTX *ctx, uchar hash[]);
+void SHA256Short(const uchar data[], uint len, uchar hash[]);
+void SHA256_batch(const uchar **msgs, const uint *lens, uint n, uchar digests[][32]);
+int SHA256Snapshot(SHA256_CTX *ctx, SHA256_MIDSTATE *mid);
+void SHA256Clone(SHA256_CTX *ctx, const SHA256_MIDSTATE *mid);
+const SHA256_MIDSTATE *SHA256CacheGet(uint key, const uchar prefix[], uint len);
+void SHA256CacheFlush(void);
+void SHA256HmacKey(SHA256_HMAC_KEY *hk, const uchar key[], uint keylen);
+void SHA256HmacInit(SHA256_CTX *ctx, const SHA256_HMAC_KEY *hk);
+void SHA256HmacFinal(SHA256_CTX *ctx, const SHA256_HMAC_KEY *hk, uchar mac[]);
+void SHA256Hmac(const SHA256_HMAC_KEY *hk, const uchar msg[], uint len, uchar mac[]);
+void SHA256Pbkdf2(const uchar pass[], uint passlen, const uchar salt[], uint saltlen,
+		  uint iters, uchar dk[], uint dklen);
+
+#endif
@@ -0,0 +1,262 @@
+#include "sha256_drv.h"
+
+// SHA-256 driver: one firmware image for every platform. SHA256DrvInit reads the accelerator
+// ID register and picks the fastest backend it offers, or SHA256Transform on the core when
+// there is none. Messages are then submitted as jobs and polled or waited for, so the core
+// can queue the next message (or do other work) while the accelerator hashes.
+//
+// Backends:
+//   SHA256_DRV_RING   one lane with DMA into a TCM: each job is a descriptor, the accelerator
+//                     fetches the message from the TCM and writes the digest back by itself.
+//                     Jobs whose message or digest is unaligned or outside the TCM are hashed
+//                     through MSG once the ring has drained
+//   SHA256_DRV_LANES  several lanes: jobs go round robin, one per lane, each message streamed
+//                     into its lane's MSG with queued GOs; the last block of every lane
+//                     compresses while the core fills the next lane
+//   SHA256_DRV_SW     no accelerator: the job is hashed when it is submitted
+
+#define DRV_RING_MASK	(2 * ACCEL_RING_DEPTH - 1)
+
+static int drv_backend = SHA256_DRV_SW;
+static uint drv_lanes;
+static uint drv_next_lane;
+static SHA256_JOB *drv_lane_job[32];
+
+// Ring indices count modulo 2 * ACCEL_RING_DEPTH; the sequence numbers do not wrap
+static uint drv_ring_head;
+static uint drv_ring_tail;
+static uint drv_ring_seq;
+static uint drv_ring_done;
+static SHA256_JOB *drv_ring_job[ACCEL_RING_DEPTH];
+
+// Read a word that may not be mapped: a load access fault while mtvec points at the handler
+// below skips the load, which then reads 0. Where mtvec is hardwired the read is not guarded
+static uint SHA256DrvProbeRead(uint addr)
+{
+	uint val = 0, vec;
+
+	asm volatile (
+		".option push\n"
+		".option norvc\n"
+		"	la	t0, 2f\n"
+		"	csrrw	%1, mtvec, t0\n"
+		"	lw	%0, 0(%2)\n"
+		"	j	3f\n"
+		"	.balign	64\n"
+		"2:	csrr	t0, mepc\n"
+		"	addi	t0, t0, 4\n"
+		"	csrw	mepc, t0\n"
+		"	mret\n"
+		"3:	csrw	mtvec, %1\n"
+		".option pop\n"
+		: "+r" (val), "=&r" (vec)
+		: "r" (addr)
+		: "t0", "memory");
+	return val;
+}
+
+int SHA256DrvInit(void)
+{
+	uint id, caps, k;
+
+	id = SHA256DrvProbeRead(ACCEL_BASE + ACCEL_ID);
+	if ((id >> 16) != ACCEL_ID_MAGIC || ((id >> 8) & 0xFF) != ACCEL_ID_MAJOR) {
+		drv_backend = SHA256_DRV_SW;
+		return drv_backend;
+	}
+
+	caps = ACCEL_REG(ACCEL_CAPS);
+	drv_lanes = caps & ACCEL_CAPS_LANES;
+	if (drv_lanes > 32)
+		drv_lanes = 32;
+	if (drv_lanes > 1 || (caps & (ACCEL_CAPS_DMA | ACCEL_CAPS_RING)) != (ACCEL_CAPS_DMA | ACCEL_CAPS_RING))
+		drv_backend = SHA256_DRV_LANES;
+	else
+		drv_backend = SHA256_DRV_RING;
+
+	ACCEL_REG(ACCEL_MODE) = ACCEL_MODE_SHA256;
+	for (k = 0; k < drv_lanes; ++k)
+		drv_lane_job[k] = 0;
+	drv_next_lane = 0;
+
+	drv_ring_tail = ACCEL_REG(ACCEL_RING_TAIL);
+	while ((drv_ring_head = ACCEL_REG(ACCEL_RING_HEAD)) != drv_ring_tail)
+		;
+	drv_ring_seq = 0;
+	drv_ring_done = 0;
+	return drv_backend;
+}
+
+const char *SHA256DrvName(int backend)
+{
+	switch (backend) {
+	case SHA256_DRV_RING:	return "accelerator ring";
+	case SHA256_DRV_LANES:	return "accelerator lanes";
+	default:		return "software";
+	}
+}
+
+// Stream a whole message into lane k: each GO is queued behind the block before it and
+// the FINAL block may still be compressing on return
+static void SHA256DrvLaneStart(uint k, const uchar *data, uint len)
+{
+	uint off, rem, i, j, w, ctrl, ops;
+
+	for (off = 0; ; off += 64, data += 64) {
+		rem = len - off;
+		while (ACCEL_LANE(k, ACCEL_CTRL) & ACCEL_CTRL_PEND)
+			;
+		// Bytes past the end of the message are not read
+		for (i = 0; i < 64; i += 4) {
+			if (i + 4 <= rem) {
+				w = (data[i] << 24) | (data[i + 1] << 16) | (data[i + 2] << 8) | (data[i + 3]);
+			} else {
+				for (w = 0, j = i; j < i + 4; ++j)
+					w = (w << 8) | (j < rem ? data[j] : 0);
+			}
+			ACCEL_LANE(k, ACCEL_MSG(i / 4)) = w;
+		}
+		ctrl = off ? ACCEL_CTRL_GO : ACCEL_CTRL_INIT | ACCEL_CTRL_GO;
+		if (rem < 64) {
+			ACCEL_LANE(k, ACCEL_DATALEN) = rem;
+			ACCEL_LANE(k, ACCEL_CTRL) = ctrl | ACCEL_CTRL_FINAL;
+		} else {
+			ACCEL_LANE(k, ACCEL_CTRL) = ctrl;
+		}
+		// The length needs a block of its own when it does not fit after the data
+		for (ops = (rem < 56 || rem >= 64) ? 1 : 2; ops > 0; --ops) {
+    //** Do not remove this/modify code **
+	total_num_of_sha256_ops++;
+    //** End of do not remove/modify this code **
+		}
+		if (rem < 64)
+			break;
+	}
+}
+
+// Wait for the job of lane k and copy its hash out of STATE
+static void SHA256DrvLaneCollect(uint k)
+{
+	SHA256_JOB *job = drv_lane_job[k];
+	uint i, h;
+
+	while (!(ACCEL_LANE(k, ACCEL_CTRL) & ACCEL_CTRL_DONE))
+		;
+	for (i = 0; i < 8; ++i) {
+		h = ACCEL_LANE(k, ACCEL_STATE(i));
+		job->digest[4 * i]     = h >> 24;
+		job->digest[4 * i + 1] = h >> 16;
+		job->digest[4 * i + 2] = h >> 8;
+		job->digest[4 * i + 3] = h;
+	}
+	job->done = 1;
+	drv_lane_job[k] = 0;
+}
+
+static void SHA256DrvSoftware(SHA256_JOB *job)
+{
+	SHA256_CTX ctx;
+
+	SHA256Init(&ctx);
+	SHA256Update(&ctx, (uchar *)job->data, job->len, job->len);
+	SHA256Final(&ctx, job->digest);
+}
+
+// Account for the descriptors the accelerator has finished since the last call. CTRL.ERR
+// is kept until it is acknowledged, so a descriptor that failed on the DMA is one of those
+// finished before the ACK; all of them are hashed again on the core
+static void SHA256DrvRingUpdate(void)
+{
+	uint head, n;
+
+	head = ACCEL_REG(ACCEL_RING_HEAD);
+	if (ACCEL_REG(ACCEL_CTRL) & ACCEL_CTRL_ERR) {
+		ACCEL_REG(ACCEL_CTRL) = ACCEL_CTRL_ACK;
+		head = ACCEL_REG(ACCEL_RING_HEAD);
+		for (n = 0; n < ((head - drv_ring_head) & DRV_RING_MASK); ++n)
+			SHA256DrvSoftware(drv_ring_job[(drv_ring_done + n) % ACCEL_RING_DEPTH]);
+	}
+	drv_ring_done += (head - drv_ring_head) & DRV_RING_MASK;
+	drv_ring_head = head;
+}
+
+static void SHA256DrvRingSubmit(SHA256_JOB *job)
+{
+	uint i, ops;
+
+	while (drv_ring_seq - drv_ring_done == ACCEL_RING_DEPTH)
+		SHA256DrvRingUpdate();
+	i = drv_ring_tail % ACCEL_RING_DEPTH;
+	ACCEL_REG(ACCEL_RING_ADDR(i)) = (uint)job->data;
+	ACCEL_REG(ACCEL_RING_LEN(i)) = job->len;
+	ACCEL_REG(ACCEL_RING_DST(i)) = (uint)job->digest;
+	drv_ring_tail = (drv_ring_tail + 1) & DRV_RING_MASK;
+	ACCEL_REG(ACCEL_RING_TAIL) = drv_ring_tail;
+	drv_ring_job[drv_ring_seq % ACCEL_RING_DEPTH] = job;
+	job->slot = drv_ring_seq++;
+	// Whole blocks, the padded last block and the extra length block if needed
+	for (ops = job->len / 64 + ((job->len % 64) < 56 ? 1 : 2); ops > 0; --ops) {
+    //** Do not remove this/modify code **
+	total_num_of_sha256_ops++;
+    //** End of do not remove/modify this code **
+	}
+}
+
+// Start hashing job->data; returns as soon as the accelerator holds the message, or
+// once a free lane or descriptor is available when all are busy
+void SHA256DrvSubmit(SHA256_JOB *job)
+{
+	uint k;
+
+	job->done = 0;
+	switch (drv_backend) {
+	case SHA256_DRV_RING:
+		if (!(((uint)job->data | (uint)job->digest) & 3) &&
+		    ACCEL_IN_TCM(job->data, job->len) && ACCEL_IN_TCM(job->digest, 32)) {
+			SHA256DrvRingSubmit(job);
+			break;
+		}
+		// Otherwise through MSG of lane 0 once the ring is idle
+		while (drv_ring_seq != drv_ring_done)
+			SHA256DrvRingUpdate();
+		job->slot = 0;
+		drv_lane_job[0] = job;
+		SHA256DrvLaneStart(0, job->data, job->len);
+		SHA256DrvLaneCollect(0);
+		break;
+	case SHA256_DRV_LANES:
+		k = drv_next_lane;
+		drv_next_lane = (k + 1 == drv_lanes) ? 0 : k + 1;
+		if (drv_lane_job[k])
+			SHA256DrvLaneCollect(k);
+		job->slot = k;
+		drv_lane_job[k] = job;
+		SHA256DrvLaneStart(k, job->data, job->len);
+		break;
+	default:
+		SHA256DrvSoftware(job);
+		job->done = 1;
+		break;
+	}
+}
+
+// Nonzero once the hash of job is in its digest buffer
+int SHA256DrvPoll(SHA256_JOB *job)
+{
+	if (job->done)
+		return 1;
+	if (drv_backend == SHA256_DRV_RING) {
+		SHA256DrvRingUpdate();
+		job->done = (int)(drv_ring_done - job->slot) > 0;
+	} else if (drv_lane_job[job->slot] == job &&
+		   (ACCEL_LANE(job->slot, ACCEL_CTRL) & ACCEL_CTRL_DONE)) {
+		SHA256DrvLaneCollect(job->slot);
+	}
+	return job->done;
+}
+
+void SHA256DrvWait(SHA256_JOB *job)
+{
+	while (!SHA256DrvPoll(job))
+		;
+}
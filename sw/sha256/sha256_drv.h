@@ -0,0 +1,27 @@
+#ifndef SHA256_DRV_H
+#define SHA256_DRV_H
+
+#include "sha256.h"
+
+// Backends picked by SHA256DrvInit
+#define SHA256_DRV_SW		0	// SHA256Transform on the core
+#define SHA256_DRV_LANES	1	// one message per accelerator lane, blocks written to MSG
+#define SHA256_DRV_RING		2	// descriptor ring, blocks fetched by the accelerator DMA
+
+// A message to hash. The driver fields are set by SHA256DrvSubmit; the job and its
+// buffers must stay in place until SHA256DrvPoll reports it done
+typedef struct {
+	const uchar *data;	// message
+	uint len;		// message length in bytes
+	uchar *digest;		// 32-byte hash
+	uint done;		// driver: hash written to digest
+	uint slot;		// driver: lane or ring sequence number
+} SHA256_JOB;
+
+int SHA256DrvInit(void);
+const char *SHA256DrvName(int backend);
+void SHA256DrvSubmit(SHA256_JOB *job);
+int SHA256DrvPoll(SHA256_JOB *job);
+void SHA256DrvWait(SHA256_JOB *job);
+
+#endif